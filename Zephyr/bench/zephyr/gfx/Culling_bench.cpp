@@ -0,0 +1,119 @@
+/**
+ * @file Culling_bench.cpp
+ *
+ * Measures throughput of the frustum culling loop, compared with a plain
+ * loop over the boxes stored as structures.
+ *
+ * Usage: benchCulling [box count] [iterations]
+ */
+
+#include <zephyr/gfx/Culling.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace zephyr::gfx;
+
+namespace {
+
+/** Perspective projection looking down -z, column-major */
+std::vector<float> perspective(float fov, float aspect, float near, float far) {
+    float f = 1 / std::tan(fov / 2);
+    std::vector<float> m(16, 0.0f);
+    m[0] = f / aspect;
+    m[5] = f;
+    m[10] = (far + near) / (near - far);
+    m[11] = -1;
+    m[14] = 2 * far * near / (near - far);
+    return m;
+}
+
+std::size_t cullNaive(const std::vector<BoundingBox>& boxes,
+        const Frustum& frustum, std::vector<std::uint32_t>& visible) {
+    visible.clear();
+    for (std::size_t i = 0; i < boxes.size(); ++ i) {
+        const BoundingBox& box = boxes[i];
+        bool outside = false;
+        for (const float* p : frustum.planes) {
+            float dist = p[3], radius = 0;
+            for (int j = 0; j < 3; ++ j) {
+                dist += p[j] * box.center(j);
+                radius += std::abs(p[j]) * box.extent(j);
+            }
+            if (dist + radius < 0) {
+                outside = true;
+                break;
+            }
+        }
+        if (!outside) {
+            visible.push_back(i);
+        }
+    }
+    return visible.size();
+}
+
+template <typename Fun>
+double measure(std::size_t iterations, Fun fun) {
+    using namespace std::chrono;
+    auto start = steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++ i) {
+        fun();
+    }
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+void report(const char* name, double seconds, std::size_t tests) {
+    std::cout << name << ": " << seconds * 1e9 / tests << " ns/box, "
+            << tests / seconds / 1e6 << " Mboxes/s" << std::endl;
+}
+
+} /* namespace */
+
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::atol(argv[1]) : 100000;
+    std::size_t iterations = argc > 2 ? std::atol(argv[2]) : 200;
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> position(-100, 100);
+    std::uniform_real_distribution<float> size(0.1f, 2);
+
+    FrustumCuller culler;
+    culler.reserve(count);
+    std::vector<BoundingBox> boxes(count);
+    for (BoundingBox& box : boxes) {
+        for (int j = 0; j < 3; ++ j) {
+            float c = position(generator), e = size(generator);
+            box.min[j] = c - e;
+            box.max[j] = c + e;
+        }
+        culler.add(box);
+    }
+    std::vector<float> proj = perspective(1.05f, 16 / 9.0f, 1, 100);
+    Frustum frustum = Frustum::fromMatrix(proj.data());
+
+    std::size_t tests = count * iterations;
+    std::cout << count << " boxes, " << iterations << " iterations, batches of "
+            << FrustumCuller::batchWidth() << std::endl;
+
+    std::vector<std::uint32_t> visible;
+    std::size_t naiveVisible = 0;
+    double naive = measure(iterations, [&] {
+        naiveVisible = cullNaive(boxes, frustum, visible);
+    });
+    report("naive", naive, tests);
+
+    double soa = measure(iterations, [&] { culler.cull(frustum); });
+    report("soa  ", soa, tests);
+
+    std::cout << "speedup: " << naive / soa << "x, " << culler.stats()
+            << std::endl;
+    if (naiveVisible != culler.stats().visible) {
+        std::cerr << "Mismatch: naive loop found " << naiveVisible
+                << " visible boxes" << std::endl;
+        return 1;
+    }
+}
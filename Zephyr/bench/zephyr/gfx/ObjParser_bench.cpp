@@ -0,0 +1,230 @@
+/**
+ * @file ObjParser_bench.cpp
+ *
+ * Measures OBJ parsing throughput, comparing the stream-based loader that
+ * loadObjData used before (a string stream per line and per face vertex) with
+ * the memory-mapped ObjParser, serial and parallel. Parses a generated grid
+ * mesh with texture coordinates and normals, or the given file (triangles
+ * only, as the old loader ignores the remaining vertices of polygons).
+ *
+ * Usage: benchObjParser [grid size | file.obj] [iterations] [workers]
+ *        [chunk size]
+ */
+
+#include <zephyr/gfx/ObjParser.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <boost/lexical_cast.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace zephyr;
+using namespace zephyr::gfx;
+
+namespace {
+
+/** Loader as it was before ObjParser, without the glm types */
+struct StreamLoader {
+    std::vector<float> positions;
+    std::vector<float> texCoords;
+    std::vector<std::uint32_t> indices;
+    std::vector<std::uint32_t> texIndices;
+
+    struct Vertex {
+        std::uint32_t vi;
+        std::uint32_t ni;
+        std::uint32_t ti;
+    };
+
+    static std::uint32_t maybeRead(std::vector<std::string> words,
+            std::size_t i) {
+        using boost::lexical_cast;
+        if (i < words.size()) {
+            return lexical_cast<std::uint32_t>(words[i]);
+        } else {
+            return 0;
+        }
+    }
+
+    static void readVertex(std::istream& input, Vertex& vertex) {
+        std::vector<std::string> parts;
+        parts.reserve(3);
+
+        std::string word;
+        input >> word;
+        std::istringstream chunk(word);
+
+        while (getline(chunk, word, '/')) {
+            parts.emplace_back(move(word));
+        }
+        vertex.vi = maybeRead(parts, 0);
+        vertex.ti = maybeRead(parts, 1);
+        vertex.ni = maybeRead(parts, 2);
+    }
+
+    void load(const char* path) {
+        std::ifstream input(path);
+        std::string line;
+        while (std::getline(input, line)) {
+            processLine(line);
+        }
+    }
+
+    void processLine(const std::string& line) {
+        std::string type = line.substr(0, 2);
+        if (type == "v ") {
+            std::istringstream s(line.substr(2));
+            float x, y, z;
+            s >> x; s >> y; s >> z;
+            positions.insert(positions.end(), { x, y, z });
+        } else if (type == "f ") {
+            std::istringstream s(line.substr(2));
+            Vertex a, b, c;
+            readVertex(s, a);
+            readVertex(s, b);
+            readVertex(s, c);
+            indices.insert(indices.end(), { a.vi - 1, c.vi - 1, b.vi - 1 });
+            texIndices.insert(texIndices.end(), { a.ti - 1, c.ti - 1, b.ti - 1 });
+        } else if (type == "vt") {
+            std::istringstream s(line.substr(3));
+            float u, v;
+            s >> u >> v;
+            texCoords.insert(texCoords.end(), { u, v });
+        }
+    }
+};
+
+/** Wavy n x n grid, two triangles per cell */
+void writeGrid(const char* path, int n) {
+    std::FILE* file = std::fopen(path, "w");
+    std::fprintf(file, "# %d x %d grid\no grid\n", n, n);
+    for (int i = 0; i < n; ++ i) {
+        for (int j = 0; j < n; ++ j) {
+            float h = 0.25f * ((i * 7 + j * 13) % 17) / 17.0f;
+            std::fprintf(file, "v %.6f %.6f %.6f\n", i * 0.1f, h, j * -0.1f);
+        }
+    }
+    for (int i = 0; i < n; ++ i) {
+        for (int j = 0; j < n; ++ j) {
+            std::fprintf(file, "vt %.6f %.6f\n", i / float(n), j / float(n));
+        }
+    }
+    for (int i = 0; i < n; ++ i) {
+        for (int j = 0; j < n; ++ j) {
+            std::fprintf(file, "vn %.4f %.4f %.4f\n", 0.1f * (i % 3), 0.98f,
+                    0.1f * (j % 3));
+        }
+    }
+    for (int i = 0; i + 1 < n; ++ i) {
+        for (int j = 0; j + 1 < n; ++ j) {
+            int a = i * n + j + 1, b = a + 1, c = a + n, d = c + 1;
+            std::fprintf(file, "f %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                    a, a, a, b, b, b, d, d, d);
+            std::fprintf(file, "f %d/%d/%d %d/%d/%d %d/%d/%d\n",
+                    a, a, a, d, d, d, c, c, c);
+        }
+    }
+    std::fclose(file);
+}
+
+std::size_t fileSize(const char* path) {
+    std::ifstream input(path, std::ios::binary | std::ios::ate);
+    return input.tellg();
+}
+
+template <typename Fun>
+double measure(std::size_t iterations, Fun fun) {
+    using namespace std::chrono;
+    auto start = steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++ i) {
+        fun();
+    }
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+void report(const char* name, double seconds, std::size_t bytes) {
+    std::cout << name << ": " << bytes / seconds / (1 << 20) << " MB/s, "
+            << seconds * 1e3 << " ms" << std::endl;
+}
+
+} /* namespace */
+
+
+int main(int argc, char* argv[]) {
+    std::string path = "/tmp/zephyr_bench_grid.obj";
+    bool generated = true;
+    int n = 300;
+    if (argc > 1) {
+        if (std::string(argv[1]).find(".obj") != std::string::npos) {
+            path = argv[1];
+            generated = false;
+        } else {
+            n = std::atoi(argv[1]);
+        }
+    }
+    std::size_t iterations = argc > 2 ? std::atol(argv[2]) : 3;
+    std::size_t workers = argc > 3 ? std::atol(argv[3])
+            : std::max(1u, std::thread::hardware_concurrency()) - 1;
+    std::size_t chunkSize = argc > 4 ? std::atol(argv[4]) : OBJ_CHUNK_SIZE;
+    if (generated) {
+        writeGrid(path.c_str(), n);
+    }
+    std::size_t bytes = fileSize(path.c_str());
+
+    StreamLoader old;
+    double stream = measure(iterations, [&]() {
+        old = StreamLoader { };
+        old.load(path.c_str());
+    });
+    ObjData obj;
+    double mapped = measure(iterations, [&]() {
+        obj = loadObj(path.c_str());
+    });
+
+    core::WorkerPool pool(workers);
+    core::Jobs jobs(&pool);
+    pool.attach();
+
+    ObjData chunked;
+    double parallel = measure(iterations, [&]() {
+        chunked = loadObj(path.c_str(), jobs, chunkSize);
+    });
+
+    std::cout << path << ": " << bytes / double(1 << 20) << " MB, "
+            << obj.vertexCount() << " vertices, " << obj.triangleCount()
+            << " triangles, " << iterations << " iterations, " << workers
+            << " workers, chunk " << chunkSize << std::endl;
+    report("stream  ", stream, bytes * iterations);
+    report("mapped  ", mapped, bytes * iterations);
+    report("parallel", parallel, bytes * iterations);
+    std::cout << "speedup: mapped " << stream / mapped << "x, parallel "
+            << stream / parallel << "x" << std::endl;
+
+    if (generated) {
+        std::remove(path.c_str());
+    }
+    if (old.positions != obj.positions || old.texCoords != obj.texCoords
+            || old.indices != obj.vertexIndices
+            || (!old.texCoords.empty() && old.texIndices != obj.texIndices)) {
+        std::cerr << "Mismatch: result differs from the stream loader"
+                << std::endl;
+        return 1;
+    }
+    if (chunked.positions != obj.positions
+            || chunked.texCoords != obj.texCoords
+            || chunked.normals != obj.normals
+            || chunked.vertexIndices != obj.vertexIndices
+            || chunked.texIndices != obj.texIndices
+            || chunked.normalIndices != obj.normalIndices) {
+        std::cerr << "Mismatch: parallel result differs from the serial one"
+                << std::endl;
+        return 1;
+    }
+}
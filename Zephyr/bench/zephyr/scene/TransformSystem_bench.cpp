@@ -0,0 +1,166 @@
+/**
+ * @file TransformSystem_bench.cpp
+ *
+ * Measures world transform update of a wide scene graph (a forest of trees
+ * with a few branches each, every node moved each frame), comparing the
+ * recursive update over shared_ptr-linked nodes with the serial and parallel
+ * update of the flat TransformSystem.
+ *
+ * Usage: benchTransforms [node count] [iterations] [workers] [grain]
+ */
+
+#include <zephyr/scene/TransformSystem.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace zephyr;
+using namespace zephyr::scene;
+
+namespace {
+
+const std::size_t BRANCHES = 4;
+
+/** Translation * rotation * scale */
+Mat4 localMatrix(const Vec3& p, const Quat& q, const Vec3& s) {
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+    return Mat4 { {
+        (1 - 2 * (yy + zz)) * s.x, 2 * (xy + wz) * s.x, 2 * (xz - wy) * s.x, 0,
+        2 * (xy - wz) * s.y, (1 - 2 * (xx + zz)) * s.y, 2 * (yz + wx) * s.y, 0,
+        2 * (xz + wy) * s.z, 2 * (yz - wx) * s.z, (1 - 2 * (xx + yy)) * s.z, 0,
+        p.x, p.y, p.z, 1
+    } };
+}
+
+/** Node as it was before the flat layout - recursive update of everything */
+struct RecursiveNode {
+    std::weak_ptr<RecursiveNode> parent;
+    Vec3 position { 0, 0, 0 };
+    Quat orientation { 0, 0, 0, 1 };
+    Vec3 scale { 1, 1, 1 };
+    Mat4 transform;
+    std::unordered_multimap<std::string, std::shared_ptr<RecursiveNode>> children;
+
+    void update() {
+        Mat4 local = localMatrix(position, orientation, scale);
+        if (auto p = parent.lock()) {
+            multiply(p->transform, local, transform);
+        } else {
+            transform = local;
+        }
+        for (auto p : children) {
+            p.second->update();
+        }
+    }
+};
+
+template <typename Fun>
+double measure(std::size_t iterations, Fun fun) {
+    using namespace std::chrono;
+    auto start = steady_clock::now();
+    for (std::size_t i = 0; i < iterations; ++ i) {
+        fun(i);
+    }
+    return duration<double>(steady_clock::now() - start).count();
+}
+
+void report(const char* name, double seconds, std::size_t updates) {
+    std::cout << name << ": " << seconds * 1e9 / updates << " ns/node, "
+            << updates / seconds / 1e6 << " Mnodes/s" << std::endl;
+}
+
+Vec3 offset(std::size_t node, std::size_t frame) {
+    return Vec3 { float(node % 100), float(frame % 7), 0.5f };
+}
+
+} /* namespace */
+
+
+int main(int argc, char* argv[]) {
+    std::size_t count = argc > 1 ? std::atol(argv[1]) : 100000;
+    std::size_t iterations = argc > 2 ? std::atol(argv[2]) : 100;
+    std::size_t workers = argc > 3 ? std::atol(argv[3])
+            : std::max(1u, std::thread::hardware_concurrency()) - 1;
+    std::size_t grain = argc > 4 ? std::atol(argv[4])
+            : TransformSystem::DEFAULT_GRAIN;
+
+    // root, trees and their branches, in the same order in both layouts
+    auto root = std::make_shared<RecursiveNode>();
+    std::vector<std::shared_ptr<RecursiveNode>> nodes;
+    TransformSystem system;
+    std::vector<TransformId> ids;
+    TransformId rootId = system.create();
+
+    std::size_t trees = count / (BRANCHES + 1);
+    for (std::size_t i = 0; i < trees; ++ i) {
+        auto tree = std::make_shared<RecursiveNode>();
+        tree->parent = root;
+        root->children.emplace("", tree);
+        nodes.push_back(tree);
+        TransformId treeId = system.create(rootId);
+        ids.push_back(treeId);
+
+        for (std::size_t j = 0; j < BRANCHES; ++ j) {
+            auto branch = std::make_shared<RecursiveNode>();
+            branch->parent = tree;
+            tree->children.emplace("", branch);
+            nodes.push_back(branch);
+            ids.push_back(system.create(treeId));
+        }
+    }
+    std::size_t updates = nodes.size() * iterations;
+    std::cout << nodes.size() << " nodes, " << iterations << " iterations, "
+            << workers << " workers, grain " << grain << std::endl;
+
+    double recursive = measure(iterations, [&](std::size_t frame) {
+        for (std::size_t i = 0; i < nodes.size(); ++ i) {
+            nodes[i]->position = offset(i, frame);
+        }
+        root->update();
+    });
+    report("recursive", recursive, updates);
+
+    double serial = measure(iterations, [&](std::size_t frame) {
+        for (std::size_t i = 0; i < ids.size(); ++ i) {
+            system.setPosition(ids[i], offset(i, frame));
+        }
+        system.update();
+    });
+    report("flat     ", serial, updates);
+
+    core::WorkerPool pool(workers);
+    core::Jobs jobs(&pool);
+    pool.attach();
+
+    double parallel = measure(iterations, [&](std::size_t frame) {
+        for (std::size_t i = 0; i < ids.size(); ++ i) {
+            system.setPosition(ids[i], offset(i, frame));
+        }
+        system.update(jobs, grain);
+    });
+    report("parallel ", parallel, updates);
+
+    std::cout << "speedup: flat " << recursive / serial << "x, parallel "
+            << recursive / parallel << "x" << std::endl;
+
+    for (std::size_t i = 0; i < nodes.size(); ++ i) {
+        const float* a = nodes[i]->transform.m;
+        const float* b = system.world(ids[i]).m;
+        for (int j = 0; j < 16; ++ j) {
+            if (std::abs(a[j] - b[j]) > 1e-4f) {
+                std::cerr << "Mismatch: node " << i << " differs from the "
+                        << "recursive update" << std::endl;
+                return 1;
+            }
+        }
+    }
+}
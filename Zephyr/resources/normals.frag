@@ -0,0 +1,31 @@
+
+vec3 normToColor(vec3 n) {
+    float xx = (1 + n.x) / 2;
+    float yy = (1 + n.y) / 2;
+    float zz = (1 + n.z) / 2;
+    
+    return vec3(xx, yy, zz);
+}
+
+// Octahedral encoding of unit normals, so that they fit in a two-channel
+// target. Result is in [0, 1]^2.
+vec2 signNotZero(vec2 v) {
+    return vec2(v.x >= 0 ? 1.0 : -1.0, v.y >= 0 ? 1.0 : -1.0);
+}
+
+vec2 encodeNormal(vec3 n) {
+    vec2 p = n.xy / (abs(n.x) + abs(n.y) + abs(n.z));
+    if (n.z < 0) {
+        p = (1 - abs(p.yx)) * signNotZero(p);
+    }
+    return 0.5 * p + 0.5;
+}
+
+vec3 decodeNormal(vec2 e) {
+    vec2 p = 2 * e - 1;
+    vec3 n = vec3(p, 1 - abs(p.x) - abs(p.y));
+    if (n.z < 0) {
+        n.xy = (1 - abs(n.yx)) * signNotZero(n.xy);
+    }
+    return normalize(n);
+}
@@ -0,0 +1,49 @@
+
+in vec2 uv;
+
+out vec3 outputColor;
+
+uniform sampler2D renderedTexture;
+uniform sampler2D normalTexture;
+uniform sampler2D specularTexture;
+uniform sampler2D depthTexture;
+
+vec3 normToColor(vec3 n);
+vec3 decodeNormal(vec2 e);
+
+uniform uvec4 viewport;
+
+uniform int mode;
+
+
+void main() {
+    vec3 color = texture(renderedTexture, uv).rgb;
+    vec3 normal = decodeNormal(texture(normalTexture, uv).xy);
+    vec4 specular = texture(specularTexture, uv);
+    float depth = texture(depthTexture, uv).r;
+
+    if (mode == 0)
+        outputColor = color;
+    else if (mode == 1)
+        outputColor = color;
+    else if (mode == 2)
+        outputColor = normToColor(normal);
+    else if (mode == 3)
+        outputColor = vec3(depth);
+    else if (mode == 4)
+        outputColor = specular.aaa;
+
+    
+    float x = gl_FragCoord.x;
+    float y = gl_FragCoord.y;
+
+    vec2 d = 2.0 * gl_FragCoord.xy - viewport.zw;
+
+    d /= viewport.zw;
+    
+    float r2 = length(d);
+    float a = 1 - pow(r2 / 1.3, 5) / 2;
+    //outputColor = mix(vec3(0, 0, 0), color, a);
+}
+
+
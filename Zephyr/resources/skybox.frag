@@ -0,0 +1,35 @@
+
+in vec3 coords;
+
+out vec4 color;
+
+
+layout (std140) uniform FrameGlobals
+{
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+    vec3 sunDirection;
+    float sunIntensity;
+    vec3 sunColor;
+    float timeOfDay;
+    vec3 ambient;
+    float hdrMax;
+    vec3 lightPos;
+    vec3 lightAt;
+};
+
+uniform samplerCube cubeTex;
+uniform vec3 sunDir;
+
+void main() {
+    vec3 skyColor = 0.3 * vec3(0.6f, 1.0f, 2.0f);
+
+    vec3 sunPos = -sunDirection;
+    vec3 dist = sunPos - normalize(coords);
+    float diff = 1.0f / (0.2f + 15 * length(dist));
+
+    vec3 final = skyColor + diff * sunColor;//texture(cubeTex, coords);
+    color = vec4(final, 1);
+}
+
+
@@ -0,0 +1,24 @@
+
+layout(location = 0) in vec3 position;
+
+layout (std140) uniform FrameGlobals
+{
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+    vec3 sunDirection;
+    float sunIntensity;
+    vec3 sunColor;
+    float timeOfDay;
+    vec3 ambient;
+    float hdrMax;
+    vec3 lightPos;
+    vec3 lightAt;
+};
+
+out vec3 coords;
+
+void main() {
+    vec4 pos = projectionMatrix * viewMatrix * vec4(position, 0);
+    gl_Position = pos.xyww;
+    coords = position;
+}
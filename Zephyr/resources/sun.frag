@@ -0,0 +1,23 @@
+//#version 330
+
+layout (std140) uniform FrameGlobals
+{
+    mat4 viewMatrix;
+    mat4 projectionMatrix;
+    vec3 sunDirection;
+    float sunIntensity;
+    vec3 sunColor;
+    float timeOfDay;
+    vec3 ambient;
+    float hdrMax;
+    vec3 lightPos;
+    vec3 lightAt;
+};
+
+/**
+ * @param n Worldspace suface normal
+ */
+vec3 computeSunlight(vec3 n) {
+    float dirFactor = dot(-n, sunDirection);
+    return sunIntensity * clamp(dirFactor, 0, 1) * sunColor;
+}
@@ -10,6 +10,7 @@
 #include <zephyr/gfx/Renderer.hpp>
 #include <iostream>
 #include <memory>
+#include <thread>
 
 
 #include <zephyr/gfx/HackyRenderer.hpp>
@@ -39,6 +40,8 @@ Root::Root(std::istream& configStream) {
 }
 
 void Root::setup() {
+    configureScheduler();
+
     std::cout << "[Root] Creating dispatch task" << std::endl;
 
     runCoreTasks();
@@ -60,19 +63,38 @@ void Root::initSubsystems() {
     resources_ = util::make_unique<ResourceSystem>(config_);
     window_ = util::make_unique<WindowSystem>(ctx);
     input_ = util::make_unique<InputSystem>(ctx);
-    graphics_ = util::make_unique<GraphicsSystem>(scheduler_, *resources_);
+    graphics_ = util::make_unique<GraphicsSystem>(scheduler_, *resources_,
+            window_->surface(), config_);
+}
+
+void Root::configureScheduler() {
+    if (config_.get<bool>("zephyr.core.scheduler.parallel", false)) {
+        unsigned cores = std::thread::hardware_concurrency();
+        std::size_t workers = config_.get<std::size_t>(
+                "zephyr.core.scheduler.workers", cores > 1 ? cores - 1 : 0);
+
+        std::cout << "[Root] Parallel scheduler, " << workers << " workers"
+                << std::endl;
+        scheduler_.executionMode(Scheduler::ExecutionMode::PARALLEL);
+        scheduler_.workerCount(workers);
+    }
 }
 
 void Root::runCoreTasks() {
-    TaskPtr task = std::make_shared<DispatcherTask>(messageQueue_, dispatcher_);
+    // handlers may touch anything, hence dispatcher stays exclusive
+    TaskPtr task = std::make_shared<DispatcherTask>(messageQueue_, dispatcher_,
+            scheduler_.frameArena());
     scheduler_.startTask(DISPATCHER_NAME, DISPATCHER_PRIORITY, task);
 
     TaskPtr clockTask = std::make_shared<ClockUpdateTask>(clockManager_);
-    scheduler_.startTask(CLOCK_UPDATER_NAME, CLOCK_UPDATER_PRIORITY, clockTask);
+    scheduler_.startTask(CLOCK_UPDATER_NAME, CLOCK_UPDATER_PRIORITY, clockTask,
+            TaskConstraints());
 }
 
 void Root::run() {
     std::cout << "[Root] Running..." << std::endl;
+    // startup registrations are done by now
+    dispatcher_.freeze();
     scheduler_.run();
     std::cout << "[Root] Stopped" << std::endl;
 }
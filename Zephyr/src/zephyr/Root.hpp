@@ -6,6 +6,7 @@
 #define ZEPHYR_ROOT_HPP_
 
 #include <zephyr/core/Scheduler.hpp>
+#include <zephyr/core/Jobs.hpp>
 #include <zephyr/core/Config.hpp>
 #include <zephyr/core/MessageQueue.hpp>
 #include <zephyr/core/DispatcherTask.hpp>
@@ -67,6 +68,14 @@ public:
         return scheduler_;
     }
 
+    /**
+     * Facility for data-parallel work inside tasks. Uses the scheduler's
+     * workers in the parallel mode, and executes everything inline otherwise.
+     */
+    core::Jobs& jobs() {
+        return scheduler_.jobs();
+    }
+
     core::Config& config() {
         return config_;
     }
@@ -129,6 +138,12 @@ private:
      */
     void initSubsystems();
 
+    /**
+     * Sets up the scheduler execution mode according to the configuration
+     * (@c zephyr.core.scheduler section).
+     */
+    void configureScheduler();
+
     /**
      * Creates and runs crucial tasks:
      */
@@ -7,7 +7,8 @@ namespace zephyr {
 namespace core {
 
 void DispatcherTask::update() {
-    std::vector<Message> messages;
+    FrameVector<Message> messages { FrameAllocator<Message> { arena } };
+    messages.reserve(queue.depth());
     queue.drain(back_inserter(messages));
 
     for (const Message& message : messages) {
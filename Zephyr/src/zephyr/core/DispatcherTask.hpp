@@ -8,6 +8,7 @@
 #include <zephyr/core/Task.hpp>
 #include <zephyr/core/MessageQueue.hpp>
 #include <zephyr/core/MessageDispatcher.hpp>
+#include <zephyr/core/FrameArena.hpp>
 
 
 namespace zephyr {
@@ -21,10 +22,12 @@ public:
 
     /**
      * Creates @ref DispatcherTask taking messages from the specified queue,
-     * and delivering it with the specified dispatcher.
+     * and delivering it with the specified dispatcher. Drained messages are
+     * stored in memory taken from the frame arena.
      */
-    DispatcherTask(MessageQueue& queue, MessageDispatcher& dispatcher)
-    : queue(queue), dispatcher(dispatcher)
+    DispatcherTask(MessageQueue& queue, MessageDispatcher& dispatcher,
+            FrameArena& arena)
+    : queue(queue), dispatcher(dispatcher), arena(arena)
     { }
 
     /**
@@ -39,6 +42,9 @@ private:
     /** Message dispatcher used to deliver messages */
     MessageDispatcher& dispatcher;
 
+    /** Source of the memory for the messages of the current frame */
+    FrameArena& arena;
+
 };
 
 } /* namespace core */
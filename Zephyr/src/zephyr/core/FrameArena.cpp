@@ -0,0 +1,112 @@
+/**
+ * @file FrameArena.cpp
+ */
+
+#include <zephyr/core/FrameArena.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+
+namespace zephyr {
+namespace core {
+
+constexpr std::size_t FrameArena::DEFAULT_CAPACITY;
+constexpr std::size_t FrameArena::MAX_ALIGN;
+
+namespace {
+
+std::uintptr_t alignUp(std::uintptr_t address, std::size_t align) {
+    return (address + align - 1) & ~(std::uintptr_t(align) - 1);
+}
+
+double kilobytes(std::size_t bytes) {
+    return bytes / 1024.0;
+}
+
+} /* namespace */
+
+
+std::ostream& operator << (std::ostream& os, const FrameArenaStats& stats) {
+    std::ios::fmtflags flags = os.flags();
+    std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(1)
+       << kilobytes(stats.lastFrame) << " KB, high-water "
+       << kilobytes(stats.highWater) << " KB of "
+       << kilobytes(stats.capacity) << " KB, "
+       << stats.overflows << " overflows";
+    os.flags(flags);
+    os.precision(precision);
+    return os;
+}
+
+
+FrameArena::FrameArena(std::size_t capacity) {
+    for (Buffer& buffer : buffers_) {
+        buffer.memory.reset(new char[capacity]);
+        buffer.capacity = capacity;
+    }
+    stats_.capacity = capacity;
+}
+
+void* FrameArena::allocate(std::size_t size, std::size_t align) {
+    Buffer& buffer = buffers_[current_];
+    std::uintptr_t base = reinterpret_cast<std::uintptr_t>(buffer.memory.get());
+
+    std::size_t offset = buffer.offset.load(std::memory_order_relaxed);
+    std::size_t begin, end;
+    do {
+        begin = alignUp(base + offset, align) - base;
+        end = begin + size;
+        if (end > buffer.capacity) {
+            return allocateOverflow(buffer, size, align);
+        }
+    } while (!buffer.offset.compare_exchange_weak(offset, end,
+            std::memory_order_relaxed));
+
+    return buffer.memory.get() + begin;
+}
+
+void* FrameArena::allocateOverflow(Buffer& buffer, std::size_t size,
+        std::size_t align) {
+    std::lock_guard<std::mutex> lock { overflowMutex_ };
+    buffer.overflow.emplace_back(new char[size + align]);
+    buffer.overflowBytes += size;
+
+    std::uintptr_t address =
+            reinterpret_cast<std::uintptr_t>(buffer.overflow.back().get());
+    return reinterpret_cast<void*>(alignUp(address, align));
+}
+
+std::size_t FrameArena::used() const {
+    const Buffer& buffer = buffers_[current_];
+    return buffer.offset.load(std::memory_order_relaxed) + buffer.overflowBytes;
+}
+
+void FrameArena::endFrame() {
+    Buffer& finished = buffers_[current_];
+    stats_.lastFrame = used();
+    stats_.highWater = std::max(stats_.highWater, stats_.lastFrame);
+    if (finished.overflowBytes > 0) {
+        ++ stats_.overflows;
+    }
+    current_ = 1 - current_;
+    reset(buffers_[current_]);
+}
+
+void FrameArena::reset(Buffer& buffer) {
+    // data allocated two frames ago is not used anymore
+    buffer.overflow.clear();
+    buffer.overflowBytes = 0;
+    buffer.offset.store(0, std::memory_order_relaxed);
+
+    if (stats_.highWater > buffer.capacity) {
+        // some slack for the alignment padding
+        std::size_t capacity = stats_.highWater + stats_.highWater / 8;
+        buffer.memory.reset(new char[capacity]);
+        buffer.capacity = capacity;
+        stats_.capacity = std::max(stats_.capacity, capacity);
+    }
+}
+
+} /* namespace core */
+} /* namespace zephyr */
@@ -0,0 +1,183 @@
+/**
+ * @file FrameArena.hpp
+ */
+
+#ifndef ZEPHYR_CORE_FRAMEARENA_HPP_
+#define ZEPHYR_CORE_FRAMEARENA_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace zephyr {
+namespace core {
+
+/**
+ * Memory usage of the @ref FrameArena.
+ */
+struct FrameArenaStats {
+    /** Bytes allocated during the last finished frame */
+    std::size_t lastFrame = 0;
+
+    /** Largest number of bytes allocated during a single frame */
+    std::size_t highWater = 0;
+
+    /** Number of frames that did not fit in the buffer */
+    std::size_t overflows = 0;
+
+    /** Size of each of the buffers */
+    std::size_t capacity = 0;
+};
+
+std::ostream& operator << (std::ostream& os, const FrameArenaStats& stats);
+
+
+/**
+ * Bump allocator for data that lives no longer than a frame. Allocation only
+ * moves an offset in the buffer of the current frame (lock-free, safe to use
+ * from several threads), and nothing is freed individually - the whole buffer
+ * is reset at once.
+ *
+ * There are two buffers, used in alternate frames, so the data allocated in
+ * one frame stays valid during the next one as well (e.g. when it is consumed
+ * by the renderer a frame later).
+ *
+ * When the buffer is exhausted, memory is taken from the heap, and the buffer
+ * is enlarged to the high-water mark the next time it is reset. After a few
+ * frames the arena does not allocate at all.
+ */
+class FrameArena {
+public:
+
+    static constexpr std::size_t DEFAULT_CAPACITY = 1 << 20;
+
+    /** Alignment of the memory returned by default */
+    static constexpr std::size_t MAX_ALIGN = 16;
+
+    /**
+     * @param capacity Initial size of each of the buffers
+     */
+    explicit FrameArena(std::size_t capacity = DEFAULT_CAPACITY);
+
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator = (const FrameArena&) = delete;
+
+    /**
+     * Allocates memory valid until the end of the next frame.
+     *
+     * @param size Number of bytes
+     * @param align Alignment, power of 2
+     */
+    void* allocate(std::size_t size, std::size_t align = MAX_ALIGN);
+
+    /**
+     * Finishes the frame - switches to the other buffer, and releases
+     * everything allocated from it two frames ago. Shall not be called
+     * concurrently with @ref allocate().
+     */
+    void endFrame();
+
+    /** Number of bytes allocated in the current frame so far */
+    std::size_t used() const;
+
+    const FrameArenaStats& stats() const {
+        return stats_;
+    }
+
+private:
+    struct Buffer {
+        std::unique_ptr<char[]> memory;
+        std::size_t capacity = 0;
+        std::atomic<std::size_t> offset { 0 };
+
+        /** Blocks allocated after the buffer was exhausted */
+        std::vector<std::unique_ptr<char[]>> overflow;
+        std::size_t overflowBytes = 0;
+    };
+
+    void* allocateOverflow(Buffer& buffer, std::size_t size, std::size_t align);
+
+    void reset(Buffer& buffer);
+
+    Buffer buffers_[2];
+    std::size_t current_ = 0;
+
+    std::mutex overflowMutex_;
+
+    FrameArenaStats stats_;
+};
+
+
+/**
+ * STL allocator taking memory from the @ref FrameArena. Deallocation does
+ * nothing, containers using it shall not outlive the next frame. Allocators
+ * are equal if they use the same arena.
+ *
+ * Example:
+ * @code
+ * FrameVector<Message> messages { FrameAllocator<Message> { arena } };
+ * @endcode
+ */
+template <typename T>
+class FrameAllocator {
+public:
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <typename U>
+    struct rebind {
+        typedef FrameAllocator<U> other;
+    };
+
+    explicit FrameAllocator(FrameArena& arena) noexcept
+    : arena_ { &arena }
+    { }
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other) noexcept
+    : arena_ { other.arena() }
+    { }
+
+    T* allocate(std::size_t n) {
+        return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T*, std::size_t) noexcept {
+        // released with the whole frame
+    }
+
+    FrameArena* arena() const {
+        return arena_;
+    }
+
+private:
+    FrameArena* arena_;
+};
+
+template <typename T, typename U>
+bool operator == (const FrameAllocator<T>& a, const FrameAllocator<U>& b) {
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator != (const FrameAllocator<T>& a, const FrameAllocator<U>& b) {
+    return a.arena() != b.arena();
+}
+
+/** Vector allocated from the @ref FrameArena */
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} /* namespace core */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_CORE_FRAMEARENA_HPP_ */
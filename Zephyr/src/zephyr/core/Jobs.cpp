@@ -0,0 +1,102 @@
+/**
+ * @file Jobs.cpp
+ */
+
+#include <zephyr/core/Jobs.hpp>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+
+namespace zephyr {
+namespace core {
+
+namespace {
+
+/** Number of occupied slots skipped before giving up on allocation */
+const std::size_t MAX_PROBES = 8;
+
+} /* namespace */
+
+
+void Jobs::wait(JobCounter& counter) {
+    if (pool_ && pool_->isPoolThread()) {
+        pool_->helpUntil([&counter] { return counter.done(); });
+    } else {
+        while (!counter.done()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+auto Jobs::allocate() -> StoredJob* {
+    // Each thread allocates from its own ring only, slots are released by
+    // whichever thread executes the job
+    struct Ring {
+        std::unique_ptr<char[]> memory;
+        StoredJob* slots;
+        std::size_t next;
+
+        Ring()
+        : memory { new char[RING_SIZE * sizeof(StoredJob) + alignof(StoredJob)] }
+        , next { 0 }
+        {
+            std::uintptr_t address =
+                    reinterpret_cast<std::uintptr_t>(memory.get());
+            std::uintptr_t align = alignof(StoredJob);
+            address = (address + align - 1) & ~(align - 1);
+            slots = reinterpret_cast<StoredJob*>(address);
+            for (std::size_t i = 0; i < RING_SIZE; ++ i) {
+                new (&slots[i]) StoredJob();
+            }
+        }
+    };
+    static thread_local Ring ring;
+
+    for (std::size_t i = 0; i < MAX_PROBES; ++ i) {
+        StoredJob& slot = ring.slots[ring.next];
+        ring.next = (ring.next + 1) % RING_SIZE;
+        if (!slot.busy.load(std::memory_order_acquire)) {
+            slot.busy.store(true, std::memory_order_relaxed);
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+void Jobs::finish(JobCounter& counter) {
+    int prev = counter.count_.fetch_sub(1, std::memory_order_acq_rel);
+    // Counter cannot be done while the flag is set, hence it is still alive
+    if (prev == JobCounter::CONTINUATION + 1) {
+        Job* job = counter.continuation_.exchange(nullptr,
+                std::memory_order_acq_rel);
+        pool_->submit(job);
+    }
+}
+
+void Jobs::execute(Job& job) {
+    StoredJob& slot = *static_cast<StoredJob*>(job.data);
+    Jobs& jobs = *slot.owner;
+    JobCounter& counter = *slot.counter;
+    JobCounter* predecessor = slot.predecessor;
+
+    try {
+        slot.invoke(&slot.closure);
+    } catch (const std::exception& e) {
+        std::cerr << "[Jobs] Exception: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "[Jobs] Unknown exception!" << std::endl;
+    }
+    slot.destroy(&slot.closure);
+    slot.busy.store(false, std::memory_order_release);
+
+    if (predecessor) {
+        predecessor->count_.fetch_sub(JobCounter::CONTINUATION,
+                std::memory_order_acq_rel);
+    }
+    jobs.finish(counter);
+}
+
+} /* namespace core */
+} /* namespace zephyr */
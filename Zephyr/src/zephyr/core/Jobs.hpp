@@ -0,0 +1,308 @@
+/**
+ * @file Jobs.hpp
+ */
+
+#ifndef ZEPHYR_CORE_JOBS_HPP_
+#define ZEPHYR_CORE_JOBS_HPP_
+
+#include <zephyr/core/WorkerPool.hpp>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+
+namespace zephyr {
+namespace core {
+
+/**
+ * Fork/join counter. Each job started with the counter increments it, and
+ * decrements it once it is done. Waiting for the counter means waiting for
+ * all these jobs to complete.
+ *
+ * Counter may have a continuation, i.e. a job started as soon as the counter
+ * drops to zero (see @ref Jobs::then()).
+ */
+class JobCounter {
+public:
+    JobCounter()
+    : count_ { 0 }
+    , continuation_ { nullptr }
+    { }
+
+    JobCounter(const JobCounter&) = delete;
+    JobCounter& operator = (const JobCounter&) = delete;
+
+    /**
+     * @return @c true if all the jobs started with this counter have finished
+     */
+    bool done() const {
+        return count_.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    friend class Jobs;
+
+    /** Added to the count while the continuation is pending */
+    static constexpr int CONTINUATION = 1 << 30;
+
+    /** Number of unfinished jobs, plus the continuation flag */
+    std::atomic<int> count_;
+
+    /** Job to start when the count drops to zero */
+    std::atomic<Job*> continuation_;
+};
+
+
+/**
+ * Facility for data-parallel work executed by the scheduler's @ref WorkerPool.
+ * Tasks may use it inside @c update() to fan the work out to other threads and
+ * wait for it, without creating threads themselves.
+ *
+ * Jobs are stored in fixed per-thread rings of slots, large enough to hold
+ * small closures in place - starting a job never allocates memory. Callables
+ * must fit in @ref CLOSURE_SIZE bytes, which is checked at compile time; if
+ * more state is needed, capture a pointer to it.
+ *
+ * If there is no pool, or the caller is not one of its threads, everything is
+ * executed inline in the calling thread.
+ *
+ * Example:
+ * @code
+ * jobs.parallel_for(0, vertices.size(), 256, [&](std::size_t i) {
+ *     normals[i] = glm::normalize(normals[i]);
+ * });
+ * @endcode
+ */
+class Jobs {
+public:
+
+    /** Maximal size of the callable stored in a job */
+    static constexpr std::size_t CLOSURE_SIZE = 48;
+
+    /** Number of job slots in each thread's ring */
+    static constexpr std::size_t RING_SIZE = 1024;
+
+    /**
+     * Creates job facility using specified pool.
+     *
+     * @param pool Worker pool, may be @c nullptr
+     */
+    explicit Jobs(WorkerPool* pool)
+    : pool_ { pool }
+    { }
+
+    /**
+     * Starts asynchronous execution of @c fun, associated with the counter.
+     *
+     * @param counter Counter incremented until the job completes
+     * @param fun Callable to execute
+     */
+    template <typename Fun>
+    void run(JobCounter& counter, Fun fun);
+
+    /**
+     * Schedules @c fun to execute once all the jobs associated with @c after
+     * have completed. Shall be called after these jobs have been started, at
+     * most once per each batch.
+     *
+     * @param after Counter to wait for
+     * @param counter Counter incremented until the continuation completes
+     * @param fun Callable to execute
+     */
+    template <typename Fun>
+    void then(JobCounter& after, JobCounter& counter, Fun fun);
+
+    /**
+     * Blocks until all the jobs associated with the counter complete. Waiting
+     * thread executes pending jobs in the meantime.
+     */
+    void wait(JobCounter& counter);
+
+    /**
+     * Invokes @c fun(i) for each @c i in range <tt>[begin, end)</tt>. Range is
+     * recursively split in halves and distributed over the pool, until pieces
+     * are no larger than @c grain. Returns when all the calls have completed.
+     *
+     * @param begin First index of the range
+     * @param end Index one past the last one of the range
+     * @param grain Size of the range below which it is not split any further
+     * @param fun Callable accepting the index
+     */
+    template <typename Fun>
+    void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+            Fun fun);
+
+    /**
+     * @return @c true if jobs started from the calling thread are actually
+     *         executed in parallel
+     */
+    bool parallel() const {
+        return pool_ && pool_->isPoolThread() && pool_->size() > 1;
+    }
+
+private:
+    /** Job together with the storage for its closure */
+    struct alignas(64) StoredJob {
+        Job job;
+
+        /** Job facility that started the job */
+        Jobs* owner;
+
+        /** Counter to decrement on completion */
+        JobCounter* counter;
+
+        /** Counter the job is a continuation of, or @c nullptr */
+        JobCounter* predecessor;
+
+        /** Executes the stored closure */
+        void (*invoke)(void* closure);
+
+        /** Destroys the stored closure */
+        void (*destroy)(void* closure);
+
+        /** Flag indicating the slot is occupied */
+        std::atomic<bool> busy;
+
+        typename std::aligned_storage<CLOSURE_SIZE>::type closure;
+    };
+
+    /** Splitting job of @ref parallel_for() */
+    template <typename Fun>
+    struct RangeJob {
+        Jobs* jobs;
+        JobCounter* counter;
+        const Fun* fun;
+        std::size_t begin;
+        std::size_t end;
+        std::size_t grain;
+
+        void operator ()() const {
+            std::size_t from = begin, to = end;
+            while (to - from > grain) {
+                std::size_t mid = from + (to - from) / 2;
+                jobs->run(*counter, RangeJob { jobs, counter, fun, mid, to,
+                    grain });
+                to = mid;
+            }
+            for (std::size_t i = from; i < to; ++ i) {
+                (*fun)(i);
+            }
+        }
+    };
+
+    template <typename Fun>
+    static void invoke(void* closure) {
+        (*static_cast<Fun*>(closure))();
+    }
+
+    template <typename Fun>
+    static void destroy(void* closure) {
+        static_cast<Fun*>(closure)->~Fun();
+    }
+
+    template <typename Fun>
+    static void checkClosure() {
+        static_assert(sizeof(Fun) <= CLOSURE_SIZE,
+                "Closure too large to be stored in the job");
+        static_assert(alignof(Fun) <= alignof(decltype(StoredJob::closure)),
+                "Closure alignment not supported");
+    }
+
+    /**
+     * Takes a free slot from the calling thread's ring.
+     *
+     * @return Free slot, or @c nullptr if all the slots are occupied
+     */
+    StoredJob* allocate();
+
+    /** Fills in the slot with the closure */
+    template <typename Fun>
+    void store(StoredJob* slot, JobCounter& counter, Fun&& fun);
+
+    /** Decrements the counter, starts the continuation if it drops to zero */
+    void finish(JobCounter& counter);
+
+    /** Job function of the stored jobs */
+    static void execute(Job& job);
+
+    WorkerPool* pool_;
+};
+
+
+template <typename Fun>
+void Jobs::run(JobCounter& counter, Fun fun) {
+    checkClosure<Fun>();
+
+    StoredJob* slot = parallel() ? allocate() : nullptr;
+    if (!slot) {
+        // nowhere to put it, execute right away
+        fun();
+        return;
+    }
+    store(slot, counter, std::move(fun));
+    counter.count_.fetch_add(1, std::memory_order_relaxed);
+    pool_->submit(&slot->job);
+}
+
+template <typename Fun>
+void Jobs::then(JobCounter& after, JobCounter& counter, Fun fun) {
+    checkClosure<Fun>();
+
+    StoredJob* slot = parallel() ? allocate() : nullptr;
+    if (!slot) {
+        wait(after);
+        fun();
+        return;
+    }
+    store(slot, counter, std::move(fun));
+    slot->predecessor = &after;
+    counter.count_.fetch_add(1, std::memory_order_relaxed);
+
+    // Flag is set together with an extra reference, dropped right away - the
+    // one who brings the count down to the bare flag starts the continuation.
+    // The flag itself keeps the counter from being done until it completes.
+    after.continuation_.store(&slot->job, std::memory_order_release);
+    after.count_.fetch_add(JobCounter::CONTINUATION + 1,
+            std::memory_order_acq_rel);
+    finish(after);
+}
+
+template <typename Fun>
+void Jobs::store(StoredJob* slot, JobCounter& counter, Fun&& fun) {
+    typedef typename std::decay<Fun>::type Closure;
+    new (&slot->closure) Closure(std::forward<Fun>(fun));
+    slot->job.function = &Jobs::execute;
+    slot->job.data = slot;
+    slot->owner = this;
+    slot->counter = &counter;
+    slot->predecessor = nullptr;
+    slot->invoke = &Jobs::invoke<Closure>;
+    slot->destroy = &Jobs::destroy<Closure>;
+}
+
+template <typename Fun>
+void Jobs::parallel_for(std::size_t begin, std::size_t end,
+        std::size_t grain, Fun fun) {
+    if (begin >= end) {
+        return;
+    }
+    if (!parallel()) {
+        for (std::size_t i = begin; i < end; ++ i) {
+            fun(i);
+        }
+        return;
+    }
+    if (grain == 0) {
+        grain = 1;
+    }
+    JobCounter counter;
+    RangeJob<Fun> { this, &counter, &fun, begin, end, grain }();
+    wait(counter);
+}
+
+} /* namespace core */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_CORE_JOBS_HPP_ */
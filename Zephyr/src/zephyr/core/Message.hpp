@@ -6,7 +6,7 @@
 #define ZEPHYR_CORE_MESSAGE_HPP_
 
 #include <zephyr/util/format.hpp>
-#include <zephyr/util/Any.hpp>
+#include <zephyr/util/Payload.hpp>
 #include <iostream>
 
 namespace zephyr {
@@ -16,12 +16,13 @@ namespace core {
 typedef std::uint32_t address;
 
 /**
- * Generic message structure. Uses boost::any to store arbitrary content.
+ * Generic message structure. Content is stored in @ref util::Payload, which
+ * keeps small, trivially copyable values inline.
  */
 struct Message {
     address target;
     std::uint32_t type;
-    util::Any data;
+    util::Payload data;
 };
 
 inline std::ostream& operator << (std::ostream& os, const Message& message) {
@@ -6,22 +6,156 @@
  */
 
 #include <zephyr/core/MessageDispatcher.hpp>
+#include <algorithm>
 
 namespace zephyr {
 namespace core {
 
-void MessageDispatcher::registerHandler(std::uint32_t receiver,
+namespace {
+
+/** Tracks the nesting level of dispatch, exception-safe */
+struct DepthGuard {
+    int& depth;
+
+    explicit DepthGuard(int& depth)
+    : depth(depth)
+    {
+        ++ depth;
+    }
+
+    ~DepthGuard() {
+        -- depth;
+    }
+};
+
+/** Spreads the bits of receiver id, in case it is not a hash */
+std::uint32_t mix(std::uint32_t x) {
+    x ^= x >> 16;
+    x *= 0x7feb352d;
+    x ^= x >> 15;
+    return x;
+}
+
+} /* namespace */
+
+
+MessageDispatcher::MessageDispatcher()
+: nextId_ { INVALID_HANDLER + 1 }
+, dirty_ { false }
+, depth_ { 0 }
+{ }
+
+HandlerId MessageDispatcher::registerHandler(std::uint32_t receiver,
         Handler handler) {
-    handlers_.emplace(receiver, handler);
+    HandlerId id = nextId_ ++;
+    pending_.push_back({ receiver, id, true, std::move(handler) });
+    dirty_ = true;
+    return id;
+}
+
+bool MessageDispatcher::removeHandler(HandlerId id) {
+    auto matches = [id](const Entry& entry) {
+        return entry.id == id && entry.active;
+    };
+    auto i = std::find_if(begin(pending_), end(pending_), matches);
+    if (i != end(pending_)) {
+        pending_.erase(i);
+        return true;
+    }
+    // entries may be in use by dispatch, so only deactivate them for now
+    auto j = std::find_if(begin(entries_), end(entries_), matches);
+    if (j != end(entries_)) {
+        j->active = false;
+        dirty_ = true;
+        return true;
+    }
+    return false;
+}
+
+void MessageDispatcher::freeze() {
+    if (dirty_ && depth_ == 0) {
+        rebuild();
+    }
 }
 
 void MessageDispatcher::dispatch(const Message& message) {
-    typedef std::pair<std::uint32_t, Handler> pair;
+    freeze();
+    if (const Span* span = find(message.target)) {
+        DepthGuard guard(depth_);
+        // handlers may register new ones, which never touches entries_
+        for (std::uint32_t i = span->begin; i < span->end; ++ i) {
+            const Entry& entry = entries_[i];
+            if (entry.active) {
+                entry.handler(message);
+            }
+        }
+    }
+}
+
+auto MessageDispatcher::find(std::uint32_t receiver) const -> const Span* {
+    if (table_.empty()) {
+        return nullptr;
+    }
+    std::size_t mask = table_.size() - 1;
+    std::size_t index = mix(receiver) & mask;
+    while (true) {
+        const Span& span = table_[index];
+        if (span.begin == span.end) {
+            return nullptr;
+        } else if (span.receiver == receiver) {
+            return &span;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+void MessageDispatcher::rebuild() {
+    entries_.erase(std::remove_if(begin(entries_), end(entries_),
+            [](const Entry& entry) { return !entry.active; }), end(entries_));
+
+    for (Entry& entry : pending_) {
+        entries_.push_back(std::move(entry));
+    }
+    pending_.clear();
 
-    auto range = handlers_.equal_range(message.target);
-    std::for_each(range.first, range.second, [&message](pair p) {
-        p.second(message);
+    // stable sort keeps the registration order within each receiver
+    std::stable_sort(begin(entries_), end(entries_),
+            [](const Entry& a, const Entry& b) {
+        return a.receiver < b.receiver;
     });
+
+    std::size_t receivers = 0;
+    for (std::size_t i = 0; i < entries_.size(); ++ i) {
+        if (i == 0 || entries_[i].receiver != entries_[i - 1].receiver) {
+            ++ receivers;
+        }
+    }
+    // load factor at most 1/2, so that probing sequences stay short
+    std::size_t size = 1;
+    while (size < 2 * receivers) {
+        size <<= 1;
+    }
+    table_.assign(receivers > 0 ? size : 0, Span { 0, 0, 0 });
+
+    std::size_t mask = table_.size() - 1;
+    std::size_t first = 0;
+    for (std::size_t i = 1; i <= entries_.size(); ++ i) {
+        if (i == entries_.size()
+                || entries_[i].receiver != entries_[first].receiver) {
+            std::uint32_t receiver = entries_[first].receiver;
+            std::size_t index = mix(receiver) & mask;
+            while (table_[index].begin != table_[index].end) {
+                index = (index + 1) & mask;
+            }
+            table_[index] = Span {
+                receiver,
+                static_cast<std::uint32_t>(first),
+                static_cast<std::uint32_t>(i)
+            };
+            first = i;
+        }
+    }
+    dirty_ = false;
 }
 
 } /* namespace core */
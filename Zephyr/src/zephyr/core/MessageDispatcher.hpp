@@ -6,9 +6,9 @@
 #define ZEPHYR_CORE_MESSAGEDISPATCHER_H_
 
 #include <zephyr/core/Message.hpp>
-#include <unordered_map>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace zephyr {
 namespace core {
@@ -16,20 +16,60 @@ namespace core {
 /** Type of the callbacks invoked during dispatching */
 typedef std::function<void (const Message&)> Handler;
 
+/** Identifier of the registered handler, used to remove it */
+typedef std::uint32_t HandlerId;
+
+/** Value never returned as a valid @ref HandlerId */
+constexpr HandlerId INVALID_HANDLER = 0;
+
 
 /**
  * Synchronous message dispatcher. Receivers can register callback.
+ *
+ * Handlers are kept in a single array, grouped by receiver, with a small
+ * open-addressing table mapping receiver id to its range of handlers. Changes
+ * of the registered handlers are collected and compiled into this form by
+ * @ref freeze(), or lazily before the next dispatch. Once frozen, delivering
+ * a message is a table lookup and a loop over contiguous handlers.
+ *
+ * Handlers may be added and removed while dispatching. Removed handler is not
+ * invoked anymore, added one is only visible in subsequent dispatches.
  */
 class MessageDispatcher {
 public:
 
+    MessageDispatcher();
+
     /**
      * Adds new handler callback for the specified receiver.
      *
      * @param receiver Id of the receiver category
      * @param handler Callback used to deliver the message
+     * @return Id of the handler, needed to remove it
+     */
+    HandlerId registerHandler(std::uint32_t receiver, Handler handler);
+
+    /**
+     * Removes the handler registered previously.
+     *
+     * @param id Id returned by @ref registerHandler()
+     * @return @c true if the handler was removed, @c false if there was no
+     *         such handler
+     */
+    bool removeHandler(HandlerId id);
+
+    /**
+     * Compiles the registered handlers into the dispatch tables. Meant to be
+     * called once the startup registrations are done.
+     */
+    void freeze();
+
+    /**
+     * @return @c true if there are no changes waiting to be compiled
      */
-    void registerHandler(std::uint32_t receiver, Handler handler);
+    bool frozen() const {
+        return !dirty_;
+    }
 
     /**
      * Dispatches synchronously the specified message.
@@ -39,18 +79,54 @@ public:
     virtual ~MessageDispatcher() = default;
 
 private:
-    /** Mapping (id -> handlers) */
-    std::unordered_multimap<std::uint32_t, Handler> handlers_;
+    /** Registered handler */
+    struct Entry {
+        std::uint32_t receiver;
+        HandlerId id;
+        bool active;
+        Handler handler;
+    };
+
+    /** Range of handlers of single receiver, in the lookup table */
+    struct Span {
+        std::uint32_t receiver;
+        std::uint32_t begin;
+        std::uint32_t end;
+    };
+
+    /** Finds the range of handlers for the receiver */
+    const Span* find(std::uint32_t receiver) const;
+
+    /** Rebuilds the handler array and the lookup table */
+    void rebuild();
+
+    /** Handlers grouped by receiver, in registration order */
+    std::vector<Entry> entries_;
 
+    /** Handlers registered since the last rebuild */
+    std::vector<Entry> pending_;
+
+    /** Open-addressing table of receiver spans, power of two in size */
+    std::vector<Span> table_;
+
+    /** Id of the next registered handler */
+    HandlerId nextId_;
+
+    /** Flag indicating the tables need to be rebuilt */
+    bool dirty_;
+
+    /** Nesting level of the dispatch calls in progress */
+    int depth_;
 };
 
 template <typename Class>
-void registerHandler(MessageDispatcher& dispatcher, std::uint32_t receiver,
-        Class* object, void (Class::*handler)(const Message&)) {
-    using std::placeholders::_1;
-
-    auto callback = std::bind(handler, object, _1);
-    dispatcher.registerHandler(receiver, callback);
+HandlerId registerHandler(MessageDispatcher& dispatcher,
+        std::uint32_t receiver, Class* object,
+        void (Class::*handler)(const Message&)) {
+    return dispatcher.registerHandler(receiver,
+            [object, handler](const Message& message) {
+        (object->*handler)(message);
+    });
 }
 
 } /* namespace core */
@@ -1,32 +1,228 @@
 #include <zephyr/core/MessageQueue.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
 
 namespace zephyr {
 namespace core {
 
+namespace {
+
+/** Bit of the segment tail marking it closed for the producers */
+const std::size_t CLOSED = std::size_t(1) << (sizeof(std::size_t) * 8 - 1);
+
+std::size_t roundUpToPowerOfTwo(std::size_t n) {
+    std::size_t power = 1;
+    while (power < n) {
+        power <<= 1;
+    }
+    return power;
+}
+
+} /* namespace */
+
+
+/**
+ * Bounded multi-producer ring (after D. Vyukov). Each cell carries a sequence
+ * number telling whether it is ready to be written or read in the current
+ * round, so producers only contend on the tail index.
+ */
+struct MessageQueue::Segment {
+
+    struct alignas(64) Cell {
+        std::atomic<std::size_t> sequence;
+        Message message;
+    };
+
+    explicit Segment(std::size_t capacity)
+    : mask { capacity - 1 }
+    , cells { util::make_aligned_array<Cell>(capacity) }
+    , tail { 0 }
+    , head { 0 }
+    , next { nullptr }
+    {
+        for (std::size_t i = 0; i < capacity; ++ i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    std::size_t capacity() const {
+        return mask + 1;
+    }
+
+    std::size_t size() const {
+        std::size_t t = tail.load(std::memory_order_acquire) & ~CLOSED;
+        std::size_t h = head.load(std::memory_order_acquire);
+        return t > h ? t - h : 0;
+    }
+
+    const std::size_t mask;
+
+    util::aligned_ptr<Cell[]> cells;
+
+    /** Position of the next write, with @c CLOSED bit */
+    alignas(64) std::atomic<std::size_t> tail;
+
+    /** Position of the next read */
+    alignas(64) std::atomic<std::size_t> head;
+
+    /** Segment replacing this one once it is closed */
+    alignas(64) std::atomic<Segment*> next;
+};
+
+
+MessageQueue::MessageQueue(std::size_t capacity, Overflow policy)
+: policy_ { policy }
+, dropped_ { 0 }
+{
+    std::size_t size = roundUpToPowerOfTwo(std::max<std::size_t>(capacity, 2));
+    segments_.push_back(util::make_aligned<Segment>(size));
+    head_ = tail_ = segments_.back().get();
+}
+
+MessageQueue::~MessageQueue() = default;
+
 void MessageQueue::post(const Message& message) {
-    std::lock_guard<std::mutex> guard(mutex_);
-    messages_.push(message);
+    while (true) {
+        Segment* segment = tail_.load(std::memory_order_acquire);
+        switch (tryPush(*segment, message)) {
+        case PushResult::OK:
+            return;
+
+        case PushResult::CLOSED:
+            // segment is being replaced, try the new one
+            std::this_thread::yield();
+            break;
+
+        case PushResult::FULL:
+            if (policy_ == Overflow::GROW) {
+                grow(segment);
+            } else if (policy_ == Overflow::DROP_OLDEST) {
+                Message oldest;
+                if (tryPop(*segment, oldest)) {
+                    dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+            } else {
+                std::this_thread::yield();
+            }
+            break;
+        }
+    }
 }
 
 bool MessageQueue::empty() const {
-    std::lock_guard<std::mutex> guard(mutex_);
-    return messages_.empty();
+    return depth() == 0;
 }
 
 Message MessageQueue::pop() {
-    std::lock_guard<std::mutex> guard(mutex_);
-    return popMessageNoLock();
-}
-
-Message MessageQueue::popMessageNoLock() {
-    if (!messages_.empty()) {
-        Message message = messages_.front();
-        messages_.pop();
+    Message message;
+    if (tryPop(message)) {
         return message;
     } else {
         throw std::runtime_error("Cannot take message from empty queue");
     }
 }
 
+bool MessageQueue::tryPop(Message& message) {
+    while (true) {
+        Segment* segment = head_.load(std::memory_order_relaxed);
+        if (tryPop(*segment, message)) {
+            return true;
+        }
+        std::size_t tail = segment->tail.load(std::memory_order_acquire);
+        if (!(tail & CLOSED)) {
+            return false;
+        }
+        if (segment->head.load(std::memory_order_acquire) < (tail & ~CLOSED)) {
+            // closed, but some producer has not finished writing yet
+            std::this_thread::yield();
+            continue;
+        }
+        head_.store(segment->next.load(std::memory_order_acquire),
+                std::memory_order_release);
+    }
+}
+
+std::size_t MessageQueue::depth() const {
+    std::size_t total = 0;
+    Segment* segment = head_.load(std::memory_order_acquire);
+    while (segment) {
+        total += segment->size();
+        segment = segment->next.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+std::size_t MessageQueue::capacity() const {
+    return tail_.load(std::memory_order_acquire)->capacity();
+}
+
+auto MessageQueue::tryPush(Segment& segment,
+        const Message& message) -> PushResult {
+    std::size_t pos = segment.tail.load(std::memory_order_relaxed);
+    while (true) {
+        if (pos & CLOSED) {
+            return PushResult::CLOSED;
+        }
+        Segment::Cell& cell = segment.cells[pos & segment.mask];
+        std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(seq)
+                - static_cast<std::intptr_t>(pos);
+
+        if (diff == 0) {
+            if (segment.tail.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed)) {
+                cell.message = message;
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return PushResult::OK;
+            }
+        } else if (diff < 0) {
+            return PushResult::FULL;
+        } else {
+            pos = segment.tail.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool MessageQueue::tryPop(Segment& segment, Message& message) {
+    // Producers dropping the oldest messages compete with the consumer,
+    // hence the head is advanced with CAS as well
+    std::size_t pos = segment.head.load(std::memory_order_relaxed);
+    while (true) {
+        Segment::Cell& cell = segment.cells[pos & segment.mask];
+        std::size_t seq = cell.sequence.load(std::memory_order_acquire);
+        std::intptr_t diff = static_cast<std::intptr_t>(seq)
+                - static_cast<std::intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            if (segment.head.compare_exchange_weak(pos, pos + 1,
+                    std::memory_order_relaxed)) {
+                message = std::move(cell.message);
+                cell.sequence.store(pos + segment.mask + 1,
+                        std::memory_order_release);
+                return true;
+            }
+        } else if (diff < 0) {
+            return false;
+        } else {
+            pos = segment.head.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+void MessageQueue::grow(Segment* full) {
+    std::lock_guard<std::mutex> guard(growMutex_);
+    if (tail_.load(std::memory_order_relaxed) != full) {
+        // someone else did it already
+        return;
+    }
+    segments_.push_back(util::make_aligned<Segment>(2 * full->capacity()));
+    Segment* segment = segments_.back().get();
+
+    full->next.store(segment, std::memory_order_release);
+    tail_.store(segment, std::memory_order_release);
+    full->tail.fetch_or(CLOSED, std::memory_order_acq_rel);
+}
+
 } /* namespace core */
 } /* namespace zephyr */
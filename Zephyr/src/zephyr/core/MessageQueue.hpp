@@ -6,21 +6,59 @@
 #define ZEPHYR_CORE_MESSAGEQUEUE_HPP_
 
 #include <zephyr/core/Message.hpp>
-#include <queue>
+#include <zephyr/util/make_aligned.hpp>
+#include <atomic>
+#include <memory>
 #include <mutex>
+#include <vector>
 
 
 namespace zephyr {
 namespace core {
 
 /**
- * Thread-safe queue for internal communication via messages.
+ * Thread-safe queue for internal communication via messages. Any number of
+ * threads may post messages, but only one thread may take them out.
+ *
+ * Messages are kept in a bounded lock-free ring. What happens when the ring is
+ * full is decided by the @ref Overflow policy.
  */
 class MessageQueue {
 public:
 
+    /** Behaviour of @ref post() when the ring is full */
+    enum class Overflow {
+        /** Wait until the consumer makes some room */
+        BLOCK,
+
+        /** Discard the oldest message in the queue */
+        DROP_OLDEST,
+
+        /** Allocate bigger ring, never loses messages */
+        GROW
+    };
+
+    /** Initial capacity of the ring used by default */
+    static const std::size_t DEFAULT_CAPACITY = 1024;
+
     /**
-     * Places the message in the queue.
+     * Creates empty queue.
+     *
+     * @param capacity Number of messages the ring can hold, rounded up to the
+     *        power of two
+     * @param policy What to do when the ring is full
+     */
+    explicit MessageQueue(std::size_t capacity = DEFAULT_CAPACITY,
+            Overflow policy = Overflow::GROW);
+
+    MessageQueue(const MessageQueue&) = delete;
+    MessageQueue& operator = (const MessageQueue&) = delete;
+
+    ~MessageQueue();
+
+    /**
+     * Places the message in the queue. With @ref Overflow::BLOCK policy, it
+     * must not be called from the consumer thread, or it may wait forever.
      *
      * @param message Message to be put in the queue
      */
@@ -33,32 +71,90 @@ public:
 
     /**
      * Removes the message from the front of the queue.
+     *
+     * @throws std::runtime_error if the queue is empty
      */
     Message pop();
 
     /**
-     * Atomically empties the queue.
+     * Removes the message from the front of the queue, if there is any.
+     *
+     * @param message Object to move the message to
+     * @return @c true if a message was taken, @c false if the queue was empty
+     */
+    bool tryPop(Message& message);
+
+    /**
+     * Empties the queue. Messages posted during the operation may or may not
+     * be taken out.
      */
     template <typename OutputIter>
     void drain(OutputIter iter) {
-        std::lock_guard<std::mutex> guard(mutex_);
-        while (! messages_.empty()) {
-            *iter++ = popMessageNoLock();
+        std::size_t count = depth();
+        Message message;
+        while (count -- > 0 && tryPop(message)) {
+            *iter++ = std::move(message);
         }
     }
 
+    /**
+     * @return Number of messages in the queue; only a hint if other threads
+     *         operate on the queue at the same time
+     */
+    std::size_t depth() const;
+
+    /**
+     * @return Number of messages discarded due to the overflow
+     */
+    std::size_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return Number of messages the queue can currently hold without
+     *         overflowing
+     */
+    std::size_t capacity() const;
+
+    Overflow policy() const {
+        return policy_;
+    }
 
 private:
+    /** Fixed-size ring of messages */
+    struct Segment;
 
-    /** Removes the message from the fron of the queue */
-    Message popMessageNoLock();
+    /** Result of the attempt to put the message in the segment */
+    enum class PushResult { OK, FULL, CLOSED };
 
-    /** Queue holding the messages */
-    std::queue<Message> messages_;
+    /** Tries to put the message in the segment */
+    static PushResult tryPush(Segment& segment, const Message& message);
 
-    /** Mutex protecting the queue */
-    mutable std::mutex mutex_;
+    /** Tries to take the message from the segment */
+    static bool tryPop(Segment& segment, Message& message);
+
+    /** Replaces full producer segment with a bigger one */
+    void grow(Segment* full);
+
+    const Overflow policy_;
+
+    /** Segment read by the consumer */
+    alignas(64) std::atomic<Segment*> head_;
+
+    /** Segment written by the producers */
+    alignas(64) std::atomic<Segment*> tail_;
+
+    /** Number of dropped messages */
+    alignas(64) std::atomic<std::size_t> dropped_;
+
+    /**
+     * All the segments ever allocated. Retired ones are kept alive, since
+     * producers might still be looking at them.
+     */
+    std::vector<util::aligned_ptr<Segment>> segments_;
 
+    /** Protects the list of segments, taken only to grow the queue */
+    std::mutex growMutex_;
 };
 
 } /* namespace core */
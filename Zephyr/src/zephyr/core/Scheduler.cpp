@@ -1,7 +1,9 @@
 #include <zephyr/core/Scheduler.hpp>
+#include <zephyr/util/make_unique.hpp>
 #include <thread>
 #include <stdexcept>
 #include <algorithm>
+#include <iostream>
 
 namespace zephyr {
 namespace core {
@@ -9,11 +11,22 @@ namespace core {
 Scheduler::Scheduler()
 : executor(this)
 , is_running_(false)
+, mode_(ExecutionMode::SERIAL)
+, graph_dirty_(true)
+, remaining_(0)
 { }
 
+Scheduler::~Scheduler() = default;
+
 void Scheduler::startTask(const task_id& name, int priority,
         const task_ptr& task) {
-    post_operation_(start_task_cmd { name, priority, task });
+    startTask(name, priority, task, TaskConstraints::exclusive());
+}
+
+void Scheduler::startTask(const task_id& name, int priority,
+        const task_ptr& task, TaskConstraints constraints) {
+    post_operation_(start_task_cmd { name, priority, task,
+        std::move(constraints) });
 }
 
 void Scheduler::stopTask(const task_id& name) {
@@ -32,10 +45,23 @@ void Scheduler::run() {
     // set the flag
     is_running_ = true;
 
+    if (mode_ == ExecutionMode::PARALLEL) {
+        if (!pool_) {
+            unsigned cores = std::thread::hardware_concurrency();
+            workerCount(cores > 1 ? cores - 1 : 0);
+        }
+        pool_->attach();
+    }
+
     // main loop
     while (is_running_) {
-        update_all_();
+        if (mode_ == ExecutionMode::PARALLEL) {
+            update_parallel_();
+        } else {
+            update_all_();
+        }
         execute_delayed_operations_();
+        frameArena_.endFrame();
     }
 }
 
@@ -44,11 +70,22 @@ void Scheduler::stop() {
     is_running_ = false;
 }
 
+void Scheduler::executionMode(ExecutionMode mode) {
+    mode_ = mode;
+}
+
+void Scheduler::workerCount(std::size_t count) {
+    jobs_ = Jobs { nullptr };
+    pool_.reset();
+    pool_ = util::make_unique<WorkerPool>(count);
+    jobs_ = Jobs { pool_.get() };
+}
+
 void Scheduler::do_start_task_(const task_id& name, int priority,
-        const task_ptr& task) {
+        const task_ptr& task, const TaskConstraints& constraints) {
     try {
         task->start();
-        insert_into_active_list_( { name, priority, task });
+        insert_into_active_list_( { name, priority, task, constraints });
     } catch (const std::exception& e) {
         std::cerr << "[Scheduler] In " << name << " start(): ";
         std::cerr << "exception: " << e.what() << std::endl;
@@ -128,7 +165,8 @@ void Scheduler::do_notify_(const queue_id& condition) {
 }
 
 void Scheduler::Executor::operator ()(const start_task_cmd& cmd) {
-    scheduler->do_start_task_(cmd.name, cmd.priority, cmd.task);
+    scheduler->do_start_task_(cmd.name, cmd.priority, cmd.task,
+            cmd.constraints);
 }
 
 void Scheduler::Executor::operator ()(const stop_task_cmd& cmd) {
@@ -145,16 +183,163 @@ void Scheduler::Executor::operator ()(const notify_cmd& cmd) {
 
 void Scheduler::update_all_() {
     for (const task_info& task : active_) {
-        try {
-            task.task->update();
-        } catch (const std::exception& e) {
-            std::cerr << "[Scheduler] In " << task.name << ": ";
-            std::cerr << "exception: " << e.what() << std::endl;
-        } catch (...) {
-            std::cerr << "[Scheduler] In " << task.name << ": ";
-            std::cerr << "Unknown exception!" << std::endl;
+        update_task_(task);
+    }
+}
+
+void Scheduler::update_task_(const task_info& task) {
+    try {
+        task.task->update();
+    } catch (const std::exception& e) {
+        std::cerr << "[Scheduler] In " << task.name << ": ";
+        std::cerr << "exception: " << e.what() << std::endl;
+    } catch (...) {
+        std::cerr << "[Scheduler] In " << task.name << ": ";
+        std::cerr << "Unknown exception!" << std::endl;
+    }
+}
+
+void Scheduler::update_parallel_() {
+    if (graph_dirty_) {
+        build_graph_();
+        graph_dirty_ = false;
+    }
+    if (graph_.empty()) {
+        return;
+    }
+    remaining_ = graph_.size();
+    for (auto& node : graph_) {
+        node->pending = node->dependencies;
+    }
+    for (auto& node : graph_) {
+        if (node->dependencies == 0) {
+            dispatch_node_(*node);
+        }
+    }
+    pool_->helpUntil([this] { return remaining_ == 0; });
+}
+
+void Scheduler::build_graph_() {
+    std::vector<const task_info*> tasks;
+    for (const task_info& task : active_) {
+        tasks.push_back(&task);
+    }
+    std::size_t count = tasks.size();
+
+    // topological sort with respect to explicit ordering constraints, ties
+    // are resolved according to the priority order
+    std::vector<int> blockers(count, 0);
+    for (std::size_t i = 0; i < count; ++ i) {
+        for (std::size_t j = 0; j < count; ++ j) {
+            if (i != j && tasks[i]->constraints.runsAfter(tasks[j]->name)) {
+                ++ blockers[i];
+            }
+        }
+    }
+    std::vector<const task_info*> order;
+    std::vector<bool> used(count, false);
+    while (order.size() < count) {
+        std::size_t next = count;
+        for (std::size_t i = 0; i < count; ++ i) {
+            if (!used[i] && blockers[i] == 0) {
+                next = i;
+                break;
+            }
+        }
+        if (next == count) {
+            std::cerr << "[Scheduler] Warning: cyclic task ordering, "
+                    << "falling back to the priority order" << std::endl;
+            order = tasks;
+            break;
+        }
+        used[next] = true;
+        order.push_back(tasks[next]);
+        for (std::size_t i = 0; i < count; ++ i) {
+            if (!used[i] && tasks[i]->constraints.runsAfter(tasks[next]->name)) {
+                -- blockers[i];
+            }
+        }
+    }
+
+    // edges always point forward in the established order
+    graph_.clear();
+    for (const task_info* task : order) {
+        std::unique_ptr<graph_node> node { new graph_node };
+        node->job.function = &Scheduler::run_node_;
+        node->job.data = node.get();
+        node->info = task;
+        node->dependencies = 0;
+        node->pending = 0;
+        node->scheduler = this;
+        graph_.push_back(std::move(node));
+    }
+    for (std::size_t j = 0; j < count; ++ j) {
+        const task_info& later = *order[j];
+        for (std::size_t i = 0; i < j; ++ i) {
+            const task_info& earlier = *order[i];
+            if (conflicting_(earlier, later)
+                    || later.constraints.runsAfter(earlier.name)) {
+                graph_[i]->successors.push_back(j);
+                ++ graph_[j]->dependencies;
+            }
+        }
+    }
+}
+
+bool Scheduler::conflicting_(const task_info& a, const task_info& b) {
+    const TaskConstraints& ca = a.constraints;
+    const TaskConstraints& cb = b.constraints;
+
+    if (ca.isExclusive() || cb.isExclusive()) {
+        return true;
+    }
+    // main thread tasks keep their relative order
+    if (ca.mainThread() && cb.mainThread()) {
+        return true;
+    }
+    // each task implicitly writes the resource named after itself
+    auto touches = [](const task_info& task, const std::string& resource) {
+        return task.name == resource
+            || task.constraints.isWriting(resource)
+            || task.constraints.isReading(resource);
+    };
+    auto writesTouched = [&touches](const task_info& writer,
+            const task_info& other) {
+        if (touches(other, writer.name)) {
+            return true;
+        }
+        for (const std::string& resource : writer.constraints.writes()) {
+            if (touches(other, resource)) {
+                return true;
+            }
+        }
+        return false;
+    };
+    return writesTouched(a, b) || writesTouched(b, a);
+}
+
+void Scheduler::dispatch_node_(graph_node& node) {
+    if (node.info->constraints.mainThread()) {
+        pool_->submitToMain(&node.job);
+    } else {
+        pool_->submit(&node.job);
+    }
+}
+
+void Scheduler::run_node_(Job& job) {
+    graph_node& node = *static_cast<graph_node*>(job.data);
+    Scheduler& scheduler = *node.scheduler;
+
+    update_task_(*node.info);
+
+    for (std::size_t index : node.successors) {
+        graph_node& next = *scheduler.graph_[index];
+        if (-- next.pending == 0) {
+            scheduler.dispatch_node_(next);
         }
     }
+    // must be the last access to the graph in this frame
+    -- scheduler.remaining_;
 }
 
 void Scheduler::post_operation_(operation&& op) {
@@ -174,6 +359,8 @@ void Scheduler::execute_delayed_operations_() {
 }
 
 void Scheduler::perform_operation_(const operation& op) {
+    // set of active tasks may change
+    graph_dirty_ = true;
     // dispatch to visitor
     boost::apply_visitor(executor, op);
 }
@@ -6,7 +6,12 @@
 #define ZEPHYR_CORE_SCHEDULER_HPP_
 
 #include <zephyr/core/Task.hpp>
+#include <zephyr/core/TaskConstraints.hpp>
+#include <zephyr/core/WorkerPool.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <zephyr/core/FrameArena.hpp>
 #include <string>
+#include <vector>
 #include <memory>
 #include <mutex>
 #include <atomic>
@@ -25,6 +30,12 @@ namespace core {
  *
  * Tasks may be suspended, resumed and stopped. Suspended task waits for
  * certain condition, specified as string.
+ *
+ * By default tasks are executed one after another in the thread that called
+ * @ref run(). In the @ref ExecutionMode::PARALLEL mode, each frame is turned
+ * into a dependency graph based on the @ref TaskConstraints of the tasks, and
+ * executed by a @ref WorkerPool. Tasks that do not declare constraints are
+ * exclusive, i.e. they run on the main thread in the serial order.
  */
 class Scheduler {
 public:
@@ -37,11 +48,24 @@ public:
     /** Type of the task pointer */
     typedef std::shared_ptr<Task> task_ptr;
 
+    /** Way of executing the tasks in each frame */
+    enum class ExecutionMode {
+        /** Tasks are updated one after another, in the priority order */
+        SERIAL,
+
+        /** Non-conflicting tasks are updated concurrently */
+        PARALLEL
+    };
+
     /** Creates a new scheduler */
     Scheduler();
 
+    /** Stops the worker threads, if any */
+    ~Scheduler();
+
     /**
-     * Adds task to the scheduler, according to the specified priority.
+     * Adds task to the scheduler, according to the specified priority. Task is
+     * treated as exclusive, see @ref TaskConstraints::exclusive().
      *
      * @param name Name of the task
      * @param priority Priority of the task
@@ -49,6 +73,18 @@ public:
      */
     void startTask(const task_id& name, int priority, const task_ptr& task);
 
+    /**
+     * Adds task to the scheduler, according to the specified priority, with
+     * declared constraints used in the parallel mode.
+     *
+     * @param name Name of the task
+     * @param priority Priority of the task
+     * @param task Task itself
+     * @param constraints Data accessed by the task
+     */
+    void startTask(const task_id& name, int priority, const task_ptr& task,
+            TaskConstraints constraints);
+
     /**
      * Permanently stops the task with specified name.
      *
@@ -81,12 +117,58 @@ public:
      */
     void stop();
 
+    /**
+     * Sets the execution mode. Shall not be called while the scheduler is
+     * running.
+     */
+    void executionMode(ExecutionMode mode);
+
+    ExecutionMode executionMode() const {
+        return mode_;
+    }
+
+    /**
+     * Creates the worker pool with specified number of background threads,
+     * replacing the existing one. Shall not be called while the scheduler is
+     * running. If the pool is not created explicitly, parallel mode uses one
+     * thread per hardware core.
+     *
+     * @param count Number of threads besides the one running the scheduler
+     */
+    void workerCount(std::size_t count);
+
+    /**
+     * @return Worker pool used by the scheduler, or @c nullptr if it has not
+     *         been created yet
+     */
+    WorkerPool* workers() const {
+        return pool_.get();
+    }
+
+    /**
+     * @return Job facility using the worker pool. It stays the same object
+     *         when the pool is replaced by @ref workerCount(), and executes
+     *         everything inline while there is no pool.
+     */
+    Jobs& jobs() {
+        return jobs_;
+    }
+
+    /**
+     * @return Allocator of the transient data, reset after each iteration of
+     *         the main loop
+     */
+    FrameArena& frameArena() {
+        return frameArena_;
+    }
+
 private:
     /** Task data */
     struct task_info {
         task_id name;
         int priority;
         task_ptr task;
+        TaskConstraints constraints;
     };
 
     /**
@@ -97,6 +179,7 @@ private:
         task_id name;
         int priority;
         task_ptr task;
+        TaskConstraints constraints;
     };
 
     struct stop_task_cmd {
@@ -123,7 +206,8 @@ private:
 
     /** Functions performing actual work */
     /// @{
-    void do_start_task_(const task_id& name, int priority, const task_ptr& task);
+    void do_start_task_(const task_id& name, int priority, const task_ptr& task,
+            const TaskConstraints& constraints);
     void do_stop_task_(const task_id& name);
     void do_suspend_task_(const task_id& name, const queue_id& condition);
     void do_notify_(const queue_id& condition);
@@ -146,6 +230,45 @@ private:
     /** Loops through active tasks and calls `update()` */
     void update_all_();
 
+    /** Updates active tasks using the worker pool */
+    void update_parallel_();
+
+    /** Calls `update()` of the task, catching all the exceptions */
+    static void update_task_(const task_info& task);
+
+    /** Node of the frame dependency graph */
+    struct graph_node {
+        /** Job executing the task */
+        Job job;
+
+        /** Updated task */
+        const task_info* info;
+
+        /** Indices of nodes depending on this one */
+        std::vector<std::size_t> successors;
+
+        /** Number of nodes this one depends on */
+        int dependencies;
+
+        /** Number of unfinished dependencies in the current frame */
+        std::atomic<int> pending;
+
+        /** Scheduler owning the node */
+        Scheduler* scheduler;
+    };
+
+    /** Builds the frame dependency graph from the list of active tasks */
+    void build_graph_();
+
+    /** Submits the node for execution to the appropriate queue */
+    void dispatch_node_(graph_node& node);
+
+    /** Job function executing the graph node */
+    static void run_node_(Job& job);
+
+    /** Checks whether two tasks may not be executed concurrently */
+    static bool conflicting_(const task_info& a, const task_info& b);
+
     /** Schedules the operation */
     void post_operation_(operation&& op);
 
@@ -190,6 +313,26 @@ private:
 
     /** Queue of delayed operations */
     std::queue<operation> operation_queue_;
+
+    /** Current execution mode */
+    ExecutionMode mode_;
+
+    /** Threads used in the parallel mode */
+    std::unique_ptr<WorkerPool> pool_;
+
+    /** Jobs on @ref pool_, updated whenever it is replaced */
+    Jobs jobs_ { nullptr };
+
+    FrameArena frameArena_;
+
+    /** Frame dependency graph, in topological order */
+    std::vector<std::unique_ptr<graph_node>> graph_;
+
+    /** Flag indicating whether the set of active tasks has changed */
+    bool graph_dirty_;
+
+    /** Number of graph nodes not yet executed in the current frame */
+    std::atomic<std::size_t> remaining_;
 };
 
 } /* namespace core */
@@ -0,0 +1,123 @@
+/**
+ * @file TaskConstraints.hpp
+ */
+
+#ifndef ZEPHYR_CORE_TASKCONSTRAINTS_HPP_
+#define ZEPHYR_CORE_TASKCONSTRAINTS_HPP_
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+
+namespace zephyr {
+namespace core {
+
+/**
+ * Description of the data a task accesses, used by the scheduler in parallel
+ * mode to decide which tasks may run at the same time. Resources are just
+ * names - typically names of the tasks owning the data, since each task
+ * implicitly writes to the resource named after itself.
+ *
+ * Two tasks conflict if one writes a resource the other reads or writes. Such
+ * tasks never overlap, and run in the same order as in the serial mode.
+ *
+ * Example:
+ * @code
+ * TaskConstraints().reads(CLOCK_UPDATER_NAME).writes("camera").after("input")
+ * @endcode
+ */
+class TaskConstraints {
+public:
+
+    /**
+     * Constraints of a task that did not declare anything. Such a task
+     * conflicts with every other task and runs on the main thread, hence in
+     * parallel mode it behaves exactly as in the serial one.
+     */
+    static TaskConstraints exclusive() {
+        TaskConstraints constraints;
+        constraints.exclusive_ = true;
+        constraints.mainThread_ = true;
+        return constraints;
+    }
+
+    /** Declares that the task reads the specified resource */
+    TaskConstraints& reads(std::string resource) {
+        reads_.push_back(std::move(resource));
+        return *this;
+    }
+
+    /** Declares that the task modifies the specified resource */
+    TaskConstraints& writes(std::string resource) {
+        writes_.push_back(std::move(resource));
+        return *this;
+    }
+
+    /** Declares that the task must run after the specified one */
+    TaskConstraints& after(std::string task) {
+        after_.push_back(std::move(task));
+        return *this;
+    }
+
+    /**
+     * Pins the task to the main thread (the one running the scheduler), e.g.
+     * because it uses the GL context. Tasks pinned to the main thread are
+     * also executed in the serial mode order with respect to each other.
+     */
+    TaskConstraints& onMainThread() {
+        mainThread_ = true;
+        return *this;
+    }
+
+    const std::vector<std::string>& reads() const {
+        return reads_;
+    }
+
+    const std::vector<std::string>& writes() const {
+        return writes_;
+    }
+
+    const std::vector<std::string>& after() const {
+        return after_;
+    }
+
+    bool mainThread() const {
+        return mainThread_;
+    }
+
+    bool isExclusive() const {
+        return exclusive_;
+    }
+
+    /** Checks whether the task is declared to run after specified one */
+    bool runsAfter(const std::string& task) const {
+        return contains(after_, task);
+    }
+
+    bool isReading(const std::string& resource) const {
+        return contains(reads_, resource);
+    }
+
+    bool isWriting(const std::string& resource) const {
+        return contains(writes_, resource);
+    }
+
+private:
+    static bool contains(const std::vector<std::string>& names,
+            const std::string& name) {
+        return std::find(begin(names), end(names), name) != end(names);
+    }
+
+    std::vector<std::string> reads_;
+    std::vector<std::string> writes_;
+    std::vector<std::string> after_;
+
+    bool mainThread_ = false;
+    bool exclusive_ = false;
+};
+
+} /* namespace core */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_CORE_TASKCONSTRAINTS_HPP_ */
@@ -0,0 +1,144 @@
+/**
+ * @file WorkStealingQueue.hpp
+ */
+
+#ifndef ZEPHYR_CORE_WORKSTEALINGQUEUE_HPP_
+#define ZEPHYR_CORE_WORKSTEALINGQUEUE_HPP_
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <stdexcept>
+
+
+namespace zephyr {
+namespace core {
+
+/**
+ * Bounded, lock-free work-stealing deque (Chase-Lev). Owner thread pushes and
+ * pops at the bottom end, other threads steal from the top. Stores pointers
+ * only, the queue never owns the items.
+ *
+ * @tparam T Type of the item pointed to by the stored pointers
+ */
+template <typename T>
+class WorkStealingQueue {
+public:
+
+    /**
+     * Creates empty queue able to hold @c capacity items.
+     *
+     * @param capacity Maximal number of items, must be a power of two
+     */
+    explicit WorkStealingQueue(std::size_t capacity = 4096)
+    : mask_ { capacity - 1 }
+    , buffer_ { new std::atomic<T*>[capacity] }
+    , top_ { 0 }
+    , bottom_ { 0 }
+    {
+        if (capacity == 0 || (capacity & mask_) != 0) {
+            throw std::invalid_argument("Capacity must be a power of two");
+        }
+    }
+
+    /**
+     * Places the item at the bottom of the queue. May only be called by the
+     * owner thread.
+     *
+     * @return @c false if the queue is full, @c true otherwise
+     */
+    bool push(T* item) {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        if (b - t > static_cast<std::int64_t>(mask_)) {
+            return false;
+        }
+        buffer_[b & mask_].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * Removes the most recently pushed item. May only be called by the owner
+     * thread.
+     *
+     * @return Removed item, or @c nullptr if the queue is empty
+     */
+    T* pop() {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t <= b) {
+            T* item = buffer_[b & mask_].load(std::memory_order_relaxed);
+            if (t == b) {
+                // last item, race against thieves
+                if (!top_.compare_exchange_strong(t, t + 1,
+                        std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                    item = nullptr;
+                }
+                bottom_.store(b + 1, std::memory_order_relaxed);
+            }
+            return item;
+        } else {
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return nullptr;
+        }
+    }
+
+    /**
+     * Removes the least recently pushed item. May be called by any thread.
+     *
+     * @return Removed item, or @c nullptr if the queue is empty or another
+     *         thread took the item first
+     */
+    T* steal() {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t b = bottom_.load(std::memory_order_acquire);
+
+        if (t < b) {
+            T* item = buffer_[t & mask_].load(std::memory_order_relaxed);
+            if (!top_.compare_exchange_strong(t, t + 1,
+                    std::memory_order_seq_cst, std::memory_order_relaxed)) {
+                return nullptr;
+            }
+            return item;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Checks whether the queue is empty. Result is only a hint if other
+     * threads operate on the queue at the same time.
+     */
+    bool empty() const {
+        std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+        return b <= t;
+    }
+
+    std::size_t capacity() const {
+        return mask_ + 1;
+    }
+
+private:
+    /** Capacity - 1, used to wrap indices */
+    const std::size_t mask_;
+
+    /** Circular buffer of items */
+    std::unique_ptr<std::atomic<T*>[]> buffer_;
+
+    /** Index of the next item to steal, modified by thieves */
+    alignas(64) std::atomic<std::int64_t> top_;
+
+    /** Index one past the last pushed item, modified by the owner */
+    alignas(64) std::atomic<std::int64_t> bottom_;
+};
+
+} /* namespace core */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_CORE_WORKSTEALINGQUEUE_HPP_ */
@@ -0,0 +1,198 @@
+/**
+ * @file WorkerPool.cpp
+ */
+
+#include <zephyr/core/WorkerPool.hpp>
+
+namespace zephyr {
+namespace core {
+
+namespace {
+
+/** Pool the calling thread belongs to */
+thread_local const WorkerPool* currentPool = nullptr;
+
+/** Slot of the calling thread in the pool */
+thread_local int currentIndex = -1;
+
+/** Number of unsuccessful searches before the worker goes to sleep */
+const int SPIN_COUNT = 64;
+
+} /* namespace */
+
+
+WorkerPool::WorkerPool(std::size_t workers)
+: hasInjected_ { false }
+, hasMainJobs_ { false }
+, epoch_ { 0 }
+, sleeping_ { 0 }
+, stopping_ { false }
+{
+    for (std::size_t i = 0; i < workers + 1; ++ i) {
+        slots_.push_back(util::make_aligned<Slot>());
+    }
+    for (std::size_t i = 1; i <= workers; ++ i) {
+        threads_.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    stopping_ = true;
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        ++ epoch_;
+    }
+    wakeUp_.notify_all();
+    for (std::thread& thread : threads_) {
+        thread.join();
+    }
+    if (currentPool == this) {
+        currentPool = nullptr;
+        currentIndex = -1;
+    }
+}
+
+void WorkerPool::attach() {
+    currentPool = this;
+    currentIndex = 0;
+}
+
+void WorkerPool::submit(Job* job) {
+    int index = currentSlot();
+    if (index >= 0) {
+        if (!slots_[index]->queue.push(job)) {
+            // queue is full, there is no better option than doing it now
+            execute(job);
+            return;
+        }
+    } else {
+        std::lock_guard<std::mutex> lock(inboxMutex_);
+        injected_.push_back(job);
+        hasInjected_ = true;
+    }
+    notifyWorkers();
+}
+
+void WorkerPool::submitToMain(Job* job) {
+    std::lock_guard<std::mutex> lock(inboxMutex_);
+    mainJobs_.push_back(job);
+    hasMainJobs_ = true;
+}
+
+bool WorkerPool::runOne() {
+    int index = currentSlot();
+    Job* job = index >= 0 ? findJob(index) : takeInjected();
+    if (job) {
+        execute(job);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+bool WorkerPool::isMainThread() const {
+    return currentSlot() == 0;
+}
+
+bool WorkerPool::isPoolThread() const {
+    return currentSlot() >= 0;
+}
+
+void WorkerPool::workerLoop(std::size_t index) {
+    currentPool = this;
+    currentIndex = index;
+
+    int misses = 0;
+    while (!stopping_) {
+        std::uint64_t epoch = epoch_;
+        if (Job* job = findJob(index)) {
+            execute(job);
+            misses = 0;
+        } else if (++ misses < SPIN_COUNT) {
+            std::this_thread::yield();
+        } else {
+            idle(epoch);
+            misses = 0;
+        }
+    }
+}
+
+void WorkerPool::execute(Job* job) {
+    job->function(*job);
+}
+
+Job* WorkerPool::findJob(std::size_t index) {
+    if (index == 0) {
+        if (Job* job = takeMainJob()) {
+            return job;
+        }
+    }
+    if (Job* job = slots_[index]->queue.pop()) {
+        return job;
+    }
+    if (Job* job = takeInjected()) {
+        return job;
+    }
+    std::size_t count = slots_.size();
+    for (std::size_t i = 1; i < count; ++ i) {
+        std::size_t victim = (index + i) % count;
+        if (Job* job = slots_[victim]->queue.steal()) {
+            return job;
+        }
+    }
+    return nullptr;
+}
+
+Job* WorkerPool::takeInjected() {
+    if (!hasInjected_) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(inboxMutex_);
+    if (injected_.empty()) {
+        return nullptr;
+    }
+    Job* job = injected_.back();
+    injected_.pop_back();
+    hasInjected_ = !injected_.empty();
+    return job;
+}
+
+Job* WorkerPool::takeMainJob() {
+    if (!hasMainJobs_) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(inboxMutex_);
+    if (mainJobs_.empty()) {
+        return nullptr;
+    }
+    // preserve submission order
+    Job* job = mainJobs_.front();
+    mainJobs_.erase(mainJobs_.begin());
+    hasMainJobs_ = !mainJobs_.empty();
+    return job;
+}
+
+void WorkerPool::notifyWorkers() {
+    ++ epoch_;
+    if (sleeping_ > 0) {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+        wakeUp_.notify_all();
+    }
+}
+
+void WorkerPool::idle(std::uint64_t epoch) {
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    ++ sleeping_;
+    // either we see the new epoch, or the submitter sees us sleeping
+    wakeUp_.wait(lock, [this, epoch] {
+        return epoch_ != epoch || stopping_;
+    });
+    -- sleeping_;
+}
+
+int WorkerPool::currentSlot() const {
+    return currentPool == this ? currentIndex : -1;
+}
+
+} /* namespace core */
+} /* namespace zephyr */
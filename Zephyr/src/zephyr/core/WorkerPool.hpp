@@ -0,0 +1,178 @@
+/**
+ * @file WorkerPool.hpp
+ */
+
+#ifndef ZEPHYR_CORE_WORKERPOOL_HPP_
+#define ZEPHYR_CORE_WORKERPOOL_HPP_
+
+#include <zephyr/core/WorkStealingQueue.hpp>
+#include <zephyr/util/make_aligned.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace zephyr {
+namespace core {
+
+/**
+ * Unit of work executed by the @ref WorkerPool. Jobs are never owned by the
+ * pool - whoever submits the job must keep it alive until it is executed.
+ */
+struct Job {
+    /** Function invoked to execute the job */
+    void (*function)(Job& job);
+
+    /** Arbitrary data of the submitter */
+    void* data;
+};
+
+
+/**
+ * Fixed set of threads executing @ref Job objects. Each thread has its own
+ * work-stealing deque, idle threads steal from the others.
+ *
+ * Slot 0 belongs to the main thread, i.e. the one that called @ref attach()
+ * (usually the thread running the scheduler). It does not get a thread of its
+ * own - instead it executes jobs while waiting in @ref helpUntil(). Jobs
+ * submitted with @ref submitToMain() are guaranteed to be executed only by the
+ * main thread.
+ */
+class WorkerPool {
+public:
+
+    /**
+     * Creates pool with specified number of background threads.
+     *
+     * @param workers Number of threads to spawn, besides the main thread
+     */
+    explicit WorkerPool(std::size_t workers);
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator = (const WorkerPool&) = delete;
+
+    /** Stops and joins all the background threads */
+    ~WorkerPool();
+
+    /**
+     * Makes the calling thread the main thread of the pool.
+     */
+    void attach();
+
+    /**
+     * @return Number of threads executing jobs, including the main thread
+     */
+    std::size_t size() const {
+        return slots_.size();
+    }
+
+    /**
+     * Schedules the job for execution on any thread. If called by one of the
+     * pool threads, job is placed in its own queue.
+     */
+    void submit(Job* job);
+
+    /**
+     * Schedules the job for execution on the main thread.
+     */
+    void submitToMain(Job* job);
+
+    /**
+     * Executes at most one pending job in the calling thread.
+     *
+     * @return @c true if some job was executed, @c false otherwise
+     */
+    bool runOne();
+
+    /**
+     * Executes pending jobs in the calling thread until the predicate
+     * becomes true.
+     */
+    template <typename Pred>
+    void helpUntil(Pred done) {
+        while (!done()) {
+            if (!runOne()) {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    /**
+     * @return @c true if the calling thread is the main thread of this pool
+     */
+    bool isMainThread() const;
+
+    /**
+     * @return @c true if the calling thread is one of the pool threads,
+     *         including the main thread
+     */
+    bool isPoolThread() const;
+
+private:
+    /** Per-thread data */
+    struct Slot {
+        WorkStealingQueue<Job> queue;
+    };
+
+    /** Body of the background thread */
+    void workerLoop(std::size_t index);
+
+    /** Executes the job */
+    void execute(Job* job);
+
+    /** Tries to find job for thread occupying specified slot */
+    Job* findJob(std::size_t index);
+
+    /** Takes a job from the external injection queue */
+    Job* takeInjected();
+
+    /** Takes a job from the main thread's inbox */
+    Job* takeMainJob();
+
+    /** Wakes up sleeping workers, if any */
+    void notifyWorkers();
+
+    /** Puts the worker to sleep until something changes */
+    void idle(std::uint64_t epoch);
+
+    /** @return Index of the slot of calling thread, or -1 */
+    int currentSlot() const;
+
+    std::vector<util::aligned_ptr<Slot>> slots_;
+
+    std::vector<std::thread> threads_;
+
+    /** Jobs submitted from outside of the pool */
+    std::vector<Job*> injected_;
+
+    /** Jobs pinned to the main thread */
+    std::vector<Job*> mainJobs_;
+
+    /** Protects the injection queue and the main thread inbox */
+    std::mutex inboxMutex_;
+
+    /** Flag indicating whether jobs are present in injection queue */
+    std::atomic<bool> hasInjected_;
+
+    /** Flag indicating whether jobs are present in main thread's inbox */
+    std::atomic<bool> hasMainJobs_;
+
+    /** Incremented each time new work appears */
+    std::atomic<std::uint64_t> epoch_;
+
+    /** Number of workers waiting for the work */
+    std::atomic<int> sleeping_;
+
+    std::mutex sleepMutex_;
+    std::condition_variable wakeUp_;
+
+    std::atomic<bool> stopping_;
+};
+
+} /* namespace core */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_CORE_WORKERPOOL_HPP_ */
@@ -60,24 +60,24 @@ void LandscapeScene::createResources() {
     using namespace gfx;
     res.loadDefinitions("resources/materials.xml");
 
-    MaterialPtr mat = res.material("default");
-    MaterialPtr terrain = res.material("terrain");
-    MaterialPtr suzanne = res.material("suzanne");
+    MaterialHandle mat = res.material("default");
+    MaterialHandle terrain = res.material("terrain");
+    MaterialHandle suzanne = res.material("suzanne");
 
     effects::SimpleTerrainGenerator gen(100.0f, 8, 25.0f);
-    res.meshes["quad"] = gen.create();
-    res.meshes["suzanne"] = loadObjMesh("resources/suzanne2.obj");
-    res.meshes["star"] = gfx::makeStar(7, 0.3f);
-    res.meshes["container"] = loadObjMesh("resources/container.obj", NormCalc::SPLIT);
-    res.meshes["cube"] = loadObjMesh("resources/cube.obj", NormCalc::SPLIT);
-    res.meshes["ico"] = loadObjMesh("resources/ico.obj");
-
-    res.entities["ground"] = newEntity(terrain, res.meshes["quad"]);
-    res.entities["suzanne"] = newEntity(suzanne, res.meshes["suzanne"]);
-    res.entities["star"] = newEntity(res.material("white-solid"), res.meshes["star"]);
-    res.entities["container"] = newEntity(mat, res.meshes["container"]);
-    res.entities["cube"] = newEntity(res.material("cube"), res.meshes["cube"]);
-    res.entities["ico"] = newEntity(res.material("ico"), res.meshes["ico"]);
+    res.addMesh("quad", gen.create());
+    res.addMesh("suzanne", loadObjMesh("resources/suzanne2.obj"));
+    res.addMesh("star", gfx::makeStar(7, 0.3f));
+    res.addMesh("container", loadObjMesh("resources/container.obj", NormCalc::SPLIT));
+    res.addMesh("cube", loadObjMesh("resources/cube.obj", NormCalc::SPLIT));
+    res.addMesh("ico", loadObjMesh("resources/ico.obj"));
+
+    res.addEntity("ground", terrain, res.meshes["quad"]);
+    res.addEntity("suzanne", suzanne, res.meshes["suzanne"]);
+    res.addEntity("star", res.material("white-solid"), res.meshes["star"]);
+    res.addEntity("container", mat, res.meshes["container"]);
+    res.addEntity("cube", res.material("cube"), res.meshes["cube"]);
+    res.addEntity("ico", res.material("ico"), res.meshes["ico"]);
 }
 
 
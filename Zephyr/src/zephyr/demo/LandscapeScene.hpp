@@ -13,7 +13,7 @@
 
 using zephyr::scene::NodePtr;
 using zephyr::scene::SceneGraph;
-using zephyr::gfx::EntityPtr;
+using zephyr::gfx::EntityHandle;
 using zephyr::resources::ResourceSystem;
 
 
@@ -24,7 +24,7 @@ struct LandscapeScene {
 
     struct Item {
         NodePtr node;
-        EntityPtr entity;
+        EntityHandle entity;
     };
 
     ResourceSystem& res;
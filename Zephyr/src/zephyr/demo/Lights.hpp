@@ -9,7 +9,6 @@
 #include <zephyr/gfx/Camera.hpp>
 
 using zephyr::gfx::Renderer;
-using zephyr::gfx::UniformManager;
 using zephyr::gfx::Camera;
 
 
@@ -23,19 +22,18 @@ public:
 
     Lights(Renderer& renderer, Camera& camera)
     : renderer(renderer)
-    , uniforms(renderer.uniforms())
     , camera(camera)
     { }
 
 
     void update() {
-        uniforms.set3f("lightPos", camera.pos);
-        uniforms.set3f("lightAt", camera.pos + camera.forward());
+        gfx::FrameGlobals& globals = renderer.frameGlobals();
+        globals.lightPos = camera.pos;
+        globals.lightAt = camera.pos + camera.forward();
     }
 
 private:
     Renderer& renderer;
-    UniformManager& uniforms;
     Camera& camera;
 };
 
@@ -22,6 +22,10 @@ MainController::MainController(Root& root)
 , clocks(root.clockManager())
 , clock(clocks.getMainClock())
 , renderer(root.graphics().renderer())
+, transformGrain { config.get<std::size_t>("zephyr.scene.transform-grain",
+        scene::TransformSystem::DEFAULT_GRAIN) }
+, statsInterval { config.get<double>("zephyr.demo.stats-interval", 5.0) }
+, lastStats { 0 }
 {
     initCamera();
     initScene();
@@ -46,9 +50,15 @@ MainController::MainController(Root& root)
     });
 
     prevTime = clock.time();
+    lastStats = prevTime;
 
 }
 
+MainController::~MainController() {
+    std::cout << "[MainController] Frame arena: "
+            << root.scheduler().frameArena().stats() << std::endl;
+}
+
 void MainController::initCamera() {
     std::cout << "[MainController] Initializing camera\n";
 
@@ -61,13 +71,16 @@ void MainController::initCamera() {
 
     camera = std::make_shared<Camera>(proj, pos);
     cameraComp = std::make_shared<CameraComponent>(renderer, camera);
-    root.scheduler().startTask("camera-component", 1105, cameraComp);
+    root.scheduler().startTask("camera-component", 1105, cameraComp,
+            core::TaskConstraints().onMainThread()
+                .reads("camera").writes(gfx::GraphicsSystem::COMMANDS));
 
     cameraController = util::make_unique<gfx::CameraController>(camera, clock);
     core::registerHandler(root.dispatcher(), input::msg::INPUT_SYSTEM,
                 cameraController.get(), &CameraController::handle);
 
-    cameraBlur = util::make_unique<effects::CameraMotionBlur>(renderer);
+    cameraBlur = util::make_unique<effects::CameraMotionBlur>(renderer,
+            root.resources());
     core::registerHandler(root.dispatcher(), input::msg::INPUT_SYSTEM,
             cameraBlur.get(), &CameraMotionBlur::handle);
 
@@ -81,6 +94,9 @@ void MainController::initCamera() {
 
 void MainController::initScene() {
     landscape = util::make_unique<LandscapeScene>(root.resources());
+    for (std::size_t i = 0; i < landscape->items.size(); ++ i) {
+        proxies.push_back(bvh.insert(BoundingBox { }, i));
+    }
 }
 
 
@@ -89,21 +105,57 @@ void MainController::initMainTask() {
         void operator () (MainController*) { }
     } nop;
     std::shared_ptr<MainController> this_(this, nop);
-    root.scheduler().startTask("main-controller", 1100, std::move(this_));
+    // no GL calls, may run on any thread, concurrently with the rendering
+    root.scheduler().startTask("main-controller", 1100, std::move(this_),
+            core::TaskConstraints()
+                .reads(Root::CLOCK_UPDATER_NAME)
+                .writes("camera")
+                .writes(gfx::GraphicsSystem::COMMANDS));
 }
 
 
 void MainController::submitGeometry() {
-    auto submit = [this](const LandscapeScene::Item& item) {
-        renderer.submit(Renderable {
-            item.entity,
-            item.node->globalTransform()
-        });
-    };
-    std::for_each(begin(landscape->items), end(landscape->items), submit);
+    glm::mat4 viewProj = camera->projectionMatrix() * camera->viewMatrix();
+    Frustum frustum = Frustum::fromMatrix(glm::value_ptr(viewProj));
+    resources::ResourceSystem& resources = root.resources();
+
+    // only the paths of items that moved are refitted
+    for (std::size_t i = 0; i < landscape->items.size(); ++ i) {
+        const LandscapeScene::Item& item = landscape->items[i];
+        if (!item.node->transformChanged()) {
+            continue;
+        }
+        glm::mat4 transform = item.node->globalTransform();
+        const gfx::Entity& entity = resources.entityPool[item.entity];
+        const BoundingBox& box = resources.meshPool[entity.mesh].bounds.box;
+        bvh.update(proxies[i], transformBox(box, glm::value_ptr(transform)));
+    }
+    bvh.refit();
+
+    visible.clear();
+    bvh.query(frustum, visible);
+    cullStats.tested = bvh.visited();
+    cullStats.visible = visible.size();
+    cullStats.culled = landscape->items.size() - visible.size();
+
+    gfx::CommandRecorder commands = renderer.commands();
+    for (std::uint32_t i : visible) {
+        const LandscapeScene::Item& item = landscape->items[i];
+        commands.draw(item.entity, item.node->globalTransform());
+    }
 }
 
 
+void MainController::reportStats(double time) {
+    if (statsInterval <= 0 || time - lastStats < statsInterval) {
+        return;
+    }
+    std::cout << "Culling: " << cullStats << std::endl;
+    std::cout << "Frame arena: " << root.scheduler().frameArena().stats()
+            << std::endl;
+    lastStats = time;
+}
+
 void MainController::update() {
     double time = clock.time();
     taskletScheduler.update(time, clock.dt());
@@ -112,10 +164,11 @@ void MainController::update() {
     glm::vec3 p = 10.0f * camera->forward() + camera->pos;
     root.graphics().debug().addBox(glm::translate(p));
 
-    landscape->graph.update();
+    landscape->graph.update(root.jobs(), transformGrain);
     submitGeometry();
 
     std::cout << "FPS: " << 1 / (time - prevTime) << std::endl;
+    reportStats(time);
     prevTime = time;
 }
 
@@ -11,6 +11,8 @@
 #include <zephyr/time/TaskletScheduler.hpp>
 #include <zephyr/time/ActionScheduler.hpp>
 #include <zephyr/gfx/CameraComponent.hpp>
+#include <zephyr/gfx/Culling.hpp>
+#include <zephyr/scene/Bvh.hpp>
 #include <zephyr/effects/DayNightCycle.hpp>
 #include <zephyr/effects/CameraMotionBlur.hpp>
 
@@ -42,6 +44,9 @@ public:
 
     MainController(Root& root);
 
+    /** Reports the frame arena high-water mark */
+    ~MainController();
+
     void update() override;
 
 private:
@@ -51,6 +56,7 @@ private:
     void initMainTask();
     void setCameraPosition();
     void submitGeometry();
+    void reportStats(double time);
 
     Root& root;
 
@@ -73,6 +79,19 @@ private:
     std::unique_ptr<CameraMotionBlur> cameraBlur;
     std::unique_ptr<DayNightCycle> dayNightCycle;
 
+    /** Bounds of the landscape items, item index as the value */
+    scene::Bvh bvh;
+    std::vector<scene::ProxyId> proxies;
+    std::vector<std::uint32_t> visible;
+    gfx::CullStats cullStats;
+
+    /** Number of nodes per job of the parallel transform update */
+    std::size_t transformGrain;
+
+    /** Seconds between the statistics reports, 0 disables them */
+    double statsInterval;
+    double lastStats;
+
 };
 
 } /* namespace demo */
@@ -19,7 +19,7 @@ PipelineController::PipelineController(Renderer& renderer)
 
 void PipelineController::handle(const Message& message) {
     if (message.type == events::KEYBOARD_EVENT) {
-        KeyEvent e = util::any_cast<KeyEvent>(message.data);
+        KeyEvent e = message.data.get<KeyEvent>();
         if (e.type == KeyEvent::Type::DOWN) {
             keyDown(e);
         }
@@ -9,7 +9,7 @@
 #include <zephyr/input/InputState.hpp>
 #include <zephyr/core/Message.hpp>
 #include <zephyr/input/KeyEvent.hpp>
-#include <zephyr/util/Any.hpp>
+#include <zephyr/util/Payload.hpp>
 
 
 using zephyr::gfx::Renderer;
@@ -3,21 +3,60 @@
  */
 
 #include <zephyr/effects/CameraMotionBlur.hpp>
+#include <functional>
 
 namespace zephyr {
 namespace effects {
 
-CameraMotionBlur::CameraMotionBlur(Renderer& renderer)
+namespace {
+
+using gfx::UniformName;
+
+constexpr UniformName BLUR_STRENGTH { "blurStrength" };
+constexpr UniformName BLUR_ACTIVE { "blurActive" };
+constexpr UniformName BLUR_DIR { "blurDir" };
+constexpr UniformName RENDERED_TEXTURE { "renderedTexture" };
+
+} /* namespace */
+
+CameraMotionBlur::CameraMotionBlur(Renderer& renderer,
+        ResourceSystem& resources)
 : renderer(renderer)
+, program { resources.program("motion-blur") }
 {
-    renderer.uniforms().set1f("blurStrength", 0);
-    renderer.uniforms().set1i("blurActive", false);
+    renderer.uniforms().set1f(BLUR_STRENGTH, 0);
+    renderer.uniforms().set1i(BLUR_ACTIVE, false);
+
+    using namespace std::placeholders;
+    renderer.addPasses(std::bind(&CameraMotionBlur::addPasses, this, _1, _2));
+}
+
+Renderer::FrameTargets CameraMotionBlur::addPasses(gfx::RenderGraph& graph,
+        Renderer::FrameTargets targets) {
+    using gfx::RenderGraph;
+    // same format as the scene color it replaces
+    gfx::ResourceId blurred = graph.create("motion-blur",
+            renderer.gbufferLayout().colors[0].format);
+
+    graph.addPass("motion-blur", [&](RenderGraph::PassBuilder& pass) {
+        pass.read(targets.color);
+        pass.write(blurred);
+    }, [this, targets, blurred](const RenderGraph::PassContext& ctx) {
+        int width, height;
+        ctx.size(blurred, width, height);
+        renderer.bindTargets({ ctx.target(blurred) }, width, height);
+        renderer.drawScreenQuad(program, {
+            { RENDERED_TEXTURE, ctx.target(targets.color) }
+        });
+    });
+    targets.color = blurred;
+    return targets;
 }
 
 void CameraMotionBlur::handle(const Message& message) {
     using namespace zephyr::input;
     if (message.type == events::CURSOR_EVENT) {
-        Position pos = util::any_cast<Position>(message.data);
+        Position pos = message.data.get<Position>();
         float dx =   pos.x - input.mouse().x;
         float dy = -(pos.y - input.mouse().y);
 
@@ -60,9 +99,10 @@ void CameraMotionBlur::updateUniforms(glm::vec2 blur) {
         active = false;
         strength = 0.0f;
     }
-    renderer.uniforms().set1f("blurStrength", strength);
-    renderer.uniforms().set2f("blurDir", dir);
-    renderer.uniforms().set1i("blurActive", active);
+    gfx::CommandRecorder commands = renderer.commands();
+    commands.set1f(BLUR_STRENGTH, strength);
+    commands.set2f(BLUR_DIR, dir);
+    commands.set1i(BLUR_ACTIVE, active);
 }
 
 
@@ -9,20 +9,26 @@
 #include <zephyr/input/InputState.hpp>
 #include <zephyr/input/KeyEvent.hpp>
 #include <zephyr/gfx/Renderer.hpp>
+#include <zephyr/resources/ResourceSystem.hpp>
 #include <array>
 
 using zephyr::core::Message;
 using zephyr::gfx::Renderer;
+using zephyr::resources::ResourceSystem;
 using zephyr::input::InputState;
 namespace events = zephyr::input::msg;
 
 namespace zephyr {
 namespace effects {
 
+/**
+ * Blurs the rendered scene in the direction of the camera movement, in a pass
+ * of the render graph replacing the color target.
+ */
 class CameraMotionBlur {
 public:
 
-    CameraMotionBlur(Renderer& renderer);
+    CameraMotionBlur(Renderer& renderer, ResourceSystem& resources);
 
     void handle(const Message& message);
 
@@ -31,8 +37,12 @@ public:
 private:
     void updateUniforms(glm::vec2 blur);
 
+    Renderer::FrameTargets addPasses(gfx::RenderGraph& graph,
+            Renderer::FrameTargets targets);
+
     InputState input;
     Renderer& renderer;
+    gfx::ProgramPtr program;
 
     bool active = false;
     glm::vec2 prevDelta;
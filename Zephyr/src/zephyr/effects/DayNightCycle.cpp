@@ -10,6 +10,7 @@ namespace zephyr {
 namespace effects {
 
 
+
 void DayNightCycle::apply(double time) {
     double t = time / dayLength;
     float theta = 2 * M_PI * t;
@@ -35,12 +36,13 @@ void DayNightCycle::apply(double time) {
 //        sunCol.g = sunCol.b = 0;// 1 - d;
 //    }
 
-    uniforms.set1f("timeOfDay", t);
-    uniforms.set3f("sunDirection", sunDirection);
-    uniforms.set1f("sunIntensity", sunIntensity);
-    uniforms.set3f("ambient", ambientVal * ambient);
-    uniforms.set3f("sunColor", sunCol);
-    uniforms.set1f("hdrMax", hdr);
+    gfx::FrameGlobals& globals = renderer.frameGlobals();
+    globals.timeOfDay = t;
+    globals.sunDirection = sunDirection;
+    globals.sunIntensity = sunIntensity;
+    globals.ambient = ambientVal * ambient;
+    globals.sunColor = sunCol;
+    globals.hdrMax = hdr;
 }
 
 
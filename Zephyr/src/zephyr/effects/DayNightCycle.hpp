@@ -10,7 +10,6 @@
 
 using zephyr::core::Register;
 using zephyr::gfx::Renderer;
-using zephyr::gfx::UniformManager;
 
 namespace zephyr {
 namespace effects {
@@ -24,7 +23,6 @@ public:
     : root(root)
     , vars(root.vars())
     , renderer(root.graphics().renderer())
-    , uniforms(renderer.uniforms())
     , sunIntensity { 1 }
     , ambient { 0.1f, 0.1f, 0.1f }
     {
@@ -46,7 +44,6 @@ private:
     Root& root;
     Register& vars;
     Renderer& renderer;
-    UniformManager& uniforms;
 
     glm::vec3 sunDirection;
     float sunIntensity;
@@ -33,7 +33,7 @@ public:
     , texture(vertexCount)
     { }
 
-    MeshPtr create() {
+    Mesh create() {
         generateVertices();
         generateIndices();
 
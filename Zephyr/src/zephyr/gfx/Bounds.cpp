@@ -0,0 +1,69 @@
+/**
+ * @file Bounds.cpp
+ */
+
+#include <zephyr/gfx/Bounds.hpp>
+#include <algorithm>
+#include <cmath>
+
+
+namespace zephyr {
+namespace gfx {
+
+Bounds computeBounds(const float* positions, std::size_t count,
+        std::size_t stride) {
+    Bounds bounds;
+    if (count == 0) {
+        return bounds;
+    }
+    BoundingBox& box = bounds.box;
+    for (int i = 0; i < 3; ++ i) {
+        box.min[i] = box.max[i] = positions[i];
+    }
+    for (std::size_t n = 1; n < count; ++ n) {
+        const float* p = positions + n * stride;
+        for (int i = 0; i < 3; ++ i) {
+            box.min[i] = std::min(box.min[i], p[i]);
+            box.max[i] = std::max(box.max[i], p[i]);
+        }
+    }
+    // centered at the box, tighter than the box's circumsphere
+    BoundingSphere& sphere = bounds.sphere;
+    for (int i = 0; i < 3; ++ i) {
+        sphere.center[i] = box.center(i);
+    }
+    float r2 = 0;
+    for (std::size_t n = 0; n < count; ++ n) {
+        const float* p = positions + n * stride;
+        float d2 = 0;
+        for (int i = 0; i < 3; ++ i) {
+            float d = p[i] - sphere.center[i];
+            d2 += d * d;
+        }
+        r2 = std::max(r2, d2);
+    }
+    sphere.radius = std::sqrt(r2);
+    return bounds;
+}
+
+BoundingBox transformBox(const BoundingBox& box, const float* m) {
+    BoundingBox result;
+    if (box.empty()) {
+        return result;
+    }
+    for (int i = 0; i < 3; ++ i) {
+        float c = m[12 + i];
+        float e = 0;
+        for (int j = 0; j < 3; ++ j) {
+            float a = m[4 * j + i];
+            c += a * box.center(j);
+            e += std::abs(a) * box.extent(j);
+        }
+        result.min[i] = c - e;
+        result.max[i] = c + e;
+    }
+    return result;
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
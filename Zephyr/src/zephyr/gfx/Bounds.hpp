@@ -0,0 +1,66 @@
+/**
+ * @file Bounds.hpp
+ */
+
+#ifndef ZEPHYR_GFX_BOUNDS_HPP_
+#define ZEPHYR_GFX_BOUNDS_HPP_
+
+#include <cstddef>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * Axis-aligned bounding box. Default-constructed box is empty, which means
+ * the bounds are unknown.
+ */
+struct BoundingBox {
+    float min[3] = { 1, 1, 1 };
+    float max[3] = { -1, -1, -1 };
+
+    bool empty() const {
+        return min[0] > max[0] || min[1] > max[1] || min[2] > max[2];
+    }
+
+    float center(int i) const {
+        return 0.5f * (min[i] + max[i]);
+    }
+
+    float extent(int i) const {
+        return 0.5f * (max[i] - min[i]);
+    }
+};
+
+struct BoundingSphere {
+    float center[3] = { 0, 0, 0 };
+    float radius = -1;
+};
+
+/** Bounding volumes of the mesh, in model space */
+struct Bounds {
+    BoundingBox box;
+    BoundingSphere sphere;
+};
+
+/**
+ * Computes bounds of the points.
+ *
+ * @param positions Coordinates of the first point
+ * @param count Number of points
+ * @param stride Distance between consecutive points, in floats
+ */
+Bounds computeBounds(const float* positions, std::size_t count,
+        std::size_t stride = 3);
+
+/**
+ * Computes box bounding the box transformed by the affine transformation.
+ *
+ * @param matrix Column-major 4x4 matrix
+ */
+BoundingBox transformBox(const BoundingBox& box, const float* matrix);
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_BOUNDS_HPP_ */
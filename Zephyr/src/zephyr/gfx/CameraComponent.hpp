@@ -19,13 +19,6 @@ using core::Task;
 class CameraComponent: public Task {
 public:
 
-    /**
-     * Name of the uniform block used to store matrices containing camera
-     * matrices
-     */
-    static constexpr char BLOCK_NAME[] = "CameraMatrices";
-
-
     CameraComponent(Renderer& renderer, std::shared_ptr<Camera> camera);
 
 
@@ -41,7 +34,6 @@ private:
 
     std::shared_ptr<Camera> camera_;
     Renderer& renderer_;
-    UniformManager& uniforms_;
     Viewport& viewport_;
 };
 
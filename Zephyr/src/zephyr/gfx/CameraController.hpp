@@ -97,7 +97,7 @@ private:
     }
 
     void onScroll(const Message& message) {
-        float scroll = util::any_cast<double>(message.data);
+        float scroll = message.data.get<double>();
         if (input[Key::LEFT_SHIFT]) {
             Projection proj = camera->projection();
             proj.fov -= scroll;
@@ -113,7 +113,7 @@ private:
         const float sensitivity = 0.5f;
         const float moveScale = 0.3f;
         const float rotScale = 1.0f;
-        Position pos = util::any_cast<Position>(message.data);
+        Position pos = message.data.get<Position>();
         float dx = sensitivity * (pos.x - input.mouse().x);
         float dy = -sensitivity * (pos.y - input.mouse().y);
         if (input[Button::RIGHT]) {
@@ -132,12 +132,12 @@ private:
     }
 
     void onButton(const Message& message) {
-        ButtonEvent e = util::any_cast<ButtonEvent>(message.data);
+        ButtonEvent e = message.data.get<ButtonEvent>();
         input[e.button] = (e.type == ButtonEvent::Type::DOWN);
     }
 
     void onKey(const Message& message) {
-        KeyEvent e = util::any_cast<KeyEvent>(message.data);
+        KeyEvent e = message.data.get<KeyEvent>();
         if (e.type == KeyEvent::Type::DOWN) {
             input[e.key] = true;
 
@@ -0,0 +1,47 @@
+/**
+ * @file CommandBuffer.cpp
+ */
+
+#include <zephyr/gfx/CommandBuffer.hpp>
+#include <zephyr/util/make_unique.hpp>
+
+namespace zephyr {
+namespace gfx {
+
+void CommandBuffer::push(std::uint32_t type, const void* data,
+        std::uint32_t size) {
+    Header header { type, size };
+    std::size_t pos = data_.size();
+    data_.resize(pos + sizeof header + padded(size));
+    std::memcpy(&data_[pos], &header, sizeof header);
+    std::memcpy(&data_[pos + sizeof header], data, size);
+    ++ count_;
+}
+
+
+CommandBuffer& CommandQueue::local() {
+    std::lock_guard<std::mutex> lock { mutex_ };
+    Slot*& slot = threads_[std::this_thread::get_id()];
+    if (!slot) {
+        slots_.push_back(util::make_unique<Slot>());
+        slot = slots_.back().get();
+    }
+    return slot->buffers[recording_];
+}
+
+void CommandQueue::swap() {
+    std::lock_guard<std::mutex> lock { mutex_ };
+    unsigned replayed = recording_;
+    recording_ = 1 - recording_;
+
+    replay_.clear();
+    for (const auto& slot : slots_) {
+        slot->buffers[recording_].clear();
+        if (!slot->buffers[replayed].empty()) {
+            replay_.push_back(&slot->buffers[replayed]);
+        }
+    }
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,174 @@
+/**
+ * @file CommandBuffer.hpp
+ */
+
+#ifndef ZEPHYR_GFX_COMMANDBUFFER_HPP_
+#define ZEPHYR_GFX_COMMANDBUFFER_HPP_
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * Linear buffer of command packets. Packet is a trivially copyable structure
+ * with a static @c TYPE member identifying it, stored by value one after
+ * another. Buffer does not interpret the packets, it only keeps them in the
+ * recording order. Memory is retained across @ref clear(), so after a few
+ * frames recording does not allocate.
+ */
+class CommandBuffer {
+public:
+
+    /**
+     * Appends the packet to the buffer.
+     */
+    template <typename Packet>
+    void push(const Packet& packet) {
+        push(Packet::TYPE, &packet, sizeof packet);
+    }
+
+    /**
+     * Appends raw packet data of specified type.
+     */
+    void push(std::uint32_t type, const void* data, std::uint32_t size);
+
+    /**
+     * Invokes @c fun(type, data) for each packet, in the recording order.
+     * Data pointer is not suitably aligned for the packet type, use
+     * @ref read() to get the packet.
+     */
+    template <typename Fun>
+    void forEach(Fun&& fun) const {
+        std::size_t pos = 0;
+        while (pos < data_.size()) {
+            Header header;
+            std::memcpy(&header, &data_[pos], sizeof header);
+            fun(header.type, &data_[pos + sizeof header]);
+            pos += sizeof header + padded(header.size);
+        }
+    }
+
+    /**
+     * Copies the packet out of the buffer.
+     */
+    template <typename Packet>
+    static Packet read(const void* data) {
+        // packets need not be default constructible
+        typename std::aligned_storage<sizeof(Packet), alignof(Packet)>::type
+            storage;
+        std::memcpy(&storage, data, sizeof(Packet));
+        return *reinterpret_cast<const Packet*>(&storage);
+    }
+
+    void clear() {
+        data_.clear();
+        count_ = 0;
+    }
+
+    /** Number of packets in the buffer */
+    std::size_t size() const {
+        return count_;
+    }
+
+    bool empty() const {
+        return count_ == 0;
+    }
+
+    /** Number of bytes used by the packets */
+    std::size_t bytes() const {
+        return data_.size();
+    }
+
+private:
+    struct Header {
+        std::uint32_t type;
+        std::uint32_t size;
+    };
+
+    static std::size_t padded(std::size_t size) {
+        return (size + sizeof(Header) - 1) / sizeof(Header) * sizeof(Header);
+    }
+
+    std::vector<char> data_;
+    std::size_t count_ = 0;
+};
+
+
+/**
+ * Set of per-thread command buffers, double buffered. Any number of threads
+ * record commands for the next frame into their own buffers, while the
+ * buffers of the previous frame are replayed. Nothing is shared between the
+ * recording threads except for the lookup of the buffer itself.
+ *
+ * @ref swap() needs to be ordered with respect to all the recording and
+ * replaying, it is the only point of synchronization between them.
+ */
+class CommandQueue {
+public:
+
+    /**
+     * @return Buffer the calling thread records into. Lookup takes a lock,
+     *         so the reference should be obtained once per batch of commands.
+     *         It stays valid until the next @ref swap().
+     */
+    CommandBuffer& local();
+
+    /**
+     * Makes the recorded commands available for replay, and starts recording
+     * the next frame into empty buffers.
+     */
+    void swap();
+
+    /**
+     * Invokes @c fun(type, data) for each packet recorded before the last
+     * @ref swap(). Buffers are visited in order of the first use by their
+     * threads, packets of each buffer in the recording order.
+     */
+    template <typename Fun>
+    void replay(Fun&& fun) const {
+        for (const CommandBuffer* buffer : replay_) {
+            buffer->forEach(fun);
+        }
+    }
+
+    /** Number of packets to replay */
+    std::size_t size() const {
+        std::size_t count = 0;
+        for (const CommandBuffer* buffer : replay_) {
+            count += buffer->size();
+        }
+        return count;
+    }
+
+private:
+    /** Buffers of single thread, for both frames */
+    struct Slot {
+        CommandBuffer buffers[2];
+    };
+
+    std::mutex mutex_;
+
+    std::vector<std::unique_ptr<Slot>> slots_;
+
+    std::unordered_map<std::thread::id, Slot*> threads_;
+
+    /** Index of the buffer being recorded into in each slot */
+    unsigned recording_ = 0;
+
+    /** Buffers with the commands to replay, snapshot taken on swap */
+    std::vector<const CommandBuffer*> replay_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_COMMANDBUFFER_HPP_ */
@@ -0,0 +1,191 @@
+/**
+ * @file Culling.cpp
+ */
+
+#include <zephyr/gfx/Culling.hpp>
+#include <cmath>
+#include <ostream>
+
+#if defined(__AVX__)
+#   include <immintrin.h>
+#elif defined(__SSE__)
+#   include <xmmintrin.h>
+#endif
+
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+/** Extent of boxes that are never culled */
+constexpr float UNBOUNDED = 1e30f;
+
+} /* namespace */
+
+
+Frustum Frustum::fromMatrix(const float* m) {
+    // rows of the matrix
+    auto row = [m](int i, int j) { return m[4 * j + i]; };
+    const int axes[6] = { 0, 0, 1, 1, 2, 2 };
+
+    Frustum frustum;
+    for (int p = 0; p < 6; ++ p) {
+        float sign = (p % 2 == 0) ? 1 : -1;
+        float* plane = frustum.planes[p];
+        for (int j = 0; j < 4; ++ j) {
+            plane[j] = row(3, j) + sign * row(axes[p], j);
+        }
+        float len = std::sqrt(plane[0] * plane[0] + plane[1] * plane[1]
+                + plane[2] * plane[2]);
+        for (int j = 0; j < 4; ++ j) {
+            plane[j] /= len;
+        }
+    }
+    return frustum;
+}
+
+
+std::ostream& operator << (std::ostream& os, const CullStats& stats) {
+    return os << "tested: " << stats.tested << ", visible: " << stats.visible
+            << ", culled: " << stats.culled;
+}
+
+
+void FrustumCuller::clear() {
+    for (auto* v : { &cx_, &cy_, &cz_, &ex_, &ey_, &ez_ }) {
+        v->clear();
+    }
+    count_ = 0;
+}
+
+void FrustumCuller::reserve(std::size_t count) {
+    for (auto* v : { &cx_, &cy_, &cz_, &ex_, &ey_, &ez_ }) {
+        v->reserve(count);
+    }
+    visible_.reserve(count);
+}
+
+std::uint32_t FrustumCuller::add(const BoundingBox& box) {
+    if (box.empty()) {
+        cx_.push_back(0);
+        cy_.push_back(0);
+        cz_.push_back(0);
+        ex_.push_back(UNBOUNDED);
+        ey_.push_back(UNBOUNDED);
+        ez_.push_back(UNBOUNDED);
+    } else {
+        cx_.push_back(box.center(0));
+        cy_.push_back(box.center(1));
+        cz_.push_back(box.center(2));
+        ex_.push_back(box.extent(0));
+        ey_.push_back(box.extent(1));
+        ez_.push_back(box.extent(2));
+    }
+    return count_ ++;
+}
+
+std::size_t FrustumCuller::batchWidth() {
+#if defined(__AVX__)
+    return 8;
+#elif defined(__SSE__)
+    return 4;
+#else
+    return 1;
+#endif
+}
+
+const std::vector<std::uint32_t>& FrustumCuller::cull(const Frustum& frustum) {
+    visible_.clear();
+    std::size_t i = 0;
+
+#if defined(__AVX__)
+    for (; i + 8 <= count_; i += 8) {
+        __m256 cx = _mm256_loadu_ps(&cx_[i]);
+        __m256 cy = _mm256_loadu_ps(&cy_[i]);
+        __m256 cz = _mm256_loadu_ps(&cz_[i]);
+        __m256 ex = _mm256_loadu_ps(&ex_[i]);
+        __m256 ey = _mm256_loadu_ps(&ey_[i]);
+        __m256 ez = _mm256_loadu_ps(&ez_[i]);
+        __m256 outside = _mm256_setzero_ps();
+
+        for (const float* p : frustum.planes) {
+            __m256 a = _mm256_set1_ps(p[0]);
+            __m256 b = _mm256_set1_ps(p[1]);
+            __m256 c = _mm256_set1_ps(p[2]);
+            __m256 dist = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, cx),
+                    _mm256_mul_ps(b, cy)), _mm256_add_ps(_mm256_mul_ps(c, cz),
+                    _mm256_set1_ps(p[3])));
+            __m256 radius = _mm256_add_ps(_mm256_add_ps(
+                    _mm256_mul_ps(_mm256_set1_ps(std::abs(p[0])), ex),
+                    _mm256_mul_ps(_mm256_set1_ps(std::abs(p[1])), ey)),
+                    _mm256_mul_ps(_mm256_set1_ps(std::abs(p[2])), ez));
+            __m256 out = _mm256_cmp_ps(_mm256_add_ps(dist, radius),
+                    _mm256_setzero_ps(), _CMP_LT_OQ);
+            outside = _mm256_or_ps(outside, out);
+        }
+        int mask = _mm256_movemask_ps(outside);
+        for (int k = 0; k < 8; ++ k) {
+            if (!(mask & (1 << k))) {
+                visible_.push_back(i + k);
+            }
+        }
+    }
+#elif defined(__SSE__)
+    for (; i + 4 <= count_; i += 4) {
+        __m128 cx = _mm_loadu_ps(&cx_[i]);
+        __m128 cy = _mm_loadu_ps(&cy_[i]);
+        __m128 cz = _mm_loadu_ps(&cz_[i]);
+        __m128 ex = _mm_loadu_ps(&ex_[i]);
+        __m128 ey = _mm_loadu_ps(&ey_[i]);
+        __m128 ez = _mm_loadu_ps(&ez_[i]);
+        __m128 outside = _mm_setzero_ps();
+
+        for (const float* p : frustum.planes) {
+            __m128 a = _mm_set1_ps(p[0]);
+            __m128 b = _mm_set1_ps(p[1]);
+            __m128 c = _mm_set1_ps(p[2]);
+            __m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(a, cx),
+                    _mm_mul_ps(b, cy)), _mm_add_ps(_mm_mul_ps(c, cz),
+                    _mm_set1_ps(p[3])));
+            __m128 radius = _mm_add_ps(_mm_add_ps(
+                    _mm_mul_ps(_mm_set1_ps(std::abs(p[0])), ex),
+                    _mm_mul_ps(_mm_set1_ps(std::abs(p[1])), ey)),
+                    _mm_mul_ps(_mm_set1_ps(std::abs(p[2])), ez));
+            __m128 out = _mm_cmplt_ps(_mm_add_ps(dist, radius),
+                    _mm_setzero_ps());
+            outside = _mm_or_ps(outside, out);
+        }
+        int mask = _mm_movemask_ps(outside);
+        for (int k = 0; k < 4; ++ k) {
+            if (!(mask & (1 << k))) {
+                visible_.push_back(i + k);
+            }
+        }
+    }
+#endif
+    cullScalar(frustum, i);
+
+    stats_.tested = count_;
+    stats_.visible = visible_.size();
+    stats_.culled = count_ - visible_.size();
+    return visible_;
+}
+
+void FrustumCuller::cullScalar(const Frustum& frustum, std::size_t first) {
+    for (std::size_t i = first; i < count_; ++ i) {
+        bool outside = false;
+        for (const float* p : frustum.planes) {
+            float dist = p[0] * cx_[i] + p[1] * cy_[i] + p[2] * cz_[i] + p[3];
+            float radius = std::abs(p[0]) * ex_[i] + std::abs(p[1]) * ey_[i]
+                    + std::abs(p[2]) * ez_[i];
+            outside = outside || dist + radius < 0;
+        }
+        if (!outside) {
+            visible_.push_back(i);
+        }
+    }
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
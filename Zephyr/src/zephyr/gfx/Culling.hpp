@@ -0,0 +1,100 @@
+/**
+ * @file Culling.hpp
+ */
+
+#ifndef ZEPHYR_GFX_CULLING_HPP_
+#define ZEPHYR_GFX_CULLING_HPP_
+
+#include <zephyr/gfx/Bounds.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * View frustum as 6 planes (left, right, bottom, top, near, far) with
+ * normals pointing inside. Plane (a, b, c, d) contains points p with
+ * a p.x + b p.y + c p.z + d = 0.
+ */
+struct Frustum {
+    float planes[6][4];
+
+    /**
+     * Extracts the planes from the view-projection matrix.
+     *
+     * @param matrix Column-major 4x4 matrix
+     */
+    static Frustum fromMatrix(const float* matrix);
+};
+
+
+struct CullStats {
+    std::size_t tested = 0;
+    std::size_t visible = 0;
+    std::size_t culled = 0;
+};
+
+std::ostream& operator << (std::ostream& os, const CullStats& stats);
+
+
+/**
+ * Tests world-space bounding boxes against the frustum. Boxes are stored
+ * as centers and extents in separate arrays (SoA), and tested in batches
+ * of 8 with AVX, or 4 with SSE, depending on the target instruction set.
+ * Box is culled if it lies entirely outside one of the planes.
+ */
+class FrustumCuller {
+public:
+
+    /** Removes all the boxes */
+    void clear();
+
+    void reserve(std::size_t count);
+
+    /**
+     * Adds the box to be tested. Empty box (unknown bounds) is always
+     * visible.
+     *
+     * @return Index of the box
+     */
+    std::uint32_t add(const BoundingBox& box);
+
+    /** Number of boxes */
+    std::size_t size() const {
+        return count_;
+    }
+
+    /**
+     * @return Indices of the boxes intersecting the frustum, in increasing
+     *         order
+     */
+    const std::vector<std::uint32_t>& cull(const Frustum& frustum);
+
+    /** Counters of the last @ref cull() */
+    const CullStats& stats() const {
+        return stats_;
+    }
+
+    /** Width of the batches tested at once */
+    static std::size_t batchWidth();
+
+private:
+    void cullScalar(const Frustum& frustum, std::size_t first);
+
+    // centers and extents of the boxes
+    std::vector<float> cx_, cy_, cz_;
+    std::vector<float> ex_, ey_, ez_;
+    std::size_t count_ = 0;
+
+    std::vector<std::uint32_t> visible_;
+    CullStats stats_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_CULLING_HPP_ */
@@ -32,25 +32,26 @@ public:
 
     void init() {
         mat = resources.material("debug");
-        cube = makeCube();
+        cube = resources.addMesh("debug-cube", makeCube());
+        box = resources.addEntity("debug-box", mat, cube);
     }
 
+    /**
+     * Draws the box in the next frame. May be called from any thread.
+     */
     void addBox(const glm::mat4& pos) {
-        items.push_back({ newEntity(mat, cube), pos });
+        renderer.commands().draw(box, pos);
     }
 
 
     void update() override {
-        for (const Renderable& item : items) {
-            renderer.submit(item);
-        }
-        items.clear();
+        // boxes are recorded directly as the renderer commands
     }
 
 
 private:
 
-    MeshPtr makeCube() const {
+    Mesh makeCube() const {
         std::vector<glm::vec4> vertices = makeBoxVertices(1);
         std::vector<std::uint16_t> indices = makeBoxLinesIndices<std::uint16_t>();
 //        std::tie(vertices, indices) = makeBox<std::uint16_t>(1);
@@ -70,10 +71,10 @@ private:
     Renderer& renderer;
     ResourceSystem& resources;
 
-    std::vector<Renderable> items;
-    MeshPtr cube;
+    MeshHandle cube;
+    EntityHandle box;
 
-    MaterialPtr mat;
+    MaterialHandle mat;
 };
 
 
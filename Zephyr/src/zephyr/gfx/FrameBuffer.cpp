@@ -9,46 +9,106 @@
 namespace zephyr {
 namespace gfx {
 
-FrameBuffer::FrameBuffer(std::size_t targets, int width, int height)
-: targets_ { targets }
-, textures_(targets)
+namespace {
+
+/** Arguments of glTexImage2D for the format */
+struct TexImageFormat {
+    GLint internalFormat;
+    GLenum format;
+    GLenum type;
+};
+
+TexImageFormat toGL(TargetFormat format) {
+    switch (format) {
+    case TargetFormat::RGBA32F: return { GL_RGBA32F, GL_RGBA, GL_FLOAT };
+    case TargetFormat::RGBA16F: return { GL_RGBA16F, GL_RGBA, GL_FLOAT };
+    case TargetFormat::RGBA8: return { GL_RGBA8, GL_RGBA, GL_UNSIGNED_BYTE };
+    case TargetFormat::RGB10A2:
+        return { GL_RGB10_A2, GL_RGBA, GL_UNSIGNED_INT_2_10_10_10_REV };
+    case TargetFormat::R11G11B10F:
+        return { GL_R11F_G11F_B10F, GL_RGB, GL_FLOAT };
+    case TargetFormat::RG16F: return { GL_RG16F, GL_RG, GL_FLOAT };
+    case TargetFormat::R32F: return { GL_R32F, GL_RED, GL_FLOAT };
+    case TargetFormat::R16F: return { GL_R16F, GL_RED, GL_FLOAT };
+    case TargetFormat::D32F:
+        return { GL_DEPTH_COMPONENT32F, GL_DEPTH_COMPONENT, GL_FLOAT };
+    case TargetFormat::D24:
+        return { GL_DEPTH_COMPONENT24, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT };
+    case TargetFormat::D24S8:
+        return { GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL,
+            GL_UNSIGNED_INT_24_8 };
+    default:
+        throw std::runtime_error("Invalid target format");
+    }
+}
+
+} /* namespace */
+
+
+TargetId createTargetTexture(const TargetKey& key) {
+    TexImageFormat gl = toGL(key.format);
+    GLuint texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, gl.internalFormat, key.width, key.height, 0,
+            gl.format, gl.type, nullptr);
+    return texture;
+}
+
+void destroyTargetTexture(TargetId texture) {
+    glDeleteTextures(1, &texture);
+}
+
+
+FrameBuffer::FrameBuffer(const FrameBufferLayout& layout, int width,
+        int height, RenderTargetPool& pool)
+: pool_(pool)
+, layout_ { layout }
+, width_ { width }
+, height_ { height }
+, targets_ { layout.colors.size() }
+, textures_(targets_)
 {
+    layout_.validate();
+
     glGenFramebuffers(1, &frameBuffer_);
     bind();
 
-    glGenTextures(targets, textures_.data());
-
-    int i = 0;
-    for (auto tex : textures_) {
-        glBindTexture(GL_TEXTURE_2D, tex);
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, width, height, 0, GL_RGBA,
-                GL_FLOAT, nullptr);
+    for (std::size_t i = 0; i < targets_; ++ i) {
+        GLuint tex = pool_.acquire(layout_.colors[i].format, width, height);
+        textures_[i] = tex;
         glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, tex, 0);
-        ++ i;
     }
 
-//    glGenRenderbuffers(1, &depthBuffer);
-//    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer);
-//    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT32F, width, height);
-//    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, depthBuffer);
+    depthTexture_ = pool_.acquire(layout_.depth.format, width, height);
+    GLenum depthAttachment = hasStencil(layout_.depth.format)
+            ? GL_DEPTH_STENCIL_ATTACHMENT : GL_DEPTH_ATTACHMENT;
+    glFramebufferTexture(GL_FRAMEBUFFER, depthAttachment, depthTexture_, 0);
 
-    glGenTextures(1, &depthTexture_);
-    glBindTexture(GL_TEXTURE_2D, depthTexture_);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT32F, width, height, 0,
-            GL_DEPTH_COMPONENT, GL_FLOAT, nullptr);
-    glFramebufferTexture(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, depthTexture_, 0);
-
-    std::vector<GLenum> buffers(targets);
-    for (std::size_t i = 0; i < targets; ++ i) {
+    std::vector<GLenum> buffers(targets_);
+    for (std::size_t i = 0; i < targets_; ++ i) {
         buffers[i] = GL_COLOR_ATTACHMENT0 + i;
     }
 
     glDrawBuffers(buffers.size(), buffers.data());
     GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    unbind();
     if (status != GL_FRAMEBUFFER_COMPLETE) {
+        releaseTargets();
         throw std::runtime_error("Error while creating GBuffer");
     }
-    unbind();
+}
+
+FrameBuffer::~FrameBuffer() {
+    releaseTargets();
+}
+
+void FrameBuffer::releaseTargets() {
+    glDeleteFramebuffers(1, &frameBuffer_);
+    for (GLuint tex : textures_) {
+        pool_.release(tex);
+    }
+    pool_.release(depthTexture_);
 }
 
 void FrameBuffer::bind() {
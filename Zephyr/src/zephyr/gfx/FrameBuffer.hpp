@@ -2,20 +2,50 @@
  * @file FrameBuffer.hpp
  */
 
-#ifndef ZEPHYR_GFX_GBUFFER_HPP_
+#ifndef ZEPHYR_GFX_FRAMEBUFFER_HPP_
 #define ZEPHYR_GFX_FRAMEBUFFER_HPP_
 
 #include <GL/glew.h>
 #include <GL/gl.h>
+#include <zephyr/gfx/TargetFormat.hpp>
+#include <zephyr/gfx/RenderTargetPool.hpp>
 #include <vector>
 
 
 namespace zephyr {
 namespace gfx {
 
+/**
+ * Allocates texture suitable for render target of given format and size.
+ * Used to create textures of @ref RenderTargetPool.
+ */
+TargetId createTargetTexture(const TargetKey& key);
+
+/**
+ * Deletes texture created by @ref createTargetTexture().
+ */
+void destroyTargetTexture(TargetId texture);
+
+
+/**
+ * Framebuffer object with attachments taken from the render target pool.
+ * Attachments are returned to the pool when the framebuffer is destroyed.
+ */
 class FrameBuffer {
 public:
-    FrameBuffer(std::size_t targets, int width, int height);
+    /**
+     * Creates framebuffer with attachments of specified formats.
+     *
+     * @throws std::runtime_error if the layout is invalid, or the
+     *         framebuffer is incomplete
+     */
+    FrameBuffer(const FrameBufferLayout& layout, int width, int height,
+            RenderTargetPool& pool);
+
+    FrameBuffer(const FrameBuffer&) = delete;
+    FrameBuffer& operator = (const FrameBuffer&) = delete;
+
+    ~FrameBuffer();
 
     GLuint frameBuffer() const {
         return frameBuffer_;
@@ -41,7 +71,32 @@ public:
         return targets_;
     }
 
+    const FrameBufferLayout& layout() const {
+        return layout_;
+    }
+
+    int width() const {
+        return width_;
+    }
+
+    int height() const {
+        return height_;
+    }
+
+    /** Memory taken by the attachments, in bytes */
+    std::size_t bytes() const {
+        return layout_.bytes(width_, height_);
+    }
+
 private:
+    void releaseTargets();
+
+    RenderTargetPool& pool_;
+
+    FrameBufferLayout layout_;
+    int width_;
+    int height_;
+
     std::size_t targets_;
 
     GLuint frameBuffer_;
@@ -0,0 +1,102 @@
+/**
+ * @file FrameGlobals.hpp
+ */
+
+#ifndef ZEPHYR_GFX_FRAMEGLOBALS_HPP_
+#define ZEPHYR_GFX_FRAMEGLOBALS_HPP_
+
+#include <glm/glm.hpp>
+#include <cstddef>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * Values constant during the frame, shared by all the programs. Layout
+ * matches the std140 @c FrameGlobals uniform block declared by the shaders:
+ *
+ *     layout (std140) uniform FrameGlobals {
+ *         mat4 viewMatrix;
+ *         mat4 projectionMatrix;
+ *         vec3 sunDirection;
+ *         float sunIntensity;
+ *         vec3 sunColor;
+ *         float timeOfDay;
+ *         vec3 ambient;
+ *         float hdrMax;
+ *         vec3 lightPos;
+ *         vec3 lightAt;
+ *     };
+ */
+struct FrameGlobals {
+
+    /** Name of the uniform block */
+    static constexpr const char* BLOCK_NAME = "FrameGlobals";
+
+    glm::mat4 viewMatrix;
+    glm::mat4 projectionMatrix;
+
+    glm::vec3 sunDirection;
+    float sunIntensity = 1;
+
+    glm::vec3 sunColor { 1, 1, 1 };
+    float timeOfDay = 0;
+
+    glm::vec3 ambient;
+    float hdrMax = 1;
+
+    glm::vec3 lightPos;
+    float pad0_ = 0;
+
+    glm::vec3 lightAt;
+    float pad1_ = 0;
+};
+
+static_assert(sizeof(FrameGlobals) == 2 * 64 + 5 * 16,
+        "FrameGlobals does not match std140 layout");
+
+
+/**
+ * Values specific to single draw. Layout matches the std140
+ * @c ObjectTransforms uniform block:
+ *
+ *     layout (std140) uniform ObjectTransforms {
+ *         mat4 modelMatrix;
+ *     };
+ */
+struct ObjectTransforms {
+
+    /** Name of the uniform block */
+    static constexpr const char* BLOCK_NAME = "ObjectTransforms";
+
+    glm::mat4 modelMatrix;
+};
+
+
+/**
+ * Model matrices of the instances drawn by single instanced draw call. Layout
+ * matches the std140 @c InstanceTransforms uniform block, with
+ * @c MAX_INSTANCES defined to the same value:
+ *
+ *     layout (std140) uniform InstanceTransforms {
+ *         mat4 modelMatrices[MAX_INSTANCES];
+ *     };
+ *
+ * 256 matrices take 16kB, the minimal value of GL_MAX_UNIFORM_BLOCK_SIZE.
+ */
+struct InstanceTransforms {
+
+    /** Name of the uniform block */
+    static constexpr const char* BLOCK_NAME = "InstanceTransforms";
+
+    /** Maximal number of instances in one draw call */
+    static constexpr std::size_t MAX_INSTANCES = 256;
+
+    glm::mat4 modelMatrices[MAX_INSTANCES];
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_FRAMEGLOBALS_HPP_ */
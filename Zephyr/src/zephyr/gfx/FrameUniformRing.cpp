@@ -0,0 +1,131 @@
+/**
+ * @file FrameUniformRing.cpp
+ */
+
+#include <zephyr/gfx/FrameUniformRing.hpp>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace zephyr {
+namespace gfx {
+
+FrameUniformRing::FrameUniformRing(std::size_t frameSize,
+        std::size_t framesInFlight)
+: frames_ { std::max<std::size_t>(framesInFlight, 1) }
+, frameSize_ { 0 }
+, alignment_ { 16 }
+, buffer_ { 0 }
+, mapped_ { nullptr }
+, current_ { frames_ - 1 }
+, offset_ { 0 }
+, flushed_ { 0 }
+{
+    GLint alignment = 0;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+    alignment_ = std::max<std::size_t>(alignment_, alignment);
+    create(frameSize);
+}
+
+FrameUniformRing::~FrameUniformRing() {
+    destroy();
+}
+
+void FrameUniformRing::create(std::size_t frameSize) {
+    frameSize_ = stride(frameSize);
+    std::size_t total = frameSize_ * frames_;
+
+    glGenBuffers(1, &buffer_);
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+    if (GLEW_ARB_buffer_storage) {
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT
+                | GL_MAP_COHERENT_BIT;
+        glBufferStorage(GL_UNIFORM_BUFFER, total, nullptr, flags);
+        void* data = glMapBufferRange(GL_UNIFORM_BUFFER, 0, total, flags);
+        mapped_ = static_cast<char*>(data);
+        if (! mapped_) {
+            // storage is immutable, need a fresh buffer for the fallback
+            glDeleteBuffers(1, &buffer_);
+            glGenBuffers(1, &buffer_);
+            glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+        }
+    }
+    if (! mapped_) {
+        glBufferData(GL_UNIFORM_BUFFER, total, nullptr, GL_STREAM_DRAW);
+        staging_.resize(frameSize_);
+    }
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    fences_.assign(frames_, nullptr);
+}
+
+void FrameUniformRing::destroy() {
+    for (GLsync fence : fences_) {
+        if (fence) {
+            glDeleteSync(fence);
+        }
+    }
+    fences_.clear();
+    if (mapped_) {
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+        glUnmapBuffer(GL_UNIFORM_BUFFER);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+        mapped_ = nullptr;
+    }
+    glDeleteBuffers(1, &buffer_);
+    buffer_ = 0;
+}
+
+void FrameUniformRing::beginFrame(std::size_t required) {
+    current_ = (current_ + 1) % frames_;
+    offset_ = flushed_ = 0;
+
+    if (required > frameSize_) {
+        // GL keeps the old buffer alive while pending commands use it
+        destroy();
+        create(std::max(required, 2 * frameSize_));
+        current_ = 0;
+    } else if (GLsync fence = fences_[current_]) {
+        GLenum status;
+        do {
+            status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT,
+                    1000000);
+        } while (status == GL_TIMEOUT_EXPIRED);
+        glDeleteSync(fence);
+        fences_[current_] = nullptr;
+    }
+}
+
+GLintptr FrameUniformRing::write(const void* data, std::size_t size) {
+    if (offset_ + size > frameSize_) {
+        throw std::length_error("Frame uniform ring region is full");
+    }
+    std::size_t base = current_ * frameSize_;
+    char* target = mapped_ ? mapped_ + base + offset_
+                           : staging_.data() + offset_;
+    std::memcpy(target, data, size);
+
+    GLintptr position = base + offset_;
+    offset_ += stride(size);
+    return position;
+}
+
+void FrameUniformRing::flush() {
+    // coherent mapping makes the writes visible by itself
+    if (! mapped_ && offset_ > flushed_) {
+        std::size_t base = current_ * frameSize_;
+        glBindBuffer(GL_UNIFORM_BUFFER, buffer_);
+        glBufferSubData(GL_UNIFORM_BUFFER, base + flushed_,
+                offset_ - flushed_, staging_.data() + flushed_);
+        glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    }
+    flushed_ = offset_;
+}
+
+void FrameUniformRing::endFrame() {
+    if (mapped_) {
+        fences_[current_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,134 @@
+/**
+ * @file FrameUniformRing.hpp
+ */
+
+#ifndef ZEPHYR_GFX_FRAMEUNIFORMRING_HPP_
+#define ZEPHYR_GFX_FRAMEUNIFORMRING_HPP_
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <cstdint>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * Uniform buffer divided into regions, one per frame in flight. During the
+ * frame, uniform data (globals, per-object blocks) is written linearly into
+ * the current region, and draws bind sub-ranges of it. Region is reused only
+ * after the GPU is done with the frame that used it.
+ *
+ * With @c ARB_buffer_storage the buffer is mapped persistently and written
+ * directly, with fences guarding the regions. Otherwise the data is gathered
+ * in client memory and uploaded once per frame by @ref flush(), which works
+ * on any GL 3.3 implementation, including Mesa llvmpipe.
+ */
+class FrameUniformRing {
+public:
+
+    /**
+     * @param frameSize Initial size of single frame region, in bytes
+     * @param framesInFlight Number of regions
+     */
+    explicit FrameUniformRing(std::size_t frameSize = 1 << 16,
+            std::size_t framesInFlight = 3);
+
+    FrameUniformRing(const FrameUniformRing&) = delete;
+    FrameUniformRing& operator = (const FrameUniformRing&) = delete;
+
+    ~FrameUniformRing();
+
+    /**
+     * Starts writing to the next region, waiting for the GPU if it still
+     * uses it. Buffer is reallocated if the region is smaller than
+     * @c required bytes.
+     */
+    void beginFrame(std::size_t required = 0);
+
+    /**
+     * Copies the data into the current region.
+     *
+     * @return Offset of the data in the buffer, suitably aligned for binding
+     * @throws std::length_error if there is not enough space left
+     */
+    GLintptr write(const void* data, std::size_t size);
+
+    template <typename T>
+    GLintptr write(const T& value) {
+        return write(&value, sizeof value);
+    }
+
+    /**
+     * Makes the data written since the last flush visible to the GPU. Needs
+     * to be called before the draws using it.
+     */
+    void flush();
+
+    /**
+     * Marks the end of using the current region by the GPU commands.
+     */
+    void endFrame();
+
+    /**
+     * Binds range of the buffer to the indexed uniform buffer binding point.
+     */
+    void bind(GLuint index, GLintptr offset, GLsizeiptr size) const {
+        glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer_, offset, size);
+    }
+
+    /**
+     * @return Space taken in the buffer by a block of given size
+     */
+    std::size_t stride(std::size_t size) const {
+        return (size + alignment_ - 1) / alignment_ * alignment_;
+    }
+
+    GLuint buffer() const {
+        return buffer_;
+    }
+
+    std::size_t frameSize() const {
+        return frameSize_;
+    }
+
+    /** Bytes written to the current region */
+    std::size_t used() const {
+        return offset_;
+    }
+
+    bool persistent() const {
+        return mapped_ != nullptr;
+    }
+
+private:
+
+    void create(std::size_t frameSize);
+
+    void destroy();
+
+    std::size_t frames_;
+    std::size_t frameSize_;
+    std::size_t alignment_;
+
+    GLuint buffer_;
+
+    /** Persistently mapped buffer, or @c nullptr */
+    char* mapped_;
+
+    /** Client copy of the current region, without persistent mapping */
+    std::vector<char> staging_;
+
+    /** Fences of the commands using each region */
+    std::vector<GLsync> fences_;
+
+    std::size_t current_;
+    std::size_t offset_;
+    std::size_t flushed_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_FRAMEUNIFORMRING_HPP_ */
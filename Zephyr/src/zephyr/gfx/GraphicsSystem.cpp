@@ -10,6 +10,25 @@
 namespace zephyr {
 namespace gfx {
 
+constexpr char GraphicsSystem::SWAPPER_NAME[];
+constexpr char GraphicsSystem::COMMANDS[];
+
+FrameBufferLayout GraphicsSystem::gbufferLayout(const Config& config) {
+    auto format = [&config](const std::string& name, const char* def) {
+        std::string path = "zephyr.gfx.gbuffer." + name;
+        return TargetDesc {
+            name, parseTargetFormat(config.get<std::string>(path, def))
+        };
+    };
+    FrameBufferLayout layout;
+    layout.colors.push_back(format("color", "R11G11B10F"));
+    // octahedral encoding, see normals.frag
+    layout.colors.push_back(format("normal", "RG16F"));
+    layout.colors.push_back(format("specular", "RGBA8"));
+    layout.colors.push_back(format("depth-linear", "R16F"));
+    layout.depth = format("depth", "D24S8");
+    return layout;
+}
 
 
 } /* namespace gfx */
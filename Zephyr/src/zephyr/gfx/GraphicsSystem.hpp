@@ -26,19 +26,39 @@ namespace gfx {
 class GraphicsSystem {
 public:
 
+    /** Name of the task closing the recording of the frame commands */
+    static constexpr char SWAPPER_NAME[] = "renderer-swapper";
+
+    /**
+     * Resource guarding the recording side of the renderer - commands and
+     * frame globals. Tasks recording them should declare writing it; they
+     * may then run concurrently with the rendering.
+     */
+    static constexpr char COMMANDS[] = "render-commands";
+
 
     GraphicsSystem(
         Scheduler& scheduler,
-        ResourceSystem& resources
+        ResourceSystem& resources,
+        window::Surface& surface,
+        const Config& config
     )
-    : renderer_ { util::make_unique<Renderer>(resources) }
+    : renderer_ { util::make_unique<Renderer>(resources, surface,
+            gbufferLayout(config), scheduler.frameArena()) }
     , debug_ { util::make_unique<DebugDrawer>(*renderer_, resources) }
     {
+        auto swapper = core::wrapAsTask([this]() {
+            renderer_->swapCommands();
+        });
+        scheduler.startTask(SWAPPER_NAME, 500001, swapper,
+                core::TaskConstraints().writes(COMMANDS));
+
         auto invoker = core::wrapAsTask([this]() {
-            debug_->update();
             renderer_->render();
         });
-        scheduler.startTask("renderer-invoker", 500000, invoker);
+        scheduler.startTask("renderer-invoker", 500000, invoker,
+                core::TaskConstraints().onMainThread().writes("renderer")
+                    .after(SWAPPER_NAME));
 
 
         void glimgLoad();
@@ -55,6 +75,12 @@ public:
     }
 
 private:
+    /**
+     * Reads formats of the G-buffer targets from @c zephyr.gfx.gbuffer, with
+     * the compact formats as defaults.
+     */
+    static FrameBufferLayout gbufferLayout(const Config& config);
+
     std::unique_ptr<Renderer> renderer_;
 
     std::unique_ptr<DebugDrawer> debug_;
@@ -3,17 +3,19 @@
  */
 
 #include <zephyr/gfx/Mesh.hpp>
-#include <boost/lexical_cast.hpp>
+#include <zephyr/util/MappedFile.hpp>
 #include <ctime>
+#include <iostream>
 
 
 namespace zephyr {
 namespace gfx {
 
 
-MeshPtr vertexArrayFrom(const MeshData& data) {
+Mesh vertexArrayFrom(const MeshData& data) {
     MeshBuilder builder;
     builder.setBuffer(data.vertices).attribute(0, 4);
+    builder.bounds(data.vertices);
     if (!data.colors.empty()) {
         builder.setBuffer(data.colors).attribute(1, 4);
     }
@@ -35,6 +37,75 @@ MeshPtr vertexArrayFrom(const MeshData& data) {
     return builder.create();
 }
 
+Mesh vertexArrayFrom(const MeshFile& file) {
+    const MeshFileHeader& header = file.header();
+    MeshBuilder builder;
+    builder.setBuffer(file.vertices(), file.vertexBytes(), header.vertexCount);
+    for (std::uint32_t i = 0; i < header.attributeCount; ++ i) {
+        const MeshAttribute& attr = header.attributes[i];
+        builder.attribute(attr.index, attr.size, attr.offset, GL_FLOAT, false,
+                header.stride);
+    }
+    if (header.indexCount > 0) {
+        builder.setIndices(file.indices(), header.indexCount);
+    }
+    builder.bounds(header.bounds);
+    return builder.create();
+}
+
+namespace {
+
+/** Attribute array of MeshData */
+struct AttributeSource {
+    std::uint32_t index;
+    std::uint32_t size;
+    const float* data;
+};
+
+template <typename Vec>
+void addSource(std::vector<AttributeSource>& sources, std::size_t& count,
+        std::uint32_t index, const std::vector<Vec>& values) {
+    if (!values.empty()) {
+        const float* data = reinterpret_cast<const float*>(values.data());
+        sources.push_back({ index, sizeof(Vec) / sizeof(float), data });
+        count = std::min(count, values.size());
+    }
+}
+
+} /* namespace */
+
+MeshFileData meshFileFrom(const MeshData& data) {
+    // same attribute locations as vertexArrayFrom()
+    std::vector<AttributeSource> sources;
+    std::size_t count = data.vertices.size();
+    addSource(sources, count, 0, data.vertices);
+    addSource(sources, count, 1, data.colors);
+    addSource(sources, count, 2, data.normals);
+    addSource(sources, count, 3, data.uv);
+    addSource(sources, count, 4, data.tangents);
+    addSource(sources, count, 5, data.bitangents);
+
+    MeshFileData file;
+    for (const AttributeSource& source : sources) {
+        std::uint32_t offset = file.stride * sizeof(float);
+        file.attributes.push_back({ source.index, source.size, offset });
+        file.stride += source.size;
+    }
+    file.vertices.reserve(count * file.stride);
+    for (std::size_t i = 0; i < count; ++ i) {
+        for (const AttributeSource& source : sources) {
+            const float* value = source.data + i * source.size;
+            file.vertices.insert(file.vertices.end(), value, value + source.size);
+        }
+    }
+    file.indices.assign(data.indices.begin(), data.indices.end());
+    if (!data.vertices.empty()) {
+        auto positions = reinterpret_cast<const float*>(data.vertices.data());
+        file.bounds = computeBounds(positions, count, 4);
+    }
+    return file;
+}
+
 
 
 std::vector<glm::vec4> randomColors(std::size_t count) {
@@ -51,38 +122,6 @@ std::vector<glm::vec4> randomColors(std::size_t count) {
     return colors;
 }
 
-struct Vertex {
-    std::uint32_t vi;
-    std::uint32_t ni;
-    std::uint32_t ti;
-};
-
-std::uint32_t maybeRead(std::vector<std::string> words, std::size_t i) {
-    using boost::lexical_cast;
-    if (i < words.size()) {
-        return lexical_cast<std::uint32_t>(words[i]);
-    } else {
-        return 0;
-    }
-}
-
-void readVertex(std::istream& input, Vertex& vertex) {
-
-    std::vector<std::string> parts;
-    parts.reserve(3);
-
-    std::string word;
-    input >> word;
-    std::istringstream chunk(word);
-
-    while (getline(chunk, word, '/')) {
-        parts.emplace_back(move(word));
-    }
-    vertex.vi = maybeRead(parts, 0);
-    vertex.ti = maybeRead(parts, 1);
-    vertex.ni = maybeRead(parts, 2);
-}
-
 struct ObjFileContent {
     std::vector<glm::vec4> vertices;
     std::vector<glm::vec2> texCoords;
@@ -92,15 +131,12 @@ struct ObjFileContent {
 class ObjMeshLoader {
 public:
 
-    ObjMeshLoader(std::istream& input)
-    : input(input)
+    ObjMeshLoader(ObjData&& obj)
+    : obj(std::move(obj))
     { }
 
     ObjFileContent parse() {
-        std::string line;
-        while (std::getline(input, line)) {
-            processLine(line);
-        }
+        convert();
         if (! texCoords.empty()) {
             reorganizeTexCoords();
         }
@@ -114,32 +150,19 @@ public:
 
 private:
 
-    void processLine(const std::string& line) {
-        std::string type = line.substr(0, 2);
-        if (type == "v ") {
-            std::istringstream s(line.substr(2));
-            glm::vec4 v;
-            s >> v.x; s >> v.y; s >> v.z;
-            v.w = 1.0f;
-            vertices.push_back(v);
-        } else if (type == "f ") {
-            std::istringstream s(line.substr(2));
-            Vertex a, b, c;
-            readVertex(s, a);
-            readVertex(s, b);
-            readVertex(s, c);
-            indices.push_back(a.vi - 1);
-            indices.push_back(c.vi - 1);
-            indices.push_back(b.vi - 1);
-            texIndices.push_back(a.ti - 1);
-            texIndices.push_back(c.ti - 1);
-            texIndices.push_back(b.ti - 1);
-        } else if (type == "vt") {
-            std::istringstream s(line.substr(3));
-            glm::vec2 uv;
-            s >> uv.x >> uv.y;
-            texCoords.push_back(uv);
+    void convert() {
+        const std::vector<float>& pos = obj.positions;
+        vertices.reserve(obj.vertexCount());
+        for (std::size_t i = 0; i < pos.size(); i += 3) {
+            vertices.emplace_back(pos[i], pos[i + 1], pos[i + 2], 1.0f);
         }
+        const std::vector<float>& uv = obj.texCoords;
+        texCoords.reserve(uv.size() / 2);
+        for (std::size_t i = 0; i < uv.size(); i += 2) {
+            texCoords.emplace_back(uv[i], uv[i + 1]);
+        }
+        indices = std::move(obj.vertexIndices);
+        texIndices = std::move(obj.texIndices);
     }
 
     void reorganizeTexCoords() {
@@ -174,7 +197,7 @@ private:
         indices = std::move(ids);
     }
 
-    std::istream& input;
+    ObjData obj;
 
     std::vector<glm::vec4> vertices;
     std::vector<GLuint> indices;
@@ -183,14 +206,8 @@ private:
     std::vector<GLuint> texIndices;
 };
 
-MeshData loadObjData(const char* path, NormCalc strategy) {
-    std::ifstream in(path);
-    if (!in) {
-        std::ostringstream ss("Cannot open file: ");
-        ss << path;
-        throw new std::runtime_error(ss.str());
-    }
-    ObjMeshLoader loader(in);
+MeshData meshDataFrom(ObjData&& content, NormCalc strategy) {
+    ObjMeshLoader loader(std::move(content));
     ObjFileContent obj = loader.parse();
     MeshData data;
     if (strategy == NormCalc::SPLIT) {
@@ -241,9 +258,86 @@ MeshData loadObjData(const char* path, NormCalc strategy) {
 
 
 
-MeshPtr loadObjMesh(const char* path, NormCalc strategy) {
-    MeshData data = loadObjData(path, strategy);
-    return vertexArrayFrom(data);
+MeshData loadObjData(const char* path, NormCalc strategy) {
+    return meshDataFrom(loadObj(path), strategy);
+}
+
+MeshData loadObjData(const char* path, core::Jobs& jobs, NormCalc strategy) {
+    return meshDataFrom(loadObj(path, jobs), strategy);
+}
+
+std::string meshCachePath(const char* path, NormCalc strategy) {
+    const char* names[] = { "first", "avg", "split" };
+    return std::string(path) + "." + names[static_cast<int>(strategy)] + ".mesh";
+}
+
+namespace {
+
+MeshData parseSource(const util::MappedFile& source, NormCalc strategy,
+        core::Jobs* jobs) {
+    const char* begin = source.begin();
+    const char* end = source.end();
+    ObjData obj = jobs ? parseObj(begin, end, *jobs) : parseObj(begin, end);
+    return meshDataFrom(std::move(obj), strategy);
+}
+
+std::uint32_t variantOf(NormCalc strategy) {
+    return static_cast<std::uint32_t>(strategy);
+}
+
+bool exists(const std::string& path) {
+    return std::ifstream(path).good();
+}
+
+/**
+ * Uses the mesh file cache if it was built from the current contents of the
+ * OBJ file, otherwise parses the OBJ file and writes the cache.
+ */
+Mesh loadCachedObjMesh(const char* path, NormCalc strategy, core::Jobs* jobs) {
+    util::MappedFile source { path };
+    std::uint64_t hash = contentHash(source.begin(), source.end());
+    std::string cache = meshCachePath(path, strategy);
+
+    if (exists(cache)) {
+        try {
+            MeshFile file { cache };
+            if (file.matches(hash, variantOf(strategy))) {
+                return vertexArrayFrom(file);
+            }
+        } catch (const std::runtime_error& e) {
+            std::clog << "[Mesh] Warning: " << e.what() << std::endl;
+        }
+    }
+    MeshData data = parseSource(source, strategy, jobs);
+    MeshFileData content = meshFileFrom(data);
+    content.sourceHash = hash;
+    content.variant = variantOf(strategy);
+    try {
+        writeMeshFile(cache, content);
+    } catch (const std::runtime_error& e) {
+        std::clog << "[Mesh] Warning: " << e.what() << std::endl;
+        return vertexArrayFrom(data);
+    }
+    return vertexArrayFrom(MeshFile { cache });
+}
+
+} /* namespace */
+
+MeshFileData convertObjMesh(const char* path, core::Jobs& jobs,
+        NormCalc strategy) {
+    util::MappedFile source { path };
+    MeshFileData content = meshFileFrom(parseSource(source, strategy, &jobs));
+    content.sourceHash = contentHash(source.begin(), source.end());
+    content.variant = variantOf(strategy);
+    return content;
+}
+
+Mesh loadObjMesh(const char* path, NormCalc strategy) {
+    return loadCachedObjMesh(path, strategy, nullptr);
+}
+
+Mesh loadObjMesh(const char* path, core::Jobs& jobs, NormCalc strategy) {
+    return loadCachedObjMesh(path, strategy, &jobs);
 }
 
 } /* namespace gfx */
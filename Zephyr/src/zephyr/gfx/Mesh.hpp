@@ -13,6 +13,8 @@
 
 #include <zephyr/gfx/objects.h>
 #include <zephyr/gfx/MeshBuilder.hpp>
+#include <zephyr/gfx/MeshFile.hpp>
+#include <zephyr/gfx/ObjParser.hpp>
 
 #include <iterator>
 #include <random>
@@ -35,7 +37,19 @@ struct MeshData {
 };
 
 
-MeshPtr vertexArrayFrom(const MeshData& data);
+Mesh vertexArrayFrom(const MeshData& data);
+
+/**
+ * Uploads the interleaved vertex data and indices of the mesh file. Data is
+ * passed from the mapping to @c glBufferData without copying.
+ */
+Mesh vertexArrayFrom(const MeshFile& file);
+
+/**
+ * Interleaves the attributes of the mesh for the mesh file, at the same
+ * locations as @ref vertexArrayFrom(const MeshData&) uses.
+ */
+MeshFileData meshFileFrom(const MeshData& data);
 
 std::vector<glm::vec4> randomColors(std::size_t count);
 
@@ -267,7 +281,36 @@ generateNormalsSplit(
 
 MeshData loadObjData(const char* path, NormCalc strategy = NormCalc::AVG);
 
-MeshPtr loadObjMesh(const char* path, NormCalc strategy = NormCalc::AVG);
+/**
+ * Loads the mesh, parsing the file in parallel (see @ref parseObj()). Result
+ * is the same as that of the serial version.
+ */
+MeshData loadObjData(const char* path, core::Jobs& jobs,
+        NormCalc strategy = NormCalc::AVG);
+
+/**
+ * Path of the mesh file caching the OBJ file loaded with the strategy, next
+ * to the OBJ file.
+ */
+std::string meshCachePath(const char* path, NormCalc strategy);
+
+/**
+ * Loads the OBJ file and converts it to the mesh file contents, in the form
+ * @ref loadObjMesh() caches it.
+ */
+MeshFileData convertObjMesh(const char* path, core::Jobs& jobs,
+        NormCalc strategy = NormCalc::AVG);
+
+/**
+ * Loads the mesh from the mesh file cache (see @ref meshCachePath()). Cache is
+ * valid if it was built with the same strategy, from the file with the same
+ * contents - otherwise the OBJ file is parsed, and the cache is written for
+ * the next time.
+ */
+Mesh loadObjMesh(const char* path, NormCalc strategy = NormCalc::AVG);
+
+Mesh loadObjMesh(const char* path, core::Jobs& jobs,
+        NormCalc strategy = NormCalc::AVG);
 
 } /* namespace gfx */
 } /* namespace zephyr */
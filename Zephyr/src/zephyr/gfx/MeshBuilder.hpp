@@ -88,6 +88,21 @@ public:
         return *this;
     }
 
+    /**
+     * Uploads raw vertex data, e.g. interleaved attributes of a mapped mesh
+     * file.
+     *
+     * @param data Vertex data
+     * @param size Size of the data, in bytes
+     * @param count Number of vertices
+     */
+    MeshBuilder& setBuffer(const void* data, std::size_t size, GLsizei count) {
+        updateMinSize(count);
+        vertexBuffer_ = bindNewBuffer(GL_ARRAY_BUFFER);
+        glBufferData(GL_ARRAY_BUFFER, size, data, GL_STATIC_DRAW);
+        return *this;
+    }
+
     MeshBuilder& setBuffer(GLuint buffer) {
         glBindBuffer(GL_ARRAY_BUFFER, buffer);
         vertexBuffer_ = buffer;
@@ -96,16 +111,41 @@ public:
 
     template <typename IndexType>
     MeshBuilder& setIndices(const std::vector<IndexType>& indices) {
+        return setIndices(indices.data(), indices.size());
+    }
+
+    template <typename IndexType>
+    MeshBuilder& setIndices(const IndexType* indices, std::size_t count) {
         indexType_ = IndexTraits<IndexType>::gl_type;
-        indexCount_ = indices.size();
+        indexCount_ = count;
         indexBuffer_ = bindNewBuffer(GL_ELEMENT_ARRAY_BUFFER);
 
-        std::size_t size = indices.size() * sizeof(IndexType);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, &indices[0], GL_STATIC_DRAW);
+        std::size_t size = count * sizeof(IndexType);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
 
         return *this;
     }
 
+    /**
+     * Computes bounds of the mesh from the vertex positions.
+     */
+    template <typename ItemType>
+    MeshBuilder& bounds(const std::vector<ItemType>& positions) {
+        constexpr std::size_t stride = sizeof(ItemType) / sizeof(float);
+        static_assert(stride >= 3, "Positions need 3 float coordinates");
+        const float* data = reinterpret_cast<const float*>(positions.data());
+        bounds_ = computeBounds(data, positions.size(), stride);
+        return *this;
+    }
+
+    /**
+     * Uses bounds computed beforehand.
+     */
+    MeshBuilder& bounds(const Bounds& bounds) {
+        bounds_ = bounds;
+        return *this;
+    }
+
     MeshBuilder& attribute(GLuint index, GLint size,
             std::size_t offset = 0,
             GLenum type = GL_FLOAT,
@@ -125,7 +165,7 @@ public:
         return *this;
     }
 
-    MeshPtr create(Primitive mode = Primitive::TRIANGLES) {
+    Mesh create(Primitive mode = Primitive::TRIANGLES) {
         glBindVertexArray(0);
         glBindBuffer(GL_ARRAY_BUFFER, 0);
         if (indexed()) {
@@ -133,7 +173,10 @@ public:
             glDeleteBuffers(1, &indexBuffer_);
         }
         std::cout << "Creating with " << vertexCount() << " items!" << std::endl;
-        return newMesh(vao_, vertexCount(), indexed(), indexType_, mode);
+        Mesh mesh { vao_, static_cast<std::size_t>(vertexCount()), indexed(),
+            indexType_, mode };
+        mesh.bounds = bounds_;
+        return mesh;
     }
 
     bool indexed() const {
@@ -181,6 +224,8 @@ private:
     GLuint indexBuffer_ = -1;
     GLsizei indexCount_;
     GLenum indexType_;
+
+    Bounds bounds_;
 };
 
 
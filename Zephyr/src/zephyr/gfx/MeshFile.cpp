@@ -0,0 +1,124 @@
+/**
+ * @file MeshFile.cpp
+ */
+
+#include <zephyr/gfx/MeshFile.hpp>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+
+namespace zephyr {
+namespace gfx {
+
+constexpr std::uint32_t MeshFileHeader::VERSION;
+constexpr std::size_t MeshFileHeader::MAX_ATTRIBUTES;
+constexpr std::size_t MeshFileHeader::ALIGNMENT;
+
+static_assert(sizeof(MeshFileHeader) == 192,
+        "Mesh file header must not contain padding");
+
+namespace {
+
+const char MAGIC[4] = { 'Z', 'M', 'S', 'H' };
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    const std::uint64_t align = MeshFileHeader::ALIGNMENT;
+    return (offset + align - 1) & ~(align - 1);
+}
+
+void pad(std::ostream& out, std::uint64_t from, std::uint64_t to) {
+    static const char zeros[MeshFileHeader::ALIGNMENT] = { };
+    out.write(zeros, to - from);
+}
+
+std::runtime_error invalid(const std::string& path, const char* what) {
+    return std::runtime_error { "Invalid mesh file " + path + ": " + what };
+}
+
+} /* namespace */
+
+
+std::uint64_t contentHash(const char* begin, const char* end) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char* p = begin; p != end; ++ p) {
+        hash ^= static_cast<unsigned char>(*p);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void writeMeshFile(const std::string& path, const MeshFileData& data) {
+    const std::uint64_t limit = std::numeric_limits<std::uint32_t>::max();
+    std::uint64_t stride = data.stride * sizeof(float);
+    std::uint64_t vertexCount = data.stride ? data.vertices.size() / data.stride : 0;
+    if (data.attributes.size() > MeshFileHeader::MAX_ATTRIBUTES
+            || vertexCount > limit || data.indices.size() > limit) {
+        throw std::runtime_error { "Mesh too large for the mesh file: " + path };
+    }
+
+    MeshFileHeader header { };
+    std::memcpy(header.magic, MAGIC, sizeof MAGIC);
+    header.version = MeshFileHeader::VERSION;
+    header.sourceHash = data.sourceHash;
+    header.variant = data.variant;
+    header.vertexCount = vertexCount;
+    header.indexCount = data.indices.size();
+    header.stride = stride;
+    header.attributeCount = data.attributes.size();
+    for (std::size_t i = 0; i < data.attributes.size(); ++ i) {
+        header.attributes[i] = data.attributes[i];
+    }
+    header.bounds = data.bounds;
+
+    std::uint64_t vertexBytes = vertexCount * stride;
+    std::uint64_t indexBytes = data.indices.size() * sizeof(std::uint32_t);
+    header.vertexOffset = alignUp(sizeof header);
+    header.indexOffset = alignUp(header.vertexOffset + vertexBytes);
+
+    std::string temporary = path + ".tmp";
+    {
+        std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&header), sizeof header);
+        pad(out, sizeof header, header.vertexOffset);
+        out.write(reinterpret_cast<const char*>(data.vertices.data()),
+                vertexBytes);
+        pad(out, header.vertexOffset + vertexBytes, header.indexOffset);
+        out.write(reinterpret_cast<const char*>(data.indices.data()),
+                indexBytes);
+        if (!out) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error { "Cannot write mesh file: " + path };
+        }
+    }
+    if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+        std::remove(temporary.c_str());
+        throw std::runtime_error { "Cannot write mesh file: " + path };
+    }
+}
+
+
+MeshFile::MeshFile(const std::string& path)
+: file_ { path }
+, header_ { reinterpret_cast<const MeshFileHeader*>(file_.data()) }
+{
+    if (file_.size() < sizeof(MeshFileHeader)
+            || std::memcmp(header_->magic, MAGIC, sizeof MAGIC) != 0) {
+        throw invalid(path, "not a mesh file");
+    }
+    if (header_->version != MeshFileHeader::VERSION) {
+        throw invalid(path, "unsupported version");
+    }
+    if (header_->attributeCount > MeshFileHeader::MAX_ATTRIBUTES
+            || header_->vertexOffset % MeshFileHeader::ALIGNMENT != 0
+            || header_->indexOffset % MeshFileHeader::ALIGNMENT != 0
+            || header_->vertexOffset + vertexBytes() > file_.size()
+            || header_->indexOffset + indexBytes() > file_.size()) {
+        throw invalid(path, "truncated or corrupted");
+    }
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
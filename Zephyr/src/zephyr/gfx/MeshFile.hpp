@@ -0,0 +1,150 @@
+/**
+ * @file MeshFile.hpp
+ */
+
+#ifndef ZEPHYR_GFX_MESHFILE_HPP_
+#define ZEPHYR_GFX_MESHFILE_HPP_
+
+#include <zephyr/gfx/Bounds.hpp>
+#include <zephyr/util/MappedFile.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/** Float vertex attribute stored in the interleaved vertex buffer */
+struct MeshAttribute {
+    /** Attribute location in the shader */
+    std::uint32_t index;
+
+    /** Number of float components */
+    std::uint32_t size;
+
+    /** Offset within the vertex, in bytes */
+    std::uint32_t offset;
+};
+
+/**
+ * Header of the binary mesh file. Data is stored in the native byte order,
+ * vertex data right after the header, followed by 32-bit indices, both aligned
+ * to @ref MeshFileHeader::ALIGNMENT bytes - file can be mapped and passed to
+ * @c glBufferData as it is.
+ */
+struct MeshFileHeader {
+    static constexpr std::uint32_t VERSION = 1;
+    static constexpr std::size_t MAX_ATTRIBUTES = 8;
+    static constexpr std::size_t ALIGNMENT = 16;
+
+    /** "ZMSH" */
+    char magic[4];
+    std::uint32_t version;
+
+    /** @ref contentHash() of the file the mesh was built from */
+    std::uint64_t sourceHash;
+
+    /** Options the mesh was built with, e.g. normal computation strategy */
+    std::uint32_t variant;
+
+    std::uint32_t vertexCount;
+    std::uint32_t indexCount;
+
+    /** Size of the vertex, in bytes */
+    std::uint32_t stride;
+
+    std::uint32_t attributeCount;
+    MeshAttribute attributes[MAX_ATTRIBUTES];
+
+    Bounds bounds;
+    std::uint32_t reserved;
+
+    /** Offsets from the beginning of the file, in bytes */
+    std::uint64_t vertexOffset;
+    std::uint64_t indexOffset;
+};
+
+/** Contents of the mesh file, before it is written */
+struct MeshFileData {
+    std::uint64_t sourceHash = 0;
+    std::uint32_t variant = 0;
+
+    /** Size of the vertex, in floats */
+    std::uint32_t stride = 0;
+
+    std::vector<MeshAttribute> attributes;
+
+    /** Interleaved vertex data */
+    std::vector<float> vertices;
+    std::vector<std::uint32_t> indices;
+
+    Bounds bounds;
+};
+
+/**
+ * 64-bit FNV-1a hash of the bytes, used to tell whether the mesh file is up
+ * to date with its source.
+ */
+std::uint64_t contentHash(const char* begin, const char* end);
+
+/**
+ * Writes the mesh file. Data is written to a temporary file first, and
+ * renamed, so the readers never see a partially written file.
+ *
+ * @throws std::runtime_error if the file cannot be written, or the data does
+ *         not fit in the format
+ */
+void writeMeshFile(const std::string& path, const MeshFileData& data);
+
+/**
+ * Memory-mapped mesh file.
+ */
+class MeshFile {
+public:
+
+    /**
+     * Maps the file and validates the header.
+     *
+     * @throws std::runtime_error if the file cannot be read, is not a mesh
+     *         file, is of a different version or is truncated
+     */
+    explicit MeshFile(const std::string& path);
+
+    const MeshFileHeader& header() const {
+        return *header_;
+    }
+
+    /** @return Whether the file was built from the given source and options */
+    bool matches(std::uint64_t sourceHash, std::uint32_t variant) const {
+        return header_->sourceHash == sourceHash && header_->variant == variant;
+    }
+
+    const float* vertices() const {
+        return reinterpret_cast<const float*>(
+                file_.data() + header_->vertexOffset);
+    }
+
+    std::size_t vertexBytes() const {
+        return std::size_t(header_->vertexCount) * header_->stride;
+    }
+
+    const std::uint32_t* indices() const {
+        return reinterpret_cast<const std::uint32_t*>(
+                file_.data() + header_->indexOffset);
+    }
+
+    std::size_t indexBytes() const {
+        return std::size_t(header_->indexCount) * sizeof(std::uint32_t);
+    }
+
+private:
+    util::MappedFile file_;
+    const MeshFileHeader* header_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_MESHFILE_HPP_ */
@@ -0,0 +1,473 @@
+/**
+ * @file ObjParser.cpp
+ */
+
+#include <zephyr/gfx/ObjParser.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <zephyr/util/MappedFile.hpp>
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+
+namespace zephyr {
+namespace gfx {
+
+constexpr std::uint32_t ObjData::NONE;
+
+namespace {
+
+/** Powers of 10 exactly representable as double */
+const double POWERS_OF_10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int MAX_EXACT_POWER = 22;
+const int MAX_DIGITS = 19;
+const std::uint64_t MAX_EXACT_MANTISSA = std::uint64_t(1) << 53;
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/** Whitespace within the line */
+bool isSpace(char c) {
+    return c == ' ' || c == '\t' || c == '\r';
+}
+
+const char* skipSpaces(const char* p, const char* end) {
+    while (p != end && isSpace(*p)) {
+        ++ p;
+    }
+    return p;
+}
+
+/**
+ * Double lies exactly in the middle between two floats, so rounding it to
+ * float might differ from rounding the number it was computed from.
+ */
+bool halfwayBetweenFloats(double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof bits);
+    const int droppedBits = DBL_MANT_DIG - FLT_MANT_DIG;
+    std::uint64_t dropped = bits & ((std::uint64_t(1) << droppedBits) - 1);
+    return dropped == std::uint64_t(1) << (droppedBits - 1);
+}
+
+/** Parses the token with strtof, which needs a null-terminated copy */
+const char* parseFloatSlow(const char* p, const char* end, float& value) {
+    const char* tokenEnd = p;
+    while (tokenEnd != end && !isSpace(*tokenEnd) && *tokenEnd != '\n') {
+        ++ tokenEnd;
+    }
+    std::string token(p, tokenEnd);
+    char* stop;
+    float result = std::strtof(token.c_str(), &stop);
+    if (stop != token.c_str()) {
+        value = result;
+    }
+    return p + (stop - token.c_str());
+}
+
+const char* parseIndex(const char* p, const char* end, long& value) {
+    const char* start = p;
+    bool negative = false;
+    if (p != end && *p == '-') {
+        negative = true;
+        ++ p;
+    }
+    if (p == end || !isDigit(*p)) {
+        return start;
+    }
+    long n = 0;
+    while (p != end && isDigit(*p)) {
+        n = n * 10 + (*p - '0');
+        ++ p;
+    }
+    value = negative ? -n : n;
+    return p;
+}
+
+/** Arrays of ObjData indices */
+enum Attribute {
+    VERTEX, TEX, NORMAL
+};
+
+/**
+ * Index relative to the beginning of the chunk, resolved once the number of
+ * elements in the preceding chunks is known.
+ */
+struct Fixup {
+    Attribute attribute;
+    std::size_t position;
+    long index;
+};
+
+std::vector<std::uint32_t>& indicesOf(ObjData& data, Attribute attribute) {
+    switch (attribute) {
+    case VERTEX: return data.vertexIndices;
+    case TEX: return data.texIndices;
+    default: return data.normalIndices;
+    }
+}
+
+
+class ObjParser {
+public:
+
+    /**
+     * @param fixups If not @c nullptr, text is a chunk of a larger file, and
+     *        relative indices are stored there instead of being resolved
+     */
+    ObjParser(ObjData& data, std::vector<Fixup>* fixups = nullptr)
+    : data_(data)
+    , fixups_(fixups)
+    { }
+
+    void parse(const char* begin, const char* end) {
+        const char* p = begin;
+        while (p != end) {
+            const void* newline = std::memchr(p, '\n', end - p);
+            const char* eol = newline ? static_cast<const char*>(newline) : end;
+            parseLine(p, eol);
+            p = newline ? eol + 1 : end;
+        }
+    }
+
+private:
+
+    void parseLine(const char* p, const char* eol) {
+        p = skipSpaces(p, eol);
+        if (eol - p < 2) {
+            return;
+        }
+        if (p[0] == 'v') {
+            if (isSpace(p[1])) {
+                readFloats(p + 1, eol, 3, data_.positions);
+            } else if (p + 2 != eol && isSpace(p[2])) {
+                if (p[1] == 't') {
+                    readFloats(p + 2, eol, 2, data_.texCoords);
+                } else if (p[1] == 'n') {
+                    readFloats(p + 2, eol, 3, data_.normals);
+                }
+            }
+        } else if (p[0] == 'f' && isSpace(p[1])) {
+            readFace(p + 1, eol);
+        }
+    }
+
+    /** Missing or malformed values are 0, as with the stream extraction */
+    void readFloats(const char* p, const char* eol, int count,
+            std::vector<float>& out) {
+        bool ok = true;
+        for (int i = 0; i < count; ++ i) {
+            float value = 0;
+            if (ok) {
+                p = skipSpaces(p, eol);
+                const char* next = parseFloat(p, eol, value);
+                ok = next != p;
+                p = next;
+            }
+            out.push_back(value);
+        }
+    }
+
+    /** 0-based indices, -1 if missing or invalid */
+    struct Corner {
+        long index[3];
+        bool relative[3];
+    };
+
+    /** Polygon is split into a fan of triangles around its first vertex */
+    void readFace(const char* p, const char* eol) {
+        Corner first, previous, corner;
+        int count = 0;
+        while (true) {
+            p = skipSpaces(p, eol);
+            if (p == eol || *p == '#') {
+                break;
+            }
+            const char* next = readCorner(p, eol, corner);
+            if (next == p) {
+                break;
+            }
+            p = next;
+            if (count == 0) {
+                first = corner;
+            } else if (count >= 2) {
+                addTriangle(first, previous, corner);
+            }
+            previous = corner;
+            ++ count;
+        }
+    }
+
+    /** v, v/vt, v//vn or v/vt/vn */
+    const char* readCorner(const char* p, const char* eol, Corner& corner) {
+        long v = 0, t = 0, n = 0;
+        const char* next = parseIndex(p, eol, v);
+        if (next == p) {
+            return p;
+        }
+        p = next;
+        if (p != eol && *p == '/') {
+            p = parseIndex(p + 1, eol, t);
+            if (p != eol && *p == '/') {
+                p = parseIndex(p + 1, eol, n);
+            }
+        }
+        while (p != eol && !isSpace(*p)) {
+            ++ p;
+        }
+        resolve(corner, VERTEX, v, data_.positions.size() / 3);
+        resolve(corner, TEX, t, data_.texCoords.size() / 2);
+        resolve(corner, NORMAL, n, data_.normals.size() / 3);
+        return p;
+    }
+
+    /**
+     * Converts 1-based or negative (counted back from the last element read
+     * so far) index to 0-based one.
+     */
+    void resolve(Corner& corner, Attribute attribute, long index,
+            std::size_t count) {
+        long& resolved = corner.index[attribute];
+        corner.relative[attribute] = index < 0 && fixups_;
+        if (index > 0) {
+            resolved = index - 1;
+        } else if (index < 0) {
+            resolved = static_cast<long>(count) + index;
+            if (resolved < 0 && !fixups_) {
+                resolved = -1;
+            }
+        } else {
+            resolved = -1;
+        }
+    }
+
+    /** Stored with reversed winding, (a, c, b) */
+    void addTriangle(const Corner& a, const Corner& b, const Corner& c) {
+        const Corner* corners[] = { &a, &c, &b };
+        for (const Corner* corner : corners) {
+            for (Attribute attribute : { VERTEX, TEX, NORMAL }) {
+                std::vector<std::uint32_t>& out = indicesOf(data_, attribute);
+                long index = corner->index[attribute];
+                if (corner->relative[attribute]) {
+                    fixups_->push_back({ attribute, out.size(), index });
+                }
+                out.push_back(index < 0 ? ObjData::NONE
+                        : static_cast<std::uint32_t>(index));
+            }
+        }
+    }
+
+    ObjData& data_;
+    std::vector<Fixup>* fixups_;
+};
+
+
+/** Parsed piece of the file, with the position of its data in the result */
+struct Chunk {
+    const char* begin;
+    const char* end;
+    ObjData data;
+    std::vector<Fixup> fixups;
+
+    // elements in the preceding chunks
+    std::size_t positions;
+    std::size_t texCoords;
+    std::size_t normals;
+    std::size_t indices;
+};
+
+/** Chunks of about @c size bytes, ending at line boundaries */
+std::vector<Chunk> split(const char* begin, const char* end, std::size_t size) {
+    std::vector<Chunk> chunks;
+    const char* p = begin;
+    while (p != end) {
+        const char* last = end - p > static_cast<long>(size) ? p + size : end;
+        const void* newline = std::memchr(last, '\n', end - last);
+        const char* next = newline ? static_cast<const char*>(newline) + 1 : end;
+        chunks.push_back(Chunk { p, next, ObjData { }, { }, 0, 0, 0, 0 });
+        p = next;
+    }
+    return chunks;
+}
+
+template <typename T>
+void append(std::vector<T>& out, std::size_t offset, const std::vector<T>& in) {
+    std::copy(in.begin(), in.end(), out.begin() + offset);
+}
+
+/** Copies the chunk's data to the result, resolving relative indices */
+void merge(const Chunk& chunk, ObjData& data) {
+    const ObjData& in = chunk.data;
+    append(data.positions, chunk.positions, in.positions);
+    append(data.texCoords, chunk.texCoords, in.texCoords);
+    append(data.normals, chunk.normals, in.normals);
+    append(data.vertexIndices, chunk.indices, in.vertexIndices);
+    append(data.texIndices, chunk.indices, in.texIndices);
+    append(data.normalIndices, chunk.indices, in.normalIndices);
+
+    const std::size_t base[] = {
+        chunk.positions / 3, chunk.texCoords / 2, chunk.normals / 3
+    };
+    for (const Fixup& fixup : chunk.fixups) {
+        long index = static_cast<long>(base[fixup.attribute]) + fixup.index;
+        indicesOf(data, fixup.attribute)[chunk.indices + fixup.position] =
+                index < 0 ? ObjData::NONE : static_cast<std::uint32_t>(index);
+    }
+}
+
+} /* namespace */
+
+
+const char* parseFloat(const char* p, const char* end, float& value) {
+    const char* start = p;
+    bool negative = false;
+    if (p != end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        ++ p;
+    }
+
+    // number is mantissa * 10^exponent, exact as long as no digit is dropped
+    std::uint64_t mantissa = 0;
+    int digits = 0;
+    int exponent = 0;
+    bool exact = true;
+    bool any = false;
+
+    while (p != end && isDigit(*p)) {
+        any = true;
+        if (digits < MAX_DIGITS) {
+            mantissa = mantissa * 10 + (*p - '0');
+            digits += mantissa != 0;
+        } else {
+            ++ exponent;
+            exact = exact && *p == '0';
+        }
+        ++ p;
+    }
+    if (p != end && *p == '.') {
+        ++ p;
+        while (p != end && isDigit(*p)) {
+            any = true;
+            if (digits < MAX_DIGITS) {
+                mantissa = mantissa * 10 + (*p - '0');
+                digits += mantissa != 0;
+                -- exponent;
+            } else {
+                exact = exact && *p == '0';
+            }
+            ++ p;
+        }
+    }
+    if (!any) {
+        // inf, nan, or not a number at all
+        return parseFloatSlow(start, end, value);
+    }
+    if (p != end && (*p == 'e' || *p == 'E')) {
+        const char* q = p + 1;
+        bool negativeExp = false;
+        if (q != end && (*q == '-' || *q == '+')) {
+            negativeExp = *q == '-';
+            ++ q;
+        }
+        if (q != end && isDigit(*q)) {
+            int e = 0;
+            while (q != end && isDigit(*q)) {
+                if (e < 10000) {
+                    e = e * 10 + (*q - '0');
+                }
+                ++ q;
+            }
+            exponent += negativeExp ? -e : e;
+            p = q;
+        }
+    }
+
+    // both mantissa and power of 10 are exact doubles, so the result is
+    // correctly rounded to double - and to float, unless it is a tie
+    if (exact && mantissa <= MAX_EXACT_MANTISSA
+            && exponent >= -MAX_EXACT_POWER && exponent <= MAX_EXACT_POWER) {
+        double d = static_cast<double>(mantissa);
+        if (exponent < 0) {
+            d /= POWERS_OF_10[-exponent];
+        } else {
+            d *= POWERS_OF_10[exponent];
+        }
+        if (d == 0) {
+            value = negative ? -0.0f : 0.0f;
+            return p;
+        }
+        if (d >= FLT_MIN && d <= FLT_MAX && !halfwayBetweenFloats(d)) {
+            float f = static_cast<float>(d);
+            value = negative ? -f : f;
+            return p;
+        }
+    }
+    parseFloatSlow(start, end, value);
+    return p;
+}
+
+
+ObjData parseObj(const char* begin, const char* end) {
+    ObjData data;
+    ObjParser parser { data };
+    parser.parse(begin, end);
+    return data;
+}
+
+ObjData parseObj(const char* begin, const char* end, core::Jobs& jobs,
+        std::size_t chunkSize) {
+    std::vector<Chunk> chunks = split(begin, end, std::max<std::size_t>(chunkSize, 1));
+    if (!jobs.parallel() || chunks.size() < 2) {
+        return parseObj(begin, end);
+    }
+    jobs.parallel_for(0, chunks.size(), 1, [&chunks](std::size_t i) {
+        Chunk& chunk = chunks[i];
+        ObjParser parser { chunk.data, &chunk.fixups };
+        parser.parse(chunk.begin, chunk.end);
+    });
+
+    // prefix sums of the element counts
+    ObjData data;
+    std::size_t positions = 0, texCoords = 0, normals = 0, indices = 0;
+    for (Chunk& chunk : chunks) {
+        chunk.positions = positions;
+        chunk.texCoords = texCoords;
+        chunk.normals = normals;
+        chunk.indices = indices;
+        positions += chunk.data.positions.size();
+        texCoords += chunk.data.texCoords.size();
+        normals += chunk.data.normals.size();
+        indices += chunk.data.vertexIndices.size();
+    }
+    data.positions.resize(positions);
+    data.texCoords.resize(texCoords);
+    data.normals.resize(normals);
+    data.vertexIndices.resize(indices);
+    data.texIndices.resize(indices);
+    data.normalIndices.resize(indices);
+
+    jobs.parallel_for(0, chunks.size(), 1, [&chunks, &data](std::size_t i) {
+        merge(chunks[i], data);
+    });
+    return data;
+}
+
+ObjData loadObj(const char* path) {
+    util::MappedFile file { path };
+    return parseObj(file.begin(), file.end());
+}
+
+ObjData loadObj(const char* path, core::Jobs& jobs, std::size_t chunkSize) {
+    util::MappedFile file { path };
+    return parseObj(file.begin(), file.end(), jobs, chunkSize);
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
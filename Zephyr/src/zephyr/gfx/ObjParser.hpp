@@ -0,0 +1,108 @@
+/**
+ * @file ObjParser.hpp
+ */
+
+#ifndef ZEPHYR_GFX_OBJPARSER_HPP_
+#define ZEPHYR_GFX_OBJPARSER_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace zephyr {
+
+namespace core {
+class Jobs;
+} /* namespace core */
+
+namespace gfx {
+
+/** Size of the pieces the file is split into by the parallel parser */
+constexpr std::size_t OBJ_CHUNK_SIZE = 1 << 20;
+
+/**
+ * Geometry read from the Wavefront OBJ file, as flat arrays. Faces are
+ * triangulated as fans around their first vertex, and each triangle is stored
+ * in the order (a, c, b) - i.e. with the winding reversed, as the renderer
+ * expects it.
+ *
+ * Indices are 0-based, negative (relative) indices of the file are resolved.
+ * Index missing in the file (e.g. no texture coordinate in @c f 1//1) is
+ * @ref NONE.
+ */
+struct ObjData {
+    static constexpr std::uint32_t NONE = ~std::uint32_t(0);
+
+    /** x, y, z of the @c v records */
+    std::vector<float> positions;
+
+    /** u, v of the @c vt records */
+    std::vector<float> texCoords;
+
+    /** x, y, z of the @c vn records */
+    std::vector<float> normals;
+
+    /** 3 per triangle */
+    std::vector<std::uint32_t> vertexIndices;
+    std::vector<std::uint32_t> texIndices;
+    std::vector<std::uint32_t> normalIndices;
+
+    std::size_t vertexCount() const {
+        return positions.size() / 3;
+    }
+
+    std::size_t triangleCount() const {
+        return vertexIndices.size() / 3;
+    }
+};
+
+/**
+ * Parses the OBJ text. Only @c v, @c vt, @c vn and @c f records are used,
+ * other records and comments are skipped. Both LF and CRLF line endings are
+ * accepted.
+ */
+ObjData parseObj(const char* begin, const char* end);
+
+/**
+ * Parses the OBJ text in parallel. Text is split at line boundaries into
+ * chunks of about @c chunkSize bytes, each parsed on its own, and the results
+ * are concatenated at offsets given by prefix sums of the element counts.
+ * Relative indices referring to the earlier chunks are resolved once the
+ * offsets are known, so the result is identical to that of the serial
+ * @ref parseObj().
+ *
+ * If the jobs are not executed in parallel, or the text fits in one chunk,
+ * it is parsed serially.
+ */
+ObjData parseObj(const char* begin, const char* end, core::Jobs& jobs,
+        std::size_t chunkSize = OBJ_CHUNK_SIZE);
+
+/**
+ * Memory-maps and parses the OBJ file.
+ *
+ * @throws std::runtime_error if the file cannot be read
+ */
+ObjData loadObj(const char* path);
+
+/**
+ * Memory-maps and parses the OBJ file in parallel.
+ *
+ * @throws std::runtime_error if the file cannot be read
+ */
+ObjData loadObj(const char* path, core::Jobs& jobs,
+        std::size_t chunkSize = OBJ_CHUNK_SIZE);
+
+/**
+ * Parses the decimal floating point number at @c p, with the same result as
+ * @c strtof (numbers with more digits than fit the fast path are passed to
+ * it).
+ *
+ * @return Position after the number, or @c p if there is no number there
+ */
+const char* parseFloat(const char* p, const char* end, float& value);
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_OBJPARSER_HPP_ */
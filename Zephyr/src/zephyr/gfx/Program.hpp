@@ -6,8 +6,10 @@
 #define ZEPHYR_GFX_PROGRAM_HPP_
 
 #include <zephyr/gfx/Shader.hpp>
+#include <zephyr/gfx/UniformName.hpp>
 #include <GL/glew.h>
 #include <GL/gl.h>
+#include <algorithm>
 #include <memory>
 #include <vector>
 #include <unordered_map>
@@ -16,6 +18,20 @@
 namespace zephyr {
 namespace gfx {
 
+/**
+ * Location of the active uniform variable of a program, by uniform id.
+ */
+struct UniformBinding {
+    UniformId id;
+    GLint location;
+
+    /**
+     * Version of the value last uploaded by @ref UniformManager, 0 if none
+     * or if it has been overwritten since
+     */
+    mutable std::uint32_t uploaded;
+};
+
 namespace detail {
 
     inline void checkCreationStatus(GLuint program) {
@@ -80,6 +96,31 @@ namespace detail {
         return blocks;
     }
 
+    inline std::vector<UniformBinding> makeUniformTable(
+            const std::unordered_map<std::string, GLuint>& uniforms) {
+        std::vector<std::pair<UniformId, const std::string*>> ids;
+        std::vector<UniformBinding> table;
+
+        for (const auto& uniform : uniforms) {
+            UniformId id = uniformId(uniform.first);
+            ids.emplace_back(id, &uniform.first);
+            table.push_back({ id, static_cast<GLint>(uniform.second), 0 });
+        }
+        std::sort(begin(ids), end(ids));
+        for (std::size_t i = 1; i < ids.size(); ++ i) {
+            if (ids[i].first == ids[i - 1].first) {
+                throw std::runtime_error(util::format(
+                        "Uniforms \"{}\" and \"{}\" have the same id",
+                        *ids[i - 1].second, *ids[i].second));
+            }
+        }
+        std::sort(begin(table), end(table),
+                [](const UniformBinding& a, const UniformBinding& b) {
+            return a.id < b.id;
+        });
+        return table;
+    }
+
 } /* namespace detail */
 
 
@@ -95,6 +136,7 @@ public:
     : program_ { detail::create(begin, end) }
     , uniforms_ { detail::getUniforms(program_) }
     , uniformBlocks_ { detail::getUniformBlocks(program_) }
+    , uniformTable_ { detail::makeUniformTable(uniforms_) }
     { }
 
     template <typename Container>
@@ -136,6 +178,27 @@ public:
         }
     }
 
+    GLint uniformLocation(UniformId id) const {
+        const UniformBinding* binding = uniformBinding(id);
+        return binding ? binding->location : -1;
+    }
+
+    /**
+     * @return Binding of the uniform with given id, or @c nullptr if the
+     *         program has no such active uniform
+     */
+    const UniformBinding* uniformBinding(UniformId id) const {
+        auto it = std::lower_bound(begin(uniformTable_), end(uniformTable_),
+                id, [](const UniformBinding& binding, UniformId id) {
+            return binding.id < id;
+        });
+        if (it != end(uniformTable_) && it->id == id) {
+            return &*it;
+        } else {
+            return nullptr;
+        }
+    }
+
     GLint uniformBlockIndex(const char* name) const {
         return uniformBlockIndex(std::string { name });
     }
@@ -168,6 +231,13 @@ public:
         return uniformBlocks_;
     }
 
+    /**
+     * @return Bindings of all the active uniforms, sorted by id
+     */
+    const std::vector<UniformBinding>& uniformTable() const {
+        return uniformTable_;
+    }
+
 private:
 
     GLuint program_;
@@ -176,6 +246,8 @@ private:
 
     UniformBlockMap uniformBlocks_;
 
+    std::vector<UniformBinding> uniformTable_;
+
 };
 
 
@@ -0,0 +1,116 @@
+/**
+ * @file RenderCommands.hpp
+ */
+
+#ifndef ZEPHYR_GFX_RENDERCOMMANDS_HPP_
+#define ZEPHYR_GFX_RENDERCOMMANDS_HPP_
+
+#include <zephyr/gfx/CommandBuffer.hpp>
+#include <zephyr/gfx/UniformManager.hpp>
+#include <zephyr/gfx/objects.h>
+#include <glm/glm.hpp>
+#include <glm/ext.hpp>
+#include <cstdint>
+
+
+namespace zephyr {
+namespace gfx {
+
+/** Types of the packets recorded for the renderer */
+enum class RenderCommand : std::uint32_t {
+    DRAW,
+    UNIFORM
+};
+
+
+/**
+ * Draws the entity with given transform. Program, material and mesh are
+ * those of the entity, draws are sorted and batched after replay just like
+ * the submitted renderables. Entity is referred to by handle - if it is
+ * released before the frame is rendered, the draw is skipped.
+ */
+struct DrawCommand {
+    static constexpr std::uint32_t TYPE =
+            static_cast<std::uint32_t>(RenderCommand::DRAW);
+
+    EntityHandle entity;
+    glm::mat4 transform;
+    std::uint8_t pass;
+};
+
+
+/**
+ * Sets the value of a global uniform. Name must point to a string literal,
+ * or some other string living as long as the renderer.
+ */
+struct UniformCommand {
+    static constexpr std::uint32_t TYPE =
+            static_cast<std::uint32_t>(RenderCommand::UNIFORM);
+
+    UniformName name;
+    UniformValue value;
+};
+
+
+/**
+ * Records commands for the renderer into the buffer of the calling thread.
+ * Lightweight, meant to be created for each batch of commands.
+ */
+class CommandRecorder {
+public:
+
+    explicit CommandRecorder(CommandBuffer& buffer)
+    : buffer_(buffer)
+    { }
+
+    void draw(EntityHandle entity, const glm::mat4& transform,
+            std::uint8_t pass = 0) {
+        buffer_.push(DrawCommand { entity, transform, pass });
+    }
+
+    void set1f(UniformName name, float v) {
+        uniform(name, UniformType::FLOAT1, &v, sizeof v);
+    }
+
+    void set2f(UniformName name, const glm::vec2& v) {
+        uniform(name, UniformType::FLOAT2, glm::value_ptr(v), sizeof v);
+    }
+
+    void set3f(UniformName name, const glm::vec3& v) {
+        uniform(name, UniformType::FLOAT3, glm::value_ptr(v), sizeof v);
+    }
+
+    void set4f(UniformName name, const glm::vec4& v) {
+        uniform(name, UniformType::FLOAT4, glm::value_ptr(v), sizeof v);
+    }
+
+    void set1i(UniformName name, GLint v) {
+        uniform(name, UniformType::INT1, &v, sizeof v);
+    }
+
+    void setMat4(UniformName name, const glm::mat4& mat) {
+        uniform(name, UniformType::MAT4, glm::value_ptr(mat), sizeof mat);
+    }
+
+    /** @return Number of packets recorded into the buffer */
+    std::size_t size() const {
+        return buffer_.size();
+    }
+
+private:
+
+    void uniform(UniformName name, UniformType type, const void* data,
+            std::size_t size) {
+        UniformCommand command { name, UniformValue { } };
+        command.value.type = type;
+        std::memcpy(command.value.f, data, size);
+        buffer_.push(command);
+    }
+
+    CommandBuffer& buffer_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_RENDERCOMMANDS_HPP_ */
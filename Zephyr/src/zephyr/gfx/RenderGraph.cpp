@@ -0,0 +1,270 @@
+/**
+ * @file RenderGraph.cpp
+ */
+
+#include <zephyr/gfx/RenderGraph.hpp>
+#include <zephyr/util/format.hpp>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+const std::size_t NONE = static_cast<std::size_t>(-1);
+
+bool contains(const std::vector<ResourceId>& resources, ResourceId resource) {
+    return std::find(begin(resources), end(resources), resource)
+            != end(resources);
+}
+
+} /* namespace */
+
+
+ResourceId RenderGraph::PassBuilder::read(ResourceId resource) {
+    graph_.passes_[pass_].reads.push_back(resource);
+    return resource;
+}
+
+ResourceId RenderGraph::PassBuilder::write(ResourceId resource) {
+    graph_.passes_[pass_].writes.push_back(resource);
+    return resource;
+}
+
+void RenderGraph::PassBuilder::sideEffect() {
+    graph_.passes_[pass_].sideEffect = true;
+}
+
+
+TargetId RenderGraph::PassContext::target(ResourceId resource) const {
+    return graph_.resources_[resource].target;
+}
+
+void RenderGraph::PassContext::size(ResourceId resource, int& width,
+        int& height) const {
+    const Resource& r = graph_.resources_[resource];
+    width = r.width;
+    height = r.height;
+}
+
+
+ResourceId RenderGraph::create(std::string name, TargetFormat format,
+        float scale) {
+    resources_.push_back({
+        std::move(name), format, scale, false, 0, 0, 0, NONE, NONE
+    });
+    compiled_ = false;
+    return resources_.size() - 1;
+}
+
+ResourceId RenderGraph::import(std::string name, TargetId target, int width,
+        int height) {
+    resources_.push_back({
+        std::move(name), TargetFormat::RGBA8, 1.0f, true, target, width,
+        height, NONE, NONE
+    });
+    compiled_ = false;
+    return resources_.size() - 1;
+}
+
+void RenderGraph::rebind(ResourceId resource, TargetId target, int width,
+        int height) {
+    Resource& r = resources_[resource];
+    if (!r.imported) {
+        throw std::logic_error(util::format("Render graph target '{}' is not "
+                "imported", r.name));
+    }
+    r.target = target;
+    r.width = width;
+    r.height = height;
+}
+
+void RenderGraph::addPass(std::string name, const Setup& setup,
+        Execute execute) {
+    passes_.push_back({ std::move(name), std::move(execute), { }, { },
+        false });
+    PassBuilder builder { *this, passes_.size() - 1 };
+    setup(builder);
+    compiled_ = false;
+}
+
+void RenderGraph::compile() {
+    std::vector<bool> kept(passes_.size());
+    cull(kept);
+    sort(kept);
+    computeLifetimes();
+    compiled_ = true;
+}
+
+void RenderGraph::cull(std::vector<bool>& kept) const {
+    std::vector<std::size_t> pending;
+    for (std::size_t i = 0; i < passes_.size(); ++ i) {
+        const Pass& pass = passes_[i];
+        bool root = pass.sideEffect;
+        for (ResourceId r : pass.writes) {
+            root = root || resources_[r].imported;
+        }
+        if (root) {
+            kept[i] = true;
+            pending.push_back(i);
+        }
+    }
+    // everything written to the targets read by kept passes is kept
+    while (!pending.empty()) {
+        const Pass& pass = passes_[pending.back()];
+        pending.pop_back();
+        for (ResourceId r : pass.reads) {
+            for (std::size_t j = 0; j < passes_.size(); ++ j) {
+                if (!kept[j] && contains(passes_[j].writes, r)) {
+                    kept[j] = true;
+                    pending.push_back(j);
+                }
+            }
+        }
+    }
+}
+
+void RenderGraph::sort(const std::vector<bool>& kept) {
+    std::size_t n = passes_.size();
+    std::vector<std::vector<std::size_t>> next(n);
+    std::vector<std::size_t> incoming(n);
+
+    auto edge = [&](std::size_t from, std::size_t to) {
+        next[from].push_back(to);
+        ++ incoming[to];
+    };
+    for (ResourceId r = 0; r < resources_.size(); ++ r) {
+        std::size_t lastWriter = NONE;
+        for (std::size_t i = 0; i < n; ++ i) {
+            if (kept[i] && contains(passes_[i].writes, r)) {
+                lastWriter = i;
+            }
+        }
+        // passes in the order of addition - reader sees the contents left
+        // by the preceding writer, and runs before the next one
+        std::size_t prevWriter = NONE;
+        std::vector<std::size_t> readers;
+        for (std::size_t i = 0; i < n; ++ i) {
+            const Pass& pass = passes_[i];
+            if (!kept[i]) {
+                continue;
+            }
+            bool reads = contains(pass.reads, r);
+            bool writes = contains(pass.writes, r);
+            if (reads && prevWriter == NONE && !resources_[r].imported) {
+                // transient has no contents before the first writer, so
+                // the read is of the final ones
+                if (lastWriter == NONE || writes) {
+                    throw std::runtime_error(util::format("Pass '{}' reads "
+                            "target '{}' before it is written", pass.name,
+                            resources_[r].name));
+                }
+                edge(lastWriter, i);
+            } else if (reads && !writes) {
+                if (prevWriter != NONE) {
+                    edge(prevWriter, i);
+                }
+                readers.push_back(i);
+            }
+            if (writes) {
+                if (prevWriter != NONE) {
+                    edge(prevWriter, i);
+                }
+                for (std::size_t reader : readers) {
+                    edge(reader, i);
+                }
+                readers.clear();
+                prevWriter = i;
+            }
+        }
+    }
+
+    // Kahn's algorithm, preferring passes added earlier
+    std::priority_queue<std::size_t, std::vector<std::size_t>,
+            std::greater<std::size_t>> ready;
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++ i) {
+        if (kept[i]) {
+            ++ count;
+            if (incoming[i] == 0) {
+                ready.push(i);
+            }
+        }
+    }
+    order_.clear();
+    while (!ready.empty()) {
+        std::size_t i = ready.top();
+        ready.pop();
+        order_.push_back(i);
+        for (std::size_t j : next[i]) {
+            if (-- incoming[j] == 0) {
+                ready.push(j);
+            }
+        }
+    }
+    if (order_.size() != count) {
+        throw std::runtime_error("Render graph has a dependency cycle");
+    }
+}
+
+void RenderGraph::computeLifetimes() {
+    for (Resource& resource : resources_) {
+        resource.first = resource.last = NONE;
+    }
+    auto use = [this](ResourceId r, std::size_t pos) {
+        Resource& resource = resources_[r];
+        if (resource.first == NONE) {
+            resource.first = pos;
+        }
+        resource.last = pos;
+    };
+    for (std::size_t pos = 0; pos < order_.size(); ++ pos) {
+        const Pass& pass = passes_[order_[pos]];
+        for (ResourceId r : pass.reads) {
+            use(r, pos);
+        }
+        for (ResourceId r : pass.writes) {
+            use(r, pos);
+        }
+    }
+}
+
+void RenderGraph::execute(RenderTargetPool& pool, int width, int height) {
+    if (!compiled_) {
+        compile();
+    }
+    PassContext context { *this };
+
+    for (std::size_t pos = 0; pos < order_.size(); ++ pos) {
+        for (Resource& r : resources_) {
+            if (!r.imported && r.first == pos) {
+                r.width = std::max(1, int(std::lround(width * r.scale)));
+                r.height = std::max(1, int(std::lround(height * r.scale)));
+                r.target = pool.acquire(r.format, r.width, r.height);
+            }
+        }
+        passes_[order_[pos]].execute(context);
+
+        for (Resource& r : resources_) {
+            if (!r.imported && r.last == pos) {
+                pool.release(r.target);
+            }
+        }
+    }
+}
+
+std::vector<std::string> RenderGraph::schedule() const {
+    std::vector<std::string> names;
+    for (std::size_t i : order_) {
+        names.push_back(passes_[i].name);
+    }
+    return names;
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
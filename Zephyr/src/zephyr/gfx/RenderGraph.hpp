@@ -0,0 +1,199 @@
+/**
+ * @file RenderGraph.hpp
+ */
+
+#ifndef ZEPHYR_GFX_RENDERGRAPH_HPP_
+#define ZEPHYR_GFX_RENDERGRAPH_HPP_
+
+#include <zephyr/gfx/RenderTargetPool.hpp>
+#include <zephyr/gfx/TargetFormat.hpp>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/** Render target used by the passes of @ref RenderGraph */
+typedef std::size_t ResourceId;
+
+
+/**
+ * Frame described as a set of passes, each declaring the render targets it
+ * reads and writes. Passes are specified by two functions - setup, called
+ * immediately to record the accesses, and execute, called during
+ * @ref execute() to issue the GL commands.
+ *
+ * Before execution, the graph is compiled:
+ * - passes that contribute nothing to the output are culled - pass is kept if
+ *   it writes an imported target, declares a side effect, or writes a target
+ *   read by another kept pass
+ * - passes are ordered so that a pass reading a target runs after the
+ *   writer of the target added before it, and before the writer added after
+ *   it, otherwise in the order they were added; transient target read before
+ *   any writer was added is read after the last one
+ * - lifetimes of transient targets are computed; each one is acquired from
+ *   the pool just before the first pass using it and released right after
+ *   the last one, so that transients with disjoint lifetimes share memory
+ *
+ * Targets of culled passes are never allocated. Compiled graph can be executed
+ * any number of times, with imported targets changed by @ref rebind().
+ */
+class RenderGraph {
+public:
+
+    /** Records the accesses of the pass */
+    class PassBuilder {
+    public:
+        /** Declares that the pass samples the target */
+        ResourceId read(ResourceId resource);
+
+        /** Declares that the pass renders into the target */
+        ResourceId write(ResourceId resource);
+
+        /** Prevents culling of the pass, even if nothing reads its output */
+        void sideEffect();
+
+    private:
+        friend class RenderGraph;
+
+        PassBuilder(RenderGraph& graph, std::size_t pass)
+        : graph_(graph), pass_ { pass }
+        { }
+
+        RenderGraph& graph_;
+        std::size_t pass_;
+    };
+
+    /** Gives the executed pass access to the physical targets */
+    class PassContext {
+    public:
+        /** Texture holding the target */
+        TargetId target(ResourceId resource) const;
+
+        /** Size of the target */
+        void size(ResourceId resource, int& width, int& height) const;
+
+    private:
+        friend class RenderGraph;
+
+        explicit PassContext(const RenderGraph& graph)
+        : graph_(graph)
+        { }
+
+        const RenderGraph& graph_;
+    };
+
+    typedef std::function<void (PassBuilder&)> Setup;
+    typedef std::function<void (const PassContext&)> Execute;
+
+    /**
+     * Declares transient target, allocated only for the time it is needed.
+     *
+     * @param scale Size relative to the size the graph is executed with
+     */
+    ResourceId create(std::string name, TargetFormat format,
+            float scale = 1.0f);
+
+    /**
+     * Declares target that lives outside the graph (e.g. G-buffer). Writing
+     * to it counts as a side effect.
+     *
+     * @param width Width of the target, used by @ref PassContext::size()
+     * @param height Height of the target
+     */
+    ResourceId import(std::string name, TargetId target, int width,
+            int height);
+
+    /**
+     * Changes the texture and size of the imported target. Structure of the
+     * graph stays the same, so it does not need to be compiled again.
+     *
+     * @throws std::logic_error if the target is not imported
+     */
+    void rebind(ResourceId resource, TargetId target, int width, int height);
+
+    /**
+     * Adds the pass, calling @c setup immediately.
+     */
+    void addPass(std::string name, const Setup& setup, Execute execute);
+
+    /**
+     * Culls the passes, orders them and computes the target lifetimes.
+     *
+     * @throws std::runtime_error if there is a dependency cycle, or a
+     *         transient target is read without being written
+     */
+    void compile();
+
+    /**
+     * Runs the passes, compiling the graph first if necessary.
+     *
+     * @param pool Source of the transient targets
+     * @param width Width transient target sizes are relative to
+     * @param height Height transient target sizes are relative to
+     */
+    void execute(RenderTargetPool& pool, int width, int height);
+
+    /** Whether the graph has been compiled since the last change */
+    bool compiled() const {
+        return compiled_;
+    }
+
+    /** Names of the passes to be executed, in order */
+    std::vector<std::string> schedule() const;
+
+    /** Number of passes removed by culling */
+    std::size_t culled() const {
+        return passes_.size() - order_.size();
+    }
+
+    /** Name of the resource */
+    const std::string& name(ResourceId resource) const {
+        return resources_[resource].name;
+    }
+
+private:
+    struct Resource {
+        std::string name;
+        TargetFormat format;
+        float scale;
+        bool imported;
+
+        TargetId target;
+        int width;
+        int height;
+
+        // positions in order_ of the first and last pass using it
+        std::size_t first;
+        std::size_t last;
+    };
+
+    struct Pass {
+        std::string name;
+        Execute execute;
+        std::vector<ResourceId> reads;
+        std::vector<ResourceId> writes;
+        bool sideEffect;
+    };
+
+    void cull(std::vector<bool>& kept) const;
+
+    void sort(const std::vector<bool>& kept);
+
+    void computeLifetimes();
+
+    std::vector<Resource> resources_;
+    std::vector<Pass> passes_;
+
+    /** Indices of the kept passes, in execution order */
+    std::vector<std::size_t> order_;
+    bool compiled_ = false;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_RENDERGRAPH_HPP_ */
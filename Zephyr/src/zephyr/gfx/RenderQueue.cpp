@@ -0,0 +1,96 @@
+/**
+ * @file RenderQueue.cpp
+ */
+
+#include <zephyr/gfx/RenderQueue.hpp>
+#include <zephyr/util/format.hpp>
+#include <cstring>
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+std::uint64_t field(std::uint64_t value, unsigned bits, unsigned shift) {
+    std::uint64_t mask = (std::uint64_t(1) << bits) - 1;
+    return (value & mask) << shift;
+}
+
+} /* namespace */
+
+
+constexpr unsigned RenderQueue::PASS_BITS;
+constexpr unsigned RenderQueue::PROGRAM_BITS;
+constexpr unsigned RenderQueue::MATERIAL_BITS;
+constexpr unsigned RenderQueue::MESH_BITS;
+constexpr unsigned RenderQueue::DEPTH_BITS;
+
+
+std::uint64_t RenderQueue::makeKey(unsigned pass, std::uint32_t program,
+        std::uint32_t material, std::uint32_t mesh, float depth) {
+    unsigned shift = 0;
+    std::uint64_t key = field(quantizeDepth(depth), DEPTH_BITS, shift);
+    key |= field(mesh, MESH_BITS, shift += DEPTH_BITS);
+    key |= field(material, MATERIAL_BITS, shift += MESH_BITS);
+    key |= field(program, PROGRAM_BITS, shift += MATERIAL_BITS);
+    key |= field(pass, PASS_BITS, shift += PROGRAM_BITS);
+    return key;
+}
+
+std::uint32_t RenderQueue::quantizeDepth(float depth) {
+    if (!(depth > 0)) {
+        return 0;
+    }
+    // bit patterns of positive floats are ordered like the values
+    std::uint32_t bits;
+    std::memcpy(&bits, &depth, sizeof bits);
+    return bits >> (32 - DEPTH_BITS);
+}
+
+const std::vector<std::uint32_t>& RenderQueue::sort() {
+    const std::size_t n = items_.size();
+    scratch_.resize(n);
+
+    Item* src = items_.data();
+    Item* dst = scratch_.data();
+
+    for (unsigned shift = 0; shift < 64; shift += 8) {
+        std::size_t count[256] = { };
+        for (std::size_t i = 0; i < n; ++ i) {
+            ++ count[(src[i].key >> shift) & 0xff];
+        }
+        // all the keys share this byte, order would not change
+        if (n == 0 || count[(src[0].key >> shift) & 0xff] == n) {
+            continue;
+        }
+        std::size_t offset = 0;
+        for (std::size_t& c : count) {
+            std::size_t size = c;
+            c = offset;
+            offset += size;
+        }
+        for (std::size_t i = 0; i < n; ++ i) {
+            dst[count[(src[i].key >> shift) & 0xff] ++] = src[i];
+        }
+        std::swap(src, dst);
+    }
+
+    order_.resize(n);
+    for (std::size_t i = 0; i < n; ++ i) {
+        order_[i] = src[i].index;
+    }
+    return order_;
+}
+
+
+std::ostream& operator << (std::ostream& os, const RenderStats& stats) {
+    return os << util::format("draws={} (instanced {}, {} instances), "
+            "programs={}, materials={}, meshes={}, textures={} (skipped {}), "
+            "uniforms={}", stats.draws, stats.instancedDraws, stats.instances,
+            stats.programChanges, stats.materialChanges, stats.meshChanges,
+            stats.textureBinds, stats.textureBindsSkipped,
+            stats.uniformUploads);
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
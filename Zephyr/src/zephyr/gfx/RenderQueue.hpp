@@ -0,0 +1,198 @@
+/**
+ * @file RenderQueue.hpp
+ */
+
+#ifndef ZEPHYR_GFX_RENDERQUEUE_HPP_
+#define ZEPHYR_GFX_RENDERQUEUE_HPP_
+
+#include <cstdint>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * Numbers of GL state changes performed while drawing single frame.
+ */
+struct RenderStats {
+    std::size_t draws = 0;
+    std::size_t instancedDraws = 0;
+    std::size_t instances = 0;
+    std::size_t programChanges = 0;
+    std::size_t materialChanges = 0;
+    std::size_t meshChanges = 0;
+    std::size_t textureBinds = 0;
+    std::size_t textureBindsSkipped = 0;
+    std::size_t uniformUploads = 0;
+};
+
+std::ostream& operator << (std::ostream& os, const RenderStats& stats);
+
+
+/**
+ * Run of consecutive items of the drawing order, drawn with single call.
+ */
+struct DrawBatch {
+    /** Position of the first item in the drawing order */
+    std::uint32_t first;
+    std::uint32_t count;
+};
+
+
+/**
+ * Assigns small, dense ids to objects identified by address, so that they fit
+ * in the fields of the sort key. Ids are given in order of the first use.
+ */
+class KeyIds {
+public:
+
+    /**
+     * @param bits Width of the key field the ids need to fit into
+     */
+    explicit KeyIds(unsigned bits)
+    : mask_ { (std::uint32_t(1) << bits) - 1 }
+    { }
+
+    /**
+     * @return Id of the object, wrapped to the field width if there are more
+     *         distinct objects than it can hold
+     */
+    std::uint32_t get(const void* object) {
+        auto it = ids_.find(object);
+        if (it != end(ids_)) {
+            return it->second;
+        }
+        std::uint32_t id = static_cast<std::uint32_t>(ids_.size()) & mask_;
+        ids_.emplace(object, id);
+        return id;
+    }
+
+    void clear() {
+        ids_.clear();
+    }
+
+private:
+    std::uint32_t mask_;
+
+    std::unordered_map<const void*, std::uint32_t> ids_;
+};
+
+
+/**
+ * Sequence of draw items ordered by 64-bit sort keys. Key layout, from the
+ * most significant bits:
+ *
+ *   pass (4) | program (12) | material (16) | mesh (16) | depth (16)
+ *
+ * so that items of the same pass are grouped by program, then by material and
+ * mesh, and drawn front to back within the group. Keys are sorted with a
+ * stable LSD radix sort, items with equal keys keep the submission order.
+ */
+class RenderQueue {
+public:
+
+    static constexpr unsigned PASS_BITS = 4;
+    static constexpr unsigned PROGRAM_BITS = 12;
+    static constexpr unsigned MATERIAL_BITS = 16;
+    static constexpr unsigned MESH_BITS = 16;
+    static constexpr unsigned DEPTH_BITS = 16;
+
+    /**
+     * Packs the key fields, each one is truncated to its width.
+     *
+     * @param depth View space distance from the camera
+     */
+    static std::uint64_t makeKey(unsigned pass, std::uint32_t program,
+            std::uint32_t material, std::uint32_t mesh, float depth);
+
+    /**
+     * Maps non-negative distance to 16 bits, preserving order. Uses the
+     * exponent and the highest bits of the mantissa, so no depth range is
+     * needed. Negative distances (behind the camera) map to 0.
+     */
+    static std::uint32_t quantizeDepth(float depth);
+
+    /**
+     * Adds the key of the next item. Item index is the number of keys pushed
+     * before it.
+     */
+    void push(std::uint64_t key) {
+        items_.push_back({ key, static_cast<std::uint32_t>(items_.size()) });
+    }
+
+    /**
+     * Sorts the keys pushed so far.
+     *
+     * @return Indices of the items in the drawing order
+     */
+    const std::vector<std::uint32_t>& sort();
+
+    /**
+     * @return Indices of the items in the drawing order, as computed by the
+     *         last call to @ref sort()
+     */
+    const std::vector<std::uint32_t>& order() const {
+        return order_;
+    }
+
+    /**
+     * Splits the drawing order computed by the last call to @ref sort() into
+     * runs of items that can be drawn together.
+     *
+     * @param maxCount Maximal number of items in a batch
+     * @param mergeable Predicate taking indices of two subsequent items,
+     *        telling whether they can share a batch
+     */
+    template <typename Pred>
+    const std::vector<DrawBatch>& batch(std::size_t maxCount, Pred mergeable) {
+        batches_.clear();
+        for (std::uint32_t i = 0; i < order_.size(); ++ i) {
+            if (batches_.empty() || batches_.back().count >= maxCount
+                    || !mergeable(order_[i - 1], order_[i])) {
+                batches_.push_back({ i, 0 });
+            }
+            ++ batches_.back().count;
+        }
+        return batches_;
+    }
+
+    /**
+     * @return Batches computed by the last call to @ref batch()
+     */
+    const std::vector<DrawBatch>& batches() const {
+        return batches_;
+    }
+
+    void clear() {
+        items_.clear();
+        order_.clear();
+        batches_.clear();
+    }
+
+    std::size_t size() const {
+        return items_.size();
+    }
+
+private:
+    struct Item {
+        std::uint64_t key;
+        std::uint32_t index;
+    };
+
+    std::vector<Item> items_;
+
+    /** Second buffer of the radix sort, kept to avoid reallocation */
+    std::vector<Item> scratch_;
+
+    std::vector<std::uint32_t> order_;
+
+    std::vector<DrawBatch> batches_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_RENDERQUEUE_HPP_ */
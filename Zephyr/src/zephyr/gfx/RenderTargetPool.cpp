@@ -0,0 +1,97 @@
+/**
+ * @file RenderTargetPool.cpp
+ */
+
+#include <zephyr/gfx/RenderTargetPool.hpp>
+#include <zephyr/util/format.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+
+namespace zephyr {
+namespace gfx {
+
+RenderTargetPool::RenderTargetPool(Create create, Destroy destroy,
+        std::size_t maxIdleFrames)
+: create_ { std::move(create) }
+, destroy_ { std::move(destroy) }
+, maxIdleFrames_ { maxIdleFrames }
+{ }
+
+RenderTargetPool::~RenderTargetPool() {
+    for (const Entry& entry : entries_) {
+        destroy_(entry.id);
+    }
+}
+
+TargetId RenderTargetPool::acquire(TargetFormat format, int width,
+        int height) {
+    TargetKey key { format, width, height };
+    for (Entry& entry : entries_) {
+        if (!entry.used && entry.key == key) {
+            entry.used = true;
+            return entry.id;
+        }
+    }
+    TargetId id = create_(key);
+    entries_.push_back({ key, id, true, frame_ });
+    ++ created_;
+    return id;
+}
+
+void RenderTargetPool::release(TargetId target) {
+    for (Entry& entry : entries_) {
+        if (entry.id == target) {
+            if (!entry.used) {
+                break;
+            }
+            entry.used = false;
+            entry.lastUsed = frame_;
+            return;
+        }
+    }
+    throw std::logic_error(util::format("Render target {} is not in use",
+            target));
+}
+
+void RenderTargetPool::endFrame() {
+    ++ frame_;
+    destroyIf([this](const Entry& entry) {
+        return frame_ - entry.lastUsed > maxIdleFrames_;
+    });
+}
+
+void RenderTargetPool::trim() {
+    destroyIf([](const Entry&) { return true; });
+}
+
+template <typename Pred>
+void RenderTargetPool::destroyIf(Pred pred) {
+    auto idle = [this, &pred](const Entry& entry) {
+        if (!entry.used && pred(entry)) {
+            destroy_(entry.id);
+            return true;
+        } else {
+            return false;
+        }
+    };
+    entries_.erase(std::remove_if(begin(entries_), end(entries_), idle),
+            end(entries_));
+}
+
+std::size_t RenderTargetPool::inUse() const {
+    return std::count_if(begin(entries_), end(entries_),
+            [](const Entry& entry) { return entry.used; });
+}
+
+std::size_t RenderTargetPool::bytes() const {
+    std::size_t total = 0;
+    for (const Entry& entry : entries_) {
+        total += texelSize(entry.key.format) * entry.key.width
+                * entry.key.height;
+    }
+    return total;
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,125 @@
+/**
+ * @file RenderTargetPool.hpp
+ */
+
+#ifndef ZEPHYR_GFX_RENDERTARGETPOOL_HPP_
+#define ZEPHYR_GFX_RENDERTARGETPOOL_HPP_
+
+#include <zephyr/gfx/TargetFormat.hpp>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/** Name of the texture object holding render target, same as GLuint */
+typedef unsigned int TargetId;
+
+/** Size and format of the render target */
+struct TargetKey {
+    TargetFormat format;
+    int width;
+    int height;
+
+    bool operator == (const TargetKey& other) const {
+        return format == other.format && width == other.width
+                && height == other.height;
+    }
+};
+
+
+/**
+ * Storage of render target textures, handing them out by format and size.
+ *
+ * Released targets are not destroyed immediately, but kept for reuse -
+ * a target released by one pass can be acquired by the next one in the same
+ * frame, so that transient targets with disjoint lifetimes share memory.
+ * Targets unused for more than @c maxIdleFrames frames are destroyed by
+ * @ref endFrame(), as are all the targets once the pool is destroyed.
+ *
+ * Textures are created and destroyed by functions given to the constructor,
+ * which keeps the bookkeeping independent of GL.
+ */
+class RenderTargetPool {
+public:
+
+    typedef std::function<TargetId (const TargetKey&)> Create;
+    typedef std::function<void (TargetId)> Destroy;
+
+    /**
+     * @param create Allocates the texture
+     * @param destroy Releases the texture
+     * @param maxIdleFrames Number of frames free target survives unused
+     */
+    RenderTargetPool(Create create, Destroy destroy,
+            std::size_t maxIdleFrames = 3);
+
+    RenderTargetPool(const RenderTargetPool&) = delete;
+    RenderTargetPool& operator = (const RenderTargetPool&) = delete;
+
+    ~RenderTargetPool();
+
+    /**
+     * @return Free target of given format and size, newly created if there
+     *         is none
+     */
+    TargetId acquire(TargetFormat format, int width, int height);
+
+    /**
+     * Returns the target to the pool.
+     *
+     * @throws std::logic_error if the target is not in use
+     */
+    void release(TargetId target);
+
+    /**
+     * Advances the frame counter and destroys targets that stayed unused for
+     * too long.
+     */
+    void endFrame();
+
+    /** Destroys all the free targets */
+    void trim();
+
+    /** Number of targets, both free and in use */
+    std::size_t size() const {
+        return entries_.size();
+    }
+
+    /** Number of targets in use */
+    std::size_t inUse() const;
+
+    /** Memory taken by all the targets, in bytes */
+    std::size_t bytes() const;
+
+    /** Number of textures created so far */
+    std::size_t created() const {
+        return created_;
+    }
+
+private:
+    struct Entry {
+        TargetKey key;
+        TargetId id;
+        bool used;
+        std::size_t lastUsed;
+    };
+
+    template <typename Pred>
+    void destroyIf(Pred pred);
+
+    Create create_;
+    Destroy destroy_;
+    std::size_t maxIdleFrames_;
+
+    std::vector<Entry> entries_;
+    std::size_t frame_ = 0;
+    std::size_t created_ = 0;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_RENDERTARGETPOOL_HPP_ */
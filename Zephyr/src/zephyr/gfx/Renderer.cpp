@@ -7,7 +7,8 @@
 #include <zephyr/util/make_unique.hpp>
 #include <GL/glew.h>
 #include <GL/gl.h>
-#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <iostream>
 
 
 // for hack
@@ -17,6 +18,20 @@ namespace zephyr {
 namespace gfx {
 
 
+namespace {
+
+constexpr UniformName CUBE_TEX { "cubeTex" };
+constexpr UniformName VIEWPORT { "viewport" };
+
+// inputs of the post processing
+constexpr UniformName RENDERED_TEXTURE { "renderedTexture" };
+constexpr UniformName NORMAL_TEXTURE { "normalTexture" };
+constexpr UniformName SPECULAR_TEXTURE { "specularTexture" };
+constexpr UniformName DEPTH_TEXTURE { "depthTexture" };
+
+} /* namespace */
+
+
 static const GLfloat screenQuadVertices[] = {
     -1.0f, -1.0f, -1.0f,
     -1.0f,  1.0f, -1.0f,
@@ -27,62 +42,86 @@ static const GLfloat screenQuadVertices[] = {
 };
 
 
-Renderer::Renderer(ResourceSystem& res)
+Renderer::Renderer(ResourceSystem& res, window::Surface& surface,
+        FrameBufferLayout gbuffer, core::FrameArena& arena)
 : resources_(res)
+, surface_(surface)
+, gbufferLayout_ { std::move(gbuffer) }
+, renderables_ { core::FrameAllocator<Renderable> { arena } }
 {
     glewInit();
-    glfwSwapInterval(vsync_);
+    surface_.swapInterval(vsync_);
 
     setCulling();
     setDepthTest();
 
+    targets_ = util::make_unique<RenderTargetPool>(createTargetTexture,
+            destroyTargetTexture);
     updateViewport();
 
-    screenQuad_ = MeshBuilder()
+    screenQuad_ = newMesh(MeshBuilder()
             .setBuffer(screenQuadVertices).attribute(0, 3)
-            .create();
+            .create());
+
+    ring_ = util::make_unique<FrameUniformRing>();
+    globalsBinding_ = uniforms_.reserveBlock(FrameGlobals::BLOCK_NAME);
+    objectBinding_ = uniforms_.reserveBlock(ObjectTransforms::BLOCK_NAME);
+    instanceBinding_ = uniforms_.reserveBlock(InstanceTransforms::BLOCK_NAME);
 
     postProcess_ = res.program("post");
     hack_skybox_ = res.program("skybox-prog");
 
     std::vector<glm::vec4> vertices = makeBoxVertices(5);
     std::vector<std::uint16_t> indices = makeBoxTrianglesIndices<std::uint16_t>();
-    hack_box_ = MeshBuilder()
+    hack_box_ = newMesh(MeshBuilder()
             .setBuffer(vertices).attribute(0, 4)
             .setIndices(indices)
-            .create();
+            .create());
 }
 
-void Renderer::updateViewport() {
-    int w, h;
-    GLFWwindow* window = glfwGetCurrentContext();
-    glfwGetFramebufferSize(window, &w, &h);
-    bool changed = w != viewport_.width() || h != viewport_.height();
-    viewport_.set(0, 0, w, h);
-    glViewport(0, 0, w, h);
+Renderer::~Renderer() {
+    if (scratchFrameBuffer_ != 0) {
+        glDeleteFramebuffers(1, &scratchFrameBuffer_);
+    }
+}
 
-    if (changed) {
-        gbuffer_ = util::make_unique<FrameBuffer>(4, w, h);
-        uniforms_.set4ui("viewport", 0, 0, w, h);
+void Renderer::updateViewport() {
+    surface_.framebufferSize(outputWidth_, outputHeight_);
+    auto now = ResizeFilter::Clock::now();
+    if (!resize_.update(outputWidth_, outputHeight_, now)) {
+        return;
     }
+    int w = resize_.width();
+    int h = resize_.height();
 
+    // old targets go back to the pool before the new ones are acquired
+    gbuffer_.reset();
+    gbuffer_ = util::make_unique<FrameBuffer>(gbufferLayout_, w, h,
+            *targets_);
+    std::clog << "[Renderer] G-buffer " << memoryReport(gbufferLayout_,
+            w, h) << std::endl;
+
+    viewport_.set(0, 0, w, h);
+    uniforms_.set4ui(VIEWPORT, 0, 0, w, h);
+    // creating the targets binds textures behind the cache
+    state_.invalidate();
 }
 
 void Renderer::setCulling() {
-    glEnable(GL_CULL_FACE);
-    glFrontFace(GL_CW);
-    glCullFace(GL_BACK);
+    state_.cullFace(true);
+    state_.frontFace(GL_CW);
+    state_.cullMode(GL_BACK);
 }
 
 void Renderer::setDepthTest() {
-    glEnable(GL_DEPTH_TEST);
-    glDepthMask(GL_TRUE);
-    glDepthFunc(GL_LESS);
+    state_.depthTest(true);
+    state_.depthMask(true);
+    state_.depthFunc(GL_LESS);
     glDepthRange(0.0f, 1.0f);
 }
 
 void Renderer::toggleVSync() {
-    glfwSwapInterval(vsync_ = !vsync_);
+    surface_.swapInterval(vsync_ = !vsync_);
 }
 
 void Renderer::clearBuffers() {
@@ -91,15 +130,35 @@ void Renderer::clearBuffers() {
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 }
 
-void Renderer::drawMesh(const MeshPtr& mesh) {
-    glBindVertexArray(mesh->id);
-    GLenum mode = primitiveToGL(mesh->mode);
-    if (mesh->indexed) {
-        glDrawElements(mode, mesh->count, mesh->indexType, 0);
+void Renderer::drawMesh(const Mesh& mesh) {
+    bindMesh(mesh);
+    drawBoundMesh(mesh);
+    state_.bindVertexArray(0);
+}
+
+void Renderer::bindMesh(const Mesh& mesh) {
+    if (state_.bindVertexArray(mesh.id)) {
+        ++ stats_.meshChanges;
+    }
+}
+
+void Renderer::drawBoundMesh(const Mesh& mesh, GLsizei instances) {
+    GLenum mode = primitiveToGL(mesh.mode);
+    if (instances > 1) {
+        if (mesh.indexed) {
+            glDrawElementsInstanced(mode, mesh.count, mesh.indexType, 0,
+                    instances);
+        } else {
+            glDrawArraysInstanced(mode, 0, mesh.count, instances);
+        }
+        ++ stats_.instancedDraws;
+        stats_.instances += instances;
+    } else if (mesh.indexed) {
+        glDrawElements(mode, mesh.count, mesh.indexType, 0);
     } else {
-        glDrawArrays(mode, 0, mesh->count);
+        glDrawArrays(mode, 0, mesh.count);
     }
-    glBindVertexArray(0);
+    ++ stats_.draws;
 }
 
 inline GLenum textureType(TexDim dim) {
@@ -114,31 +173,30 @@ inline GLenum textureType(TexDim dim) {
 struct TextureBinder {
 public:
 
-    TextureBinder(ProgramPtr program)
+    TextureBinder(ProgramPtr program, StateCache& state, RenderStats& stats,
+            const SamplerState& sampler = SamplerState::nearestClamp())
     : nextFreeUnit_ { 0 }
     , program_ { std::move(program) }
+    , state_(state)
+    , stats_(stats)
+    , sampler_ { state.samplers().get(sampler) }
     { }
 
     TextureBinder& bind(GLint index, GLuint texture) {
-        glActiveTexture(GL_TEXTURE0 + nextFreeUnit_);
-        glBindTexture(GL_TEXTURE_2D, texture);
+        if (state_.bindTexture(nextFreeUnit_, GL_TEXTURE_2D, texture)) {
+            ++ stats_.textureBinds;
+        } else {
+            ++ stats_.textureBindsSkipped;
+        }
+        state_.bindSampler(nextFreeUnit_, sampler_);
         glUniform1i(index, nextFreeUnit_);
 
-        GLuint sampler;
-        glGenSamplers(1, &sampler);
-        glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
-        glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
-        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glBindSampler(nextFreeUnit_, sampler);
-
-        glActiveTexture(GL_TEXTURE0);
         ++ nextFreeUnit_;
         return *this;
     }
 
-    TextureBinder& bind(const std::string& name, GLint texture) {
-        GLint uniform = program_->uniformLocation(name);
+    TextureBinder& bind(UniformName name, GLint texture) {
+        GLint uniform = program_->uniformLocation(name.id);
         if (uniform >= 0) {
             bind(uniform, texture);
         }
@@ -148,46 +206,48 @@ public:
 private:
     GLint nextFreeUnit_;
     ProgramPtr program_;
+    StateCache& state_;
+    RenderStats& stats_;
+    GLuint sampler_;
 };
 
 void Renderer::setUniformsForCurrentProgram() {
-    for (const auto& needed : currentProgram_->uniforms()) {
-        const std::string& name = needed.first;
-        if (Uniform* value = uniforms_.get(name)) {
-            value->set(needed.second);
-        }
-    }
+    stats_.uniformUploads += uniforms_.upload(*currentProgram_);
 }
 
 void Renderer::setProgram(const ProgramPtr& program) {
     if (currentProgram_ != program) {
-        glUseProgram(program->ref());
+        state_.useProgram(program->ref());
         currentProgram_ = program;
+        ++ stats_.programChanges;
         if (!markAsLoaded(currentProgram_)) {
             for (const auto& blocks : currentProgram_->uniformBlocks()) {
                 const std::string& name = blocks.first;
                 GLuint index = blocks.second;
-                GLuint bindingIndex = uniforms_.blockBindingIndex(name);
-                currentProgram_->bindBlock(index, bindingIndex);
+                GLint bindingIndex = uniforms_.blockBindingIndex(name);
+                if (bindingIndex >= 0) {
+                    currentProgram_->bindBlock(index, bindingIndex);
+                }
             }
         }
     }
 }
 
-void Renderer::setMaterial(const MaterialPtr& material) {
-    setProgram(material->program);
-    setUniformsForCurrentProgram();
+void Renderer::setMaterial(const Material& material) {
+    setProgram(material.program);
+    ++ stats_.materialChanges;
 
-    for (const auto& local : material->uniforms) {
-        const std::string& name = local.first;
-        GLint slot = currentProgram_->uniformLocation(name);
-        if (slot >= 0) {
-            local.second->set(slot);
+    for (const auto& local : material.uniforms) {
+        UniformId id = local.first;
+        if (const UniformBinding* binding = currentProgram_->uniformBinding(id)) {
+            local.second->set(binding->location);
+            // global value of the same name needs to be uploaded again
+            binding->uploaded = 0;
         }
     }
-    TextureBinder binder { currentProgram_ };
+    TextureBinder binder { currentProgram_, state_, stats_ };
 
-    for (const auto& texPair : material->textures) {
+    for (const auto& texPair : material.textures) {
         GLint samplerUniform = texPair.first;
         if (samplerUniform < 0) continue;
 
@@ -196,12 +256,6 @@ void Renderer::setMaterial(const MaterialPtr& material) {
 }
 
 
-void Renderer::setModelTransform(const glm::mat4& transform) {
-    GLint location = currentProgram_->uniformLocation("modelMatrix");
-    auto data = glm::value_ptr(transform);
-    glUniformMatrix4fv(location, 1, GL_FALSE, data);
-}
-
 void Renderer::hack_skybox() {
 
     setProgram(hack_skybox_);
@@ -209,22 +263,258 @@ void Renderer::hack_skybox() {
 
     TexturePtr texture = resources_.texture("skybox");
 
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture->ref());
-    auto idx = hack_skybox_->uniformLocation("cubeTex");
+    state_.bindTexture(0, GL_TEXTURE_CUBE_MAP, texture->ref());
+    state_.bindSampler(0, SamplerState::nearestClamp());
+    auto idx = hack_skybox_->uniformLocation(CUBE_TEX.id);
     glUniform1i(idx, 0);
-    glCullFace(GL_FRONT);
-    glDepthFunc(GL_LEQUAL);
+    state_.cullMode(GL_FRONT);
+    state_.depthFunc(GL_LEQUAL);
 
-    drawMesh(hack_box_);
+    drawMesh(*hack_box_);
 
     setCulling();
 }
 
 
+void Renderer::swapCommands() {
+    commands_.swap();
+    globals_ = recordedGlobals_;
+}
+
+void Renderer::releaseRenderables() {
+    // memory goes back to the arena with the frame, next frame starts with
+    // a fresh vector
+    lastRenderableCount_ = renderables_.size();
+    renderables_ = core::FrameVector<Renderable> { renderables_.get_allocator() };
+}
+
+void Renderer::replayCommands() {
+    renderables_.reserve(renderables_.size() + lastRenderableCount_);
+    commands_.replay([this](std::uint32_t type, const void* data) {
+        switch (static_cast<RenderCommand>(type)) {
+        case RenderCommand::DRAW: {
+            auto draw = CommandBuffer::read<DrawCommand>(data);
+            // entity released after the draw was recorded
+            if (resources_.entityPool.alive(draw.entity)) {
+                renderables_.push_back(Renderable {
+                    draw.entity, draw.transform, draw.pass
+                });
+            }
+            break;
+        }
+        case RenderCommand::UNIFORM: {
+            auto uniform = CommandBuffer::read<UniformCommand>(data);
+            uniforms_.set(uniform.name, uniform.value);
+            break;
+        }
+        }
+    });
+}
+
+void Renderer::sortRenderables() {
+    queue_.clear();
+    programIds_.clear();
+
+    // handle indices are dense already, they only need to be truncated
+    for (const Renderable& item : renderables_) {
+        const Entity& entity = resources_.entityPool[item.entity];
+        const Material& material = resources_.materialPool[entity.material];
+        // camera looks along negative z axis
+        float depth = -(globals_.viewMatrix * item.transform[3]).z;
+
+        queue_.push(RenderQueue::makeKey(item.pass,
+                programIds_.get(material.program.get()),
+                entity.material.index(),
+                entity.mesh.index(),
+                depth));
+    }
+    queue_.sort();
+
+    // subsequent items of instanced material using the same mesh are drawn
+    // with single call, regardless of the entity they come from
+    queue_.batch(InstanceTransforms::MAX_INSTANCES,
+            [this](std::uint32_t prev, std::uint32_t next) {
+        const Entity& a = resources_.entityPool[renderables_[prev].entity];
+        const Entity& b = resources_.entityPool[renderables_[next].entity];
+        return a.material == b.material && a.mesh == b.mesh
+                && resources_.materialPool[a.material].instanced;
+    });
+}
+
+bool Renderer::instanced(const Renderable& item) const {
+    const Entity& entity = resources_.entityPool[item.entity];
+    return resources_.materialPool[entity.material].instanced;
+}
+
+void Renderer::writeFrameUniforms() {
+    const std::vector<std::uint32_t>& order = queue_.order();
+    const std::vector<DrawBatch>& batches = queue_.batches();
+
+    std::size_t required = ring_->stride(sizeof(FrameGlobals));
+    bool instancing = false;
+    for (const DrawBatch& batch : batches) {
+        const Renderable& first = renderables_[order[batch.first]];
+        if (instanced(first)) {
+            required += ring_->stride(batch.count * sizeof(glm::mat4));
+            instancing = true;
+        } else {
+            required += ring_->stride(sizeof(ObjectTransforms));
+        }
+    }
+    // range of the whole block is bound, even if the batch is smaller
+    if (instancing) {
+        required += sizeof(InstanceTransforms);
+    }
+    ring_->beginFrame(required);
+
+    GLintptr globals = ring_->write(globals_);
+    ring_->bind(globalsBinding_, globals, sizeof(FrameGlobals));
+
+    batchOffsets_.clear();
+    for (const DrawBatch& batch : batches) {
+        const Renderable& first = renderables_[order[batch.first]];
+        if (instanced(first)) {
+            instanceTransforms_.clear();
+            for (std::uint32_t i = 0; i < batch.count; ++ i) {
+                const Renderable& item = renderables_[order[batch.first + i]];
+                instanceTransforms_.push_back(item.transform);
+            }
+            GLintptr offset = ring_->write(instanceTransforms_.data(),
+                    batch.count * sizeof(glm::mat4));
+            batchOffsets_.push_back(offset);
+        } else {
+            ObjectTransforms object { first.transform };
+            batchOffsets_.push_back(ring_->write(object));
+        }
+    }
+    ring_->flush();
+}
+
+void Renderer::drawRenderables() {
+    const Material* material = nullptr;
+    const Mesh* mesh = nullptr;
+
+    const std::vector<std::uint32_t>& order = queue_.order();
+    const std::vector<DrawBatch>& batches = queue_.batches();
+
+    for (std::size_t i = 0; i < batches.size(); ++ i) {
+        const DrawBatch& batch = batches[i];
+        const Renderable& item = renderables_[order[batch.first]];
+        const Entity& entity = resources_.entityPool[item.entity];
+        const Material& entityMaterial = resources_.materialPool[entity.material];
+
+        if (&entityMaterial != material) {
+            setProgram(entityMaterial.program);
+            // only the values changed since the last upload are sent
+            setUniformsForCurrentProgram();
+            setMaterial(entityMaterial);
+            material = &entityMaterial;
+        }
+        if (material->instanced) {
+            ring_->bind(instanceBinding_, batchOffsets_[i],
+                    sizeof(InstanceTransforms));
+        } else {
+            ring_->bind(objectBinding_, batchOffsets_[i],
+                    sizeof(ObjectTransforms));
+        }
+
+        const Mesh& entityMesh = resources_.meshPool[entity.mesh];
+        if (&entityMesh != mesh) {
+            mesh = &entityMesh;
+            bindMesh(*mesh);
+        }
+        drawBoundMesh(*mesh, batch.count);
+    }
+    state_.bindVertexArray(0);
+}
+
 void Renderer::render() {
-    gbuffer_->bind();
+    stats_ = RenderStats { };
+    // resources loaded between frames bind objects behind the cache
+    state_.invalidate();
+
     updateViewport();
+    if (!gbuffer_) {
+        // no usable size yet, e.g. minimized window
+        releaseRenderables();
+        return;
+    }
+
+    replayCommands();
+    sortRenderables();
+    writeFrameUniforms();
+
+    // graph is compiled once, only the G-buffer changes between frames
+    if (graphDirty_) {
+        buildGraph();
+    }
+    bindFrameTargets();
+    // transient targets are sized like the G-buffer, not the window
+    graph_.execute(*targets_, gbuffer_->width(), gbuffer_->height());
+    releaseRenderables();
+
+    ring_->endFrame();
+    targets_->endFrame();
+    // objects released during the frame are not used by it anymore
+    resources_.collect();
+}
+
+void Renderer::buildGraph() {
+    graph_ = RenderGraph { };
+    RenderGraph& graph = graph_;
+    FrameTargets targets;
+    // actual targets are bound before each frame
+    targets.color = graph.import("color", 0, 0, 0);
+    targets.normal = graph.import("normal", 0, 0, 0);
+    targets.specular = graph.import("specular", 0, 0, 0);
+    targets.depthLinear = graph.import("depth-linear", 0, 0, 0);
+    targets.depth = graph.import("depth", 0, 0, 0);
+    targets.output = graph.import("output", 0, 0, 0);
+    importedTargets_ = targets;
+
+    graph.addPass("geometry", [&targets](RenderGraph::PassBuilder& pass) {
+        pass.write(targets.color);
+        pass.write(targets.normal);
+        pass.write(targets.specular);
+        pass.write(targets.depthLinear);
+        pass.write(targets.depth);
+    }, [this](const RenderGraph::PassContext&) {
+        geometryPass();
+    });
+
+    for (auto& factory : passFactories_) {
+        targets = factory(graph, targets);
+    }
+
+    graph.addPass("post", [&targets](RenderGraph::PassBuilder& pass) {
+        pass.read(targets.color);
+        pass.read(targets.normal);
+        pass.read(targets.specular);
+        pass.read(targets.depthLinear);
+        pass.write(targets.output);
+    }, [this, targets](const RenderGraph::PassContext& ctx) {
+        postProcessPass(ctx, targets);
+    });
+    graph.compile();
+    graphDirty_ = false;
+}
+
+void Renderer::bindFrameTargets() {
+    int w = gbuffer_->width();
+    int h = gbuffer_->height();
+    const FrameTargets& targets = importedTargets_;
+    graph_.rebind(targets.color, gbuffer_->get(0), w, h);
+    graph_.rebind(targets.normal, gbuffer_->get(1), w, h);
+    graph_.rebind(targets.specular, gbuffer_->get(2), w, h);
+    graph_.rebind(targets.depthLinear, gbuffer_->get(3), w, h);
+    graph_.rebind(targets.depth, gbuffer_->depth(), w, h);
+    graph_.rebind(targets.output, 0, outputWidth_, outputHeight_);
+}
+
+void Renderer::geometryPass() {
+    // while the size settles, G-buffer keeps the old size and is stretched
+    gbuffer_->bind();
+    glViewport(0, 0, gbuffer_->width(), gbuffer_->height());
     clearBuffers();
 
     hack_skybox();
@@ -232,32 +522,56 @@ void Renderer::render() {
     for (auto& hook : preRenderHooks_) {
         hook();
     }
-    for (const Renderable& item : renderables_) {
-        setMaterial(item.entity->material);
-        setModelTransform(item.transform);
-        drawMesh(item.entity->mesh);
-    }
+    drawRenderables();
     for (auto& hook : postRenderHooks_) {
         hook();
     }
-    renderables_.clear();
+}
 
-    gbuffer_->unbind();
-    updateViewport();
+void Renderer::postProcessPass(const RenderGraph::PassContext& ctx,
+        const FrameTargets& targets) {
+    glBindFramebuffer(GL_FRAMEBUFFER, surface_.framebuffer());
+    glViewport(0, 0, outputWidth_, outputHeight_);
     clearBuffers();
 
-    setProgram(postProcess_);
+    drawScreenQuad(postProcess_, {
+        { RENDERED_TEXTURE, ctx.target(targets.color) },
+        { NORMAL_TEXTURE, ctx.target(targets.normal) },
+        { SPECULAR_TEXTURE, ctx.target(targets.specular) },
+        { DEPTH_TEXTURE, ctx.target(targets.depthLinear) }
+    });
+}
+
+void Renderer::drawScreenQuad(const ProgramPtr& program,
+        std::initializer_list<std::pair<UniformName, TargetId>> textures) {
+    setProgram(program);
     setUniformsForCurrentProgram();
 
-    TextureBinder binder { postProcess_ };
-    binder
-        .bind("renderedTexture", gbuffer_->get(0))
-        .bind("normalTexture", gbuffer_->get(1))
-        .bind("specularTexture", gbuffer_->get(2))
-        .bind("depthTexture", gbuffer_->get(3))
-        ;
+    TextureBinder binder { currentProgram_, state_, stats_ };
+    for (const auto& texture : textures) {
+        binder.bind(texture.first, texture.second);
+    }
+    drawMesh(*screenQuad_);
+}
 
-    drawMesh(screenQuad_);
+void Renderer::bindTargets(const std::vector<TargetId>& colors, int width,
+        int height) {
+    if (scratchFrameBuffer_ == 0) {
+        glGenFramebuffers(1, &scratchFrameBuffer_);
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, scratchFrameBuffer_);
+    std::size_t count = std::max(colors.size(), scratchTargets_);
+    std::vector<GLenum> buffers;
+    for (std::size_t i = 0; i < count; ++ i) {
+        GLuint tex = i < colors.size() ? colors[i] : 0;
+        glFramebufferTexture(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0 + i, tex, 0);
+        if (tex != 0) {
+            buffers.push_back(GL_COLOR_ATTACHMENT0 + i);
+        }
+    }
+    scratchTargets_ = colors.size();
+    glDrawBuffers(buffers.size(), buffers.data());
+    glViewport(0, 0, width, height);
 }
 
 
@@ -6,12 +6,24 @@
 #define ZEPHYR_GFX_RENDERER_H_
 
 #include <zephyr/core/Task.hpp>
+#include <zephyr/core/FrameArena.hpp>
 #include <zephyr/gfx/Viewport.hpp>
 #include <zephyr/gfx/objects.h>
 #include <zephyr/gfx/uniforms.hpp>
 #include <zephyr/gfx/UniformManager.hpp>
 #include <zephyr/gfx/FrameBuffer.hpp>
+#include <zephyr/gfx/RenderTargetPool.hpp>
+#include <zephyr/gfx/RenderGraph.hpp>
+#include <zephyr/gfx/ResizeFilter.hpp>
+#include <zephyr/gfx/FrameGlobals.hpp>
+#include <zephyr/gfx/FrameUniformRing.hpp>
+#include <zephyr/gfx/RenderQueue.hpp>
+#include <zephyr/gfx/RenderCommands.hpp>
+#include <zephyr/gfx/StateCache.hpp>
 #include <zephyr/resources/ResourceSystem.hpp>
+#include <zephyr/window/Surface.hpp>
+#include <initializer_list>
+#include <utility>
 #include <vector>
 #include <unordered_map>
 
@@ -22,7 +34,17 @@ namespace gfx {
 class Renderer {
 public:
 
-    Renderer(ResourceSystem& res);
+    /**
+     * @param res Resources used by the renderer
+     * @param surface Destination of the rendered frames
+     * @param gbuffer Formats of the G-buffer targets - color, normal,
+     *        specular and linear depth, in this order
+     * @param arena Allocator of the per-frame data
+     */
+    Renderer(ResourceSystem& res, window::Surface& surface,
+            FrameBufferLayout gbuffer, core::FrameArena& arena);
+
+    ~Renderer();
 
     void render();
 
@@ -41,14 +63,118 @@ public:
         postRenderHooks_.push_back(std::move(hook));
     }
 
+    /** Targets of the frame, as seen by the render graph */
+    struct FrameTargets {
+        ResourceId color;
+        ResourceId normal;
+        ResourceId specular;
+        ResourceId depthLinear;
+        ResourceId depth;
+        ResourceId output;
+    };
+
+    /**
+     * Adds passes to the graph, returning the targets with @c color possibly
+     * replaced by the factory's own target.
+     */
+    typedef std::function<FrameTargets (RenderGraph&, FrameTargets)>
+            PassFactory;
+
+    /**
+     * Adds passes to the render graph, between the geometry pass and the post
+     * processing. Color returned by the factory is used as input of the
+     * next one and of the post processing. Graph is built again when the
+     * passes change, and executed each frame, so the passes shall capture
+     * the targets by value. Passes whose results are not used are culled.
+     */
+    void addPasses(PassFactory factory) {
+        passFactories_.push_back(std::move(factory));
+        graphDirty_ = true;
+    }
+
+    /**
+     * Binds the render graph targets as color attachments of the scratch
+     * framebuffer and sets the viewport, for passes rendering into transient
+     * targets.
+     */
+    void bindTargets(const std::vector<TargetId>& colors, int width,
+            int height);
+
+    /**
+     * Draws a quad covering the viewport with the program, sampling given
+     * targets, for full-screen passes of the render graph.
+     */
+    void drawScreenQuad(const ProgramPtr& program,
+            std::initializer_list<std::pair<UniformName, TargetId>> textures);
+
+    /**
+     * Adds the item to the next rendered frame. Shall be called from the
+     * thread rendering the frame, before @ref render(). Other threads should
+     * use @ref commands().
+     */
     void submit(Renderable renderable) {
         renderables_.push_back(std::move(renderable));
     }
 
+    /**
+     * @return Recorder of the commands for the next frame, writing into the
+     *         calling thread's buffer. May be used concurrently by any number
+     *         of threads, also while the current frame is rendered.
+     */
+    CommandRecorder commands() {
+        return CommandRecorder { commands_.local() };
+    }
+
+    /**
+     * Closes recording of the next frame, making the commands and the frame
+     * globals available to @ref render(). Shall not run concurrently with
+     * recording nor rendering.
+     */
+    void swapCommands();
+
     UniformManager& uniforms() {
         return uniforms_;
     }
 
+    /**
+     * @return Per-frame values shared by all the programs, uploaded at the
+     *         beginning of each frame. View matrix is also used to sort
+     *         submitted items by depth. Like the commands, values written
+     *         here are used by the frame rendered after the next
+     *         @ref swapCommands().
+     */
+    FrameGlobals& frameGlobals() {
+        return recordedGlobals_;
+    }
+
+    /**
+     * @return Cache of the GL state, to be used by the code issuing GL
+     *         calls during rendering
+     */
+    StateCache& state() {
+        return state_;
+    }
+
+    /**
+     * @return Pool of render targets, to be used for transient targets of
+     *         additional passes
+     */
+    RenderTargetPool& targets() {
+        return *targets_;
+    }
+
+    /** @return Formats of the G-buffer targets */
+    const FrameBufferLayout& gbufferLayout() const {
+        return gbufferLayout_;
+    }
+
+    /**
+     * @return State changes performed while drawing the last frame
+     */
+    const RenderStats& stats() const {
+        return stats_;
+    }
+
 private:
 
     bool isLoaded(const ProgramPtr& program) const {
@@ -71,10 +197,22 @@ private:
     void updateViewport();
     void clearBuffers();
     void toggleVSync();
-    void drawMesh(const MeshPtr& mesh);
-    void setMaterial(const MaterialPtr& material);
+    void drawMesh(const Mesh& mesh);
+    void bindMesh(const Mesh& mesh);
+    void drawBoundMesh(const Mesh& mesh, GLsizei instances = 1);
+    void releaseRenderables();
+    void replayCommands();
+    void sortRenderables();
+    bool instanced(const Renderable& item) const;
+    void writeFrameUniforms();
+    void drawRenderables();
+    void buildGraph();
+    void bindFrameTargets();
+    void geometryPass();
+    void postProcessPass(const RenderGraph::PassContext& ctx,
+            const FrameTargets& targets);
+    void setMaterial(const Material& material);
     void setProgram(const ProgramPtr& program);
-    void setModelTransform(const glm::mat4& transform);
     void setUniformsForCurrentProgram();
 
     void hack_skybox();
@@ -83,18 +221,71 @@ private:
     MeshPtr hack_box_;
 
     Viewport viewport_;
-    ResourceSystem resources_;
+    ResourceSystem& resources_;
+    window::Surface& surface_;
 
     bool vsync_ = true;
 
+    /** Size of the surface, followed by the G-buffer with a delay */
+    int outputWidth_ = 0;
+    int outputHeight_ = 0;
+    ResizeFilter resize_;
+
+    std::unique_ptr<RenderTargetPool> targets_;
+    FrameBufferLayout gbufferLayout_;
     std::unique_ptr<FrameBuffer> gbuffer_;
     ProgramPtr postProcess_;
     MeshPtr screenQuad_;
 
-    std::vector<Renderable> renderables_;
+    /** Items of the current frame, in memory of the frame arena */
+    core::FrameVector<Renderable> renderables_;
+
+    /** Number of items in the previous frame, to allocate it at once */
+    std::size_t lastRenderableCount_ = 0;
+
+    /** Values used by the frame being rendered */
+    FrameGlobals globals_;
+
+    /** Values being prepared for the next frame */
+    FrameGlobals recordedGlobals_;
+
+    CommandQueue commands_;
+
+    std::unique_ptr<FrameUniformRing> ring_;
+
+    /**
+     * Offsets of the per-object or per-instance blocks in the ring, one for
+     * each batch of the queue
+     */
+    std::vector<GLintptr> batchOffsets_;
+
+    /** Model matrices of the batch being written */
+    std::vector<glm::mat4> instanceTransforms_;
+
+    GLuint globalsBinding_;
+    GLuint objectBinding_;
+    GLuint instanceBinding_;
+
+    RenderQueue queue_;
+    KeyIds programIds_ { RenderQueue::PROGRAM_BITS };
+
+    RenderStats stats_;
+
+    StateCache state_;
 
     std::vector<PreRenderHook> preRenderHooks_;
     std::vector<PostRenderHook> postRenderHooks_;
+    std::vector<PassFactory> passFactories_;
+
+    /** Graph of the frame, rebuilt only when the passes change */
+    RenderGraph graph_;
+    bool graphDirty_ = true;
+
+    /** Imported targets of the graph, bound to the G-buffer each frame */
+    FrameTargets importedTargets_;
+
+    GLuint scratchFrameBuffer_ = 0;
+    std::size_t scratchTargets_ = 0;
 
     UniformManager uniforms_;
 
@@ -0,0 +1,87 @@
+/**
+ * @file ResizeFilter.hpp
+ */
+
+#ifndef ZEPHYR_GFX_RESIZEFILTER_HPP_
+#define ZEPHYR_GFX_RESIZEFILTER_HPP_
+
+#include <chrono>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * Hysteresis for size-dependent resources. While the window is being
+ * resized, its size changes every frame - instead of following it, the new
+ * size is accepted only once it stays the same for the specified time.
+ * The first size is accepted immediately, empty sizes (minimized window)
+ * are ignored.
+ */
+class ResizeFilter {
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    explicit ResizeFilter(Clock::duration delay = std::chrono::milliseconds(150))
+    : delay_ { delay }
+    { }
+
+    /**
+     * Feeds the current size.
+     *
+     * @return @c true if the accepted size has changed
+     */
+    bool update(int width, int height, Clock::time_point now) {
+        if (width <= 0 || height <= 0) {
+            return false;
+        }
+        if (width == width_ && height == height_) {
+            pending_ = false;
+            return false;
+        }
+        if (!pending_ || width != pendingWidth_ || height != pendingHeight_) {
+            pending_ = true;
+            pendingWidth_ = width;
+            pendingHeight_ = height;
+            since_ = now;
+        }
+        if (width_ < 0 || now - since_ >= delay_) {
+            width_ = width;
+            height_ = height;
+            pending_ = false;
+            return true;
+        }
+        return false;
+    }
+
+    /** Accepted width, -1 before the first update */
+    int width() const {
+        return width_;
+    }
+
+    /** Accepted height, -1 before the first update */
+    int height() const {
+        return height_;
+    }
+
+    /** Whether there is a size change waiting to be accepted */
+    bool pending() const {
+        return pending_;
+    }
+
+private:
+    Clock::duration delay_;
+
+    int width_ = -1;
+    int height_ = -1;
+
+    bool pending_ = false;
+    int pendingWidth_ = 0;
+    int pendingHeight_ = 0;
+    Clock::time_point since_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_RESIZEFILTER_HPP_ */
@@ -0,0 +1,199 @@
+/**
+ * @file StateCache.cpp
+ */
+
+#include <zephyr/gfx/StateCache.hpp>
+#include <algorithm>
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+/** Index of the texture target in the per-unit table, or -1 */
+int targetIndex(GLenum target) {
+    switch (target) {
+    case GL_TEXTURE_1D: return 0;
+    case GL_TEXTURE_2D: return 1;
+    case GL_TEXTURE_3D: return 2;
+    case GL_TEXTURE_CUBE_MAP: return 3;
+    default: return -1;
+    }
+}
+
+/** Value of unknown enum state, never valid for the tracked settings */
+const GLenum UNKNOWN_ENUM = 0;
+
+} /* namespace */
+
+
+SamplerCache::~SamplerCache() {
+    for (const auto& entry : samplers_) {
+        glDeleteSamplers(1, &entry.second);
+    }
+}
+
+GLuint SamplerCache::get(const SamplerState& state) {
+    auto it = samplers_.find(state);
+    if (it != end(samplers_)) {
+        return it->second;
+    }
+    GLuint sampler;
+    glGenSamplers(1, &sampler);
+    glSamplerParameteri(sampler, GL_TEXTURE_MIN_FILTER, state.minFilter);
+    glSamplerParameteri(sampler, GL_TEXTURE_MAG_FILTER, state.magFilter);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_S, state.wrapS);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_T, state.wrapT);
+    glSamplerParameteri(sampler, GL_TEXTURE_WRAP_R, state.wrapR);
+    samplers_.emplace(state, sampler);
+    return sampler;
+}
+
+std::size_t SamplerCache::Hash::operator () (const SamplerState& s) const {
+    std::size_t h = s.minFilter;
+    for (GLenum v : { s.magFilter, s.wrapS, s.wrapT, s.wrapR }) {
+        h = h * 31 + v;
+    }
+    return h;
+}
+
+
+constexpr int StateCache::MAX_UNITS;
+constexpr GLuint StateCache::UNKNOWN;
+constexpr int StateCache::TARGETS;
+
+
+StateCache::StateCache() {
+    invalidate();
+}
+
+void StateCache::invalidate() {
+    program_ = UNKNOWN;
+    vao_ = UNKNOWN;
+    activeUnit_ = -1;
+    for (auto& unit : textures_) {
+        std::fill(std::begin(unit), std::end(unit), UNKNOWN);
+    }
+    std::fill(std::begin(samplerBindings_), std::end(samplerBindings_),
+            UNKNOWN);
+
+    cullFace_ = -1;
+    cullMode_ = UNKNOWN_ENUM;
+    frontFace_ = UNKNOWN_ENUM;
+    depthTest_ = -1;
+    depthMask_ = -1;
+    depthFunc_ = UNKNOWN_ENUM;
+}
+
+bool StateCache::useProgram(GLuint program) {
+    if (program_ == program) {
+        return false;
+    }
+    glUseProgram(program);
+    program_ = program;
+    return true;
+}
+
+bool StateCache::bindVertexArray(GLuint vao) {
+    if (vao_ == vao) {
+        return false;
+    }
+    glBindVertexArray(vao);
+    vao_ = vao;
+    return true;
+}
+
+bool StateCache::activeTexture(int unit) {
+    if (activeUnit_ == unit) {
+        return false;
+    }
+    glActiveTexture(GL_TEXTURE0 + unit);
+    activeUnit_ = unit;
+    return true;
+}
+
+bool StateCache::bindTexture(int unit, GLenum target, GLuint texture) {
+    int index = targetIndex(target);
+    bool tracked = index >= 0 && unit >= 0 && unit < MAX_UNITS;
+    if (tracked) {
+        if (textures_[unit][index] == texture) {
+            return false;
+        }
+        textures_[unit][index] = texture;
+    }
+    activeTexture(unit);
+    glBindTexture(target, texture);
+    return true;
+}
+
+bool StateCache::bindSampler(int unit, GLuint sampler) {
+    bool tracked = unit >= 0 && unit < MAX_UNITS;
+    if (tracked) {
+        if (samplerBindings_[unit] == sampler) {
+            return false;
+        }
+        samplerBindings_[unit] = sampler;
+    }
+    glBindSampler(unit, sampler);
+    return true;
+}
+
+bool StateCache::setFlag(int& current, bool enabled, GLenum capability) {
+    if (current == static_cast<int>(enabled)) {
+        return false;
+    }
+    if (enabled) {
+        glEnable(capability);
+    } else {
+        glDisable(capability);
+    }
+    current = enabled;
+    return true;
+}
+
+bool StateCache::cullFace(bool enabled) {
+    return setFlag(cullFace_, enabled, GL_CULL_FACE);
+}
+
+bool StateCache::cullMode(GLenum face) {
+    if (cullMode_ == face) {
+        return false;
+    }
+    glCullFace(face);
+    cullMode_ = face;
+    return true;
+}
+
+bool StateCache::frontFace(GLenum mode) {
+    if (frontFace_ == mode) {
+        return false;
+    }
+    glFrontFace(mode);
+    frontFace_ = mode;
+    return true;
+}
+
+bool StateCache::depthTest(bool enabled) {
+    return setFlag(depthTest_, enabled, GL_DEPTH_TEST);
+}
+
+bool StateCache::depthMask(bool enabled) {
+    if (depthMask_ == static_cast<int>(enabled)) {
+        return false;
+    }
+    glDepthMask(enabled ? GL_TRUE : GL_FALSE);
+    depthMask_ = enabled;
+    return true;
+}
+
+bool StateCache::depthFunc(GLenum func) {
+    if (depthFunc_ == func) {
+        return false;
+    }
+    glDepthFunc(func);
+    depthFunc_ = func;
+    return true;
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,164 @@
+/**
+ * @file StateCache.hpp
+ */
+
+#ifndef ZEPHYR_GFX_STATECACHE_HPP_
+#define ZEPHYR_GFX_STATECACHE_HPP_
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <cstdint>
+#include <unordered_map>
+
+
+namespace zephyr {
+namespace gfx {
+
+/**
+ * Filtering and wrapping parameters of a sampler object.
+ */
+struct SamplerState {
+    GLenum minFilter;
+    GLenum magFilter;
+    GLenum wrapS;
+    GLenum wrapT;
+    GLenum wrapR;
+
+    /** Nearest filtering, clamped to edge - used for the render targets */
+    static SamplerState nearestClamp() {
+        return { GL_NEAREST, GL_NEAREST, GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE,
+            GL_CLAMP_TO_EDGE };
+    }
+
+    static SamplerState linearRepeat() {
+        return { GL_LINEAR, GL_LINEAR, GL_REPEAT, GL_REPEAT, GL_REPEAT };
+    }
+};
+
+inline bool operator == (const SamplerState& a, const SamplerState& b) {
+    return a.minFilter == b.minFilter && a.magFilter == b.magFilter
+        && a.wrapS == b.wrapS && a.wrapT == b.wrapT && a.wrapR == b.wrapR;
+}
+
+
+/**
+ * Sampler objects created on demand, one per distinct @ref SamplerState, and
+ * reused afterwards. Owns the samplers, requires current GL context when
+ * destroyed.
+ */
+class SamplerCache {
+public:
+
+    SamplerCache() = default;
+
+    SamplerCache(const SamplerCache&) = delete;
+    SamplerCache& operator = (const SamplerCache&) = delete;
+
+    ~SamplerCache();
+
+    /**
+     * @return Sampler object with the specified parameters
+     */
+    GLuint get(const SamplerState& state);
+
+    std::size_t size() const {
+        return samplers_.size();
+    }
+
+private:
+    struct Hash {
+        std::size_t operator () (const SamplerState& state) const;
+    };
+
+    std::unordered_map<SamplerState, GLuint, Hash> samplers_;
+};
+
+
+/**
+ * Shadow copy of the bound GL state. Setters issue GL calls only if the value
+ * differs from the one known to be set, and report whether they did.
+ *
+ * Initially, and after @ref invalidate(), nothing is known and every setter
+ * reaches GL. Code changing the state directly, not through the cache (e.g.
+ * texture and mesh creation), leaves the cache stale - call @ref invalidate()
+ * afterwards.
+ */
+class StateCache {
+public:
+
+    /** Number of texture units tracked, binds to the others always go to GL */
+    static constexpr int MAX_UNITS = 16;
+
+    StateCache();
+
+    /** Forgets all the known state */
+    void invalidate();
+
+    bool useProgram(GLuint program);
+
+    bool bindVertexArray(GLuint vao);
+
+    /**
+     * Binds the texture to the unit, making the unit active if needed.
+     *
+     * @param target One of @c GL_TEXTURE_1D, @c GL_TEXTURE_2D,
+     *        @c GL_TEXTURE_3D or @c GL_TEXTURE_CUBE_MAP; other targets are
+     *        not tracked
+     */
+    bool bindTexture(int unit, GLenum target, GLuint texture);
+
+    bool bindSampler(int unit, GLuint sampler);
+
+    /** Binds sampler with specified parameters, created if necessary */
+    bool bindSampler(int unit, const SamplerState& state) {
+        return bindSampler(unit, samplers_.get(state));
+    }
+
+    bool activeTexture(int unit);
+
+    bool cullFace(bool enabled);
+
+    bool cullMode(GLenum face);
+
+    bool frontFace(GLenum mode);
+
+    bool depthTest(bool enabled);
+
+    bool depthMask(bool enabled);
+
+    bool depthFunc(GLenum func);
+
+    SamplerCache& samplers() {
+        return samplers_;
+    }
+
+private:
+    /** Value of the bound object name meaning "not known" */
+    static constexpr GLuint UNKNOWN = static_cast<GLuint>(-1);
+
+    /** Number of texture targets tracked per unit */
+    static constexpr int TARGETS = 4;
+
+    /** Tri-state flag, stored as -1 (unknown), 0 or 1 */
+    bool setFlag(int& current, bool enabled, GLenum capability);
+
+    GLuint program_;
+    GLuint vao_;
+    int activeUnit_;
+    GLuint textures_[MAX_UNITS][TARGETS];
+    GLuint samplerBindings_[MAX_UNITS];
+
+    int cullFace_;
+    GLenum cullMode_;
+    GLenum frontFace_;
+    int depthTest_;
+    int depthMask_;
+    GLenum depthFunc_;
+
+    SamplerCache samplers_;
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_STATECACHE_HPP_ */
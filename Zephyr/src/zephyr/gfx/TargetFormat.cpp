@@ -0,0 +1,134 @@
+/**
+ * @file TargetFormat.cpp
+ */
+
+#include <zephyr/gfx/TargetFormat.hpp>
+#include <zephyr/util/format.hpp>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+struct FormatInfo {
+    TargetFormat format;
+    const char* name;
+    std::size_t size;
+    bool depth;
+    bool stencil;
+};
+
+const FormatInfo FORMATS[] = {
+    { TargetFormat::RGBA32F,    "RGBA32F",    16, false, false },
+    { TargetFormat::RGBA16F,    "RGBA16F",     8, false, false },
+    { TargetFormat::RGBA8,      "RGBA8",       4, false, false },
+    { TargetFormat::RGB10A2,    "RGB10A2",     4, false, false },
+    { TargetFormat::R11G11B10F, "R11G11B10F",  4, false, false },
+    { TargetFormat::RG16F,      "RG16F",       4, false, false },
+    { TargetFormat::R32F,       "R32F",        4, false, false },
+    { TargetFormat::R16F,       "R16F",        2, false, false },
+    { TargetFormat::D32F,       "D32F",        4, true,  false },
+    { TargetFormat::D24,        "D24",         4, true,  false },
+    { TargetFormat::D24S8,      "D24S8",       4, true,  true  },
+};
+
+const FormatInfo& info(TargetFormat format) {
+    return FORMATS[static_cast<std::size_t>(format)];
+}
+
+double megabytes(std::size_t bytes) {
+    return bytes / (1024.0 * 1024.0);
+}
+
+} /* namespace */
+
+
+std::size_t texelSize(TargetFormat format) {
+    return info(format).size;
+}
+
+const char* formatName(TargetFormat format) {
+    return info(format).name;
+}
+
+bool isDepthFormat(TargetFormat format) {
+    return info(format).depth;
+}
+
+bool hasStencil(TargetFormat format) {
+    return info(format).stencil;
+}
+
+TargetFormat parseTargetFormat(const std::string& name) {
+    for (const FormatInfo& format : FORMATS) {
+        if (name == format.name) {
+            return format.format;
+        }
+    }
+    throw std::runtime_error(util::format("Unknown target format '{}'", name));
+}
+
+
+FrameBufferLayout FrameBufferLayout::uniform(std::size_t targets,
+        TargetFormat color, TargetFormat depth) {
+    FrameBufferLayout layout;
+    for (std::size_t i = 0; i < targets; ++ i) {
+        layout.colors.push_back({ util::format("target{}", i), color });
+    }
+    layout.depth.format = depth;
+    return layout;
+}
+
+std::size_t FrameBufferLayout::bytes(int width, int height) const {
+    std::size_t texel = texelSize(depth.format);
+    for (const TargetDesc& target : colors) {
+        texel += texelSize(target.format);
+    }
+    return texel * width * height;
+}
+
+void FrameBufferLayout::validate() const {
+    for (const TargetDesc& target : colors) {
+        if (isDepthFormat(target.format)) {
+            throw std::runtime_error(util::format("Color target '{}' has "
+                    "depth format {}", target.name, formatName(target.format)));
+        }
+    }
+    if (!isDepthFormat(depth.format)) {
+        throw std::runtime_error(util::format("Depth buffer has color "
+                "format {}", formatName(depth.format)));
+    }
+}
+
+
+std::string memoryReport(const FrameBufferLayout& layout, int width,
+        int height) {
+    std::size_t pixels = std::size_t(width) * height;
+    FrameBufferLayout baseline = FrameBufferLayout::uniform(
+            layout.colors.size());
+
+    std::ostringstream os;
+    os << std::fixed << std::setprecision(1);
+    os << width << "x" << height << ":";
+
+    auto describe = [&](const TargetDesc& target) {
+        os << " " << target.name << "=" << formatName(target.format) << " ("
+           << megabytes(texelSize(target.format) * pixels) << " MB)";
+    };
+    for (const TargetDesc& target : layout.colors) {
+        describe(target);
+    }
+    describe(layout.depth);
+
+    std::size_t total = layout.bytes(width, height);
+    std::size_t full = baseline.bytes(width, height);
+    os << ", total " << megabytes(total) << " MB, "
+       << megabytes(full) << " MB with RGBA32F targets";
+    return os.str();
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
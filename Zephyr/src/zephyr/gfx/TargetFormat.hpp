@@ -0,0 +1,107 @@
+/**
+ * @file TargetFormat.hpp
+ */
+
+#ifndef ZEPHYR_GFX_TARGETFORMAT_HPP_
+#define ZEPHYR_GFX_TARGETFORMAT_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace zephyr {
+namespace gfx {
+
+/** Storage format of a render target */
+enum class TargetFormat {
+    RGBA32F,
+    RGBA16F,
+    RGBA8,
+    RGB10A2,
+    R11G11B10F,
+    RG16F,
+    R32F,
+    R16F,
+    D32F,
+    D24,
+    D24S8
+};
+
+/**
+ * @return Size of single texel, in bytes
+ */
+std::size_t texelSize(TargetFormat format);
+
+/**
+ * @return Name of the format, as accepted by @ref parseTargetFormat()
+ */
+const char* formatName(TargetFormat format);
+
+/**
+ * @return Whether the format can be used as depth attachment
+ */
+bool isDepthFormat(TargetFormat format);
+
+/**
+ * @return Whether the format has stencil component
+ */
+bool hasStencil(TargetFormat format);
+
+/**
+ * Converts the format name (e.g. "RG16F") to the format.
+ *
+ * @throws std::runtime_error if the name is unknown
+ */
+TargetFormat parseTargetFormat(const std::string& name);
+
+
+/** Single named attachment of the framebuffer */
+struct TargetDesc {
+    std::string name;
+    TargetFormat format;
+};
+
+
+/**
+ * Formats of all the attachments of a framebuffer - color targets, in the
+ * order of attachment points, and the depth buffer.
+ */
+struct FrameBufferLayout {
+    std::vector<TargetDesc> colors;
+    TargetDesc depth { "depth", TargetFormat::D32F };
+
+    /**
+     * Layout with @c targets color attachments of the same format.
+     */
+    static FrameBufferLayout uniform(std::size_t targets,
+            TargetFormat color = TargetFormat::RGBA32F,
+            TargetFormat depth = TargetFormat::D32F);
+
+    /**
+     * @return Memory taken by the attachments of given size, in bytes
+     */
+    std::size_t bytes(int width, int height) const;
+
+    /**
+     * Checks that the color targets use color formats, and the depth buffer
+     * uses a depth format.
+     *
+     * @throws std::runtime_error if it is not the case
+     */
+    void validate() const;
+};
+
+
+/**
+ * @return Human-readable summary of the memory used by the attachments of
+ *         given size, compared to the same targets in RGBA32F with 32-bit
+ *         float depth
+ */
+std::string memoryReport(const FrameBufferLayout& layout, int width,
+        int height);
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_TARGETFORMAT_HPP_ */
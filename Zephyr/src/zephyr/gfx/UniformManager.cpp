@@ -3,12 +3,84 @@
  */
 
 #include <zephyr/gfx/UniformManager.hpp>
+#include <zephyr/util/format.hpp>
+#include <cstring>
+#include <stdexcept>
 
 namespace zephyr {
 namespace gfx {
 
+void UniformValue::upload(GLint location) const {
+    switch (type) {
+    case UniformType::NONE: break;
+    case UniformType::FLOAT1: glUniform1fv(location, 1, f); break;
+    case UniformType::FLOAT2: glUniform2fv(location, 1, f); break;
+    case UniformType::FLOAT3: glUniform3fv(location, 1, f); break;
+    case UniformType::FLOAT4: glUniform4fv(location, 1, f); break;
+    case UniformType::INT1: glUniform1iv(location, 1, i); break;
+    case UniformType::INT2: glUniform2iv(location, 1, i); break;
+    case UniformType::INT3: glUniform3iv(location, 1, i); break;
+    case UniformType::INT4: glUniform4iv(location, 1, i); break;
+    case UniformType::UINT1: glUniform1uiv(location, 1, u); break;
+    case UniformType::UINT2: glUniform2uiv(location, 1, u); break;
+    case UniformType::UINT3: glUniform3uiv(location, 1, u); break;
+    case UniformType::UINT4: glUniform4uiv(location, 1, u); break;
+    case UniformType::MAT2: glUniformMatrix2fv(location, 1, transpose, f); break;
+    case UniformType::MAT3: glUniformMatrix3fv(location, 1, transpose, f); break;
+    case UniformType::MAT4: glUniformMatrix4fv(location, 1, transpose, f); break;
+    case UniformType::MAT2x3: glUniformMatrix2x3fv(location, 1, transpose, f); break;
+    case UniformType::MAT3x2: glUniformMatrix3x2fv(location, 1, transpose, f); break;
+    case UniformType::MAT2x4: glUniformMatrix2x4fv(location, 1, transpose, f); break;
+    case UniformType::MAT4x2: glUniformMatrix4x2fv(location, 1, transpose, f); break;
+    case UniformType::MAT3x4: glUniformMatrix3x4fv(location, 1, transpose, f); break;
+    case UniformType::MAT4x3: glUniformMatrix4x3fv(location, 1, transpose, f); break;
+    }
+}
 
 
+std::size_t UniformManager::upload(const Program& program) const {
+    std::size_t uploaded = 0;
+    for (const UniformBinding& binding : program.uniformTable()) {
+        auto it = index_.find(binding.id);
+        if (it == end(index_)) {
+            continue;
+        }
+        const Slot& slot = slots_[it->second];
+        if (binding.uploaded != slot.version) {
+            slot.value.upload(binding.location);
+            binding.uploaded = slot.version;
+            ++ uploaded;
+        }
+    }
+    return uploaded;
+}
+
+void UniformManager::store(UniformName name, UniformType type,
+        const void* data, std::size_t size, bool transpose) {
+    GLboolean glTranspose = transpose ? GL_TRUE : GL_FALSE;
+
+    auto it = index_.find(name.id);
+    if (it == end(index_)) {
+        std::uint32_t index = static_cast<std::uint32_t>(slots_.size());
+        slots_.push_back(Slot { name.name, UniformValue { }, 0 });
+        it = index_.emplace(name.id, index).first;
+    }
+    Slot& slot = slots_[it->second];
+    if (slot.name != name.name) {
+        throw std::runtime_error(util::format(
+                "Uniforms \"{}\" and \"{}\" have the same id",
+                slot.name, name.name));
+    }
+    UniformValue& value = slot.value;
+    if (value.type == type && value.transpose == glTranspose
+            && std::memcmp(value.f, data, size) == 0) {
+        return;
+    }
+    value.type = type;
+    value.transpose = glTranspose;
+    std::memcpy(value.f, data, size);
+    slot.version = ++ clock_;
+}
 
 } /* namespace gfx */
 } /* namespace zephyr */
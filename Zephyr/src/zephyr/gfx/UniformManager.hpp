@@ -6,35 +6,88 @@
 #define ZEPHYR_GFX_UNIFORMMANAGER_HPP_
 
 #include <zephyr/gfx/uniforms.hpp>
+#include <zephyr/gfx/UniformName.hpp>
+#include <zephyr/gfx/Program.hpp>
 #include <GL/glew.h>
 #include <GL/gl.h>
+#include <glm/glm.hpp>
+#include <glm/ext.hpp>
+#include <cstdint>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 
 namespace zephyr {
 namespace gfx {
 
+/** Type of the value stored in @ref UniformValue */
+enum class UniformType : std::uint8_t {
+    NONE,
+    FLOAT1, FLOAT2, FLOAT3, FLOAT4,
+    INT1, INT2, INT3, INT4,
+    UINT1, UINT2, UINT3, UINT4,
+    MAT2, MAT3, MAT4,
+    MAT2x3, MAT3x2, MAT2x4, MAT4x2, MAT3x4, MAT4x3
+};
+
+
+/**
+ * Value of a single uniform variable, stored in place. Large enough for
+ * 4x4 matrix.
+ */
+struct UniformValue {
+    UniformType type = UniformType::NONE;
+    GLboolean transpose = GL_FALSE;
+    union {
+        GLfloat f[16];
+        GLint i[4];
+        GLuint u[4];
+    };
+
+    /** Sends the value to the specified location of the current program */
+    void upload(GLint location) const;
+};
+
+
 class UniformManager {
 public:
 
-    void set(std::string name, UniformPtr uniform) {
-        using std::move;
-        uniforms_[move(name)] = move(uniform);
-    }
-
-    Uniform* get(const std::string& name) {
-        auto it = uniforms_.find(name);
-        if (it != end(uniforms_)) {
-            return it->second.get();
+    /**
+     * Uploads values of the uniforms used by the program, that changed since
+     * they were last uploaded to it. Program needs to be current.
+     *
+     * @return Number of values uploaded
+     */
+    std::size_t upload(const Program& program) const;
+
+    /**
+     * @return Current value of the uniform, or @c nullptr if it has not been
+     *         set
+     */
+    const UniformValue* get(UniformId id) const {
+        auto it = index_.find(id);
+        if (it != end(index_)) {
+            return &slots_[it->second].value;
         } else {
             return nullptr;
         }
     }
 
-    GLuint registerBlock(const std::string& name, GLuint buffer,
-            std::size_t size) {
+    /**
+     * Assigns binding point to the uniform block, without attaching any
+     * buffer to it.
+     */
+    GLuint reserveBlock(const std::string& name) {
         GLuint index = nextBindingIndex_ ++;
         blocks_[name] = index;
+        return index;
+    }
+
+    GLuint registerBlock(const std::string& name, GLuint buffer,
+            std::size_t size) {
+        GLuint index = reserveBlock(name);
         buffers_[name] = buffer;
         glBindBufferRange(GL_UNIFORM_BUFFER, index, buffer, 0, size);
         return index;
@@ -66,128 +119,160 @@ public:
         glBindBuffer(GL_UNIFORM_BUFFER, 0);
     }
 
-    void set1f(std::string name, float v) {
-        set(std::move(name), std::make_shared<uniform1f>(v));
+    /**
+     * Replaces the value of the uniform with a complete value, e.g. one
+     * recorded in a command buffer.
+     */
+    void set(UniformName name, const UniformValue& value) {
+        store(name, value.type, value.f, sizeof value.f,
+                value.transpose == GL_TRUE);
     }
 
-    void set1f(std::string name, glm::vec1 v) {
-        set1f(std::move(name), v.x);
+    void set1f(UniformName name, float v) {
+        store(name, UniformType::FLOAT1, &v, sizeof v);
     }
 
-    void set2f(std::string name, float v1, float v2) {
-        set(std::move(name), std::make_shared<uniform2f>(v1, v2));
+    void set1f(UniformName name, glm::vec1 v) {
+        set1f(name, v.x);
     }
 
-    void set2f(std::string name, const glm::vec2& v) {
-        set2f(std::move(name), v.x, v.y);
+    void set2f(UniformName name, float v1, float v2) {
+        GLfloat v[] = { v1, v2 };
+        store(name, UniformType::FLOAT2, v, sizeof v);
     }
 
-    void set3f(std::string name, float v1, float v2, float v3) {
-        set(std::move(name), std::make_shared<uniform3f>(v1, v2, v3));
+    void set2f(UniformName name, const glm::vec2& v) {
+        set2f(name, v.x, v.y);
     }
 
-    void set3f(std::string name, const glm::vec3& v) {
-        set3f(std::move(name), v.x, v.y, v.z);
+    void set3f(UniformName name, float v1, float v2, float v3) {
+        GLfloat v[] = { v1, v2, v3 };
+        store(name, UniformType::FLOAT3, v, sizeof v);
     }
 
-    void set4f(std::string name, float v1, float v2, float v3, float v4) {
-        set(std::move(name), std::make_shared<uniform4f>(v1, v2, v3, v4));
+    void set3f(UniformName name, const glm::vec3& v) {
+        set3f(name, v.x, v.y, v.z);
     }
 
-    void set4f(std::string name, const glm::vec4& v) {
-        set4f(std::move(name), v.x, v.y, v.z, v.w);
+    void set4f(UniformName name, float v1, float v2, float v3, float v4) {
+        GLfloat v[] = { v1, v2, v3, v4 };
+        store(name, UniformType::FLOAT4, v, sizeof v);
     }
 
-    void set1i(std::string name, GLint v) {
-        set(std::move(name), std::make_shared<uniform1i>(v));
+    void set4f(UniformName name, const glm::vec4& v) {
+        set4f(name, v.x, v.y, v.z, v.w);
     }
 
-    void set2i(std::string name, GLint v1, GLint v2) {
-        set(std::move(name), std::make_shared<uniform2i>(v1, v2));
+    void set1i(UniformName name, GLint v) {
+        store(name, UniformType::INT1, &v, sizeof v);
     }
 
-    void set3i(std::string name, GLint v1, GLint v2, GLint v3) {
-        set(std::move(name), std::make_shared<uniform3i>(v1, v2, v3));
+    void set2i(UniformName name, GLint v1, GLint v2) {
+        GLint v[] = { v1, v2 };
+        store(name, UniformType::INT2, v, sizeof v);
     }
 
-    void set4i(std::string name, GLint v1, GLint v2, GLint v3, GLint v4) {
-        set(std::move(name), std::make_shared<uniform4i>(v1, v2, v3, v4));
+    void set3i(UniformName name, GLint v1, GLint v2, GLint v3) {
+        GLint v[] = { v1, v2, v3 };
+        store(name, UniformType::INT3, v, sizeof v);
     }
 
-    void set1ui(std::string name, GLuint v) {
-        set(std::move(name), std::make_shared<uniform1ui>(v));
+    void set4i(UniformName name, GLint v1, GLint v2, GLint v3, GLint v4) {
+        GLint v[] = { v1, v2, v3, v4 };
+        store(name, UniformType::INT4, v, sizeof v);
     }
 
-    void set2ui(std::string name, GLuint v1, GLuint v2) {
-        set(std::move(name), std::make_shared<uniform2ui>(v1, v2));
+    void set1ui(UniformName name, GLuint v) {
+        store(name, UniformType::UINT1, &v, sizeof v);
     }
 
-    void set3ui(std::string name, GLuint v1, GLuint v2, GLuint v3) {
-        set(std::move(name), std::make_shared<uniform3ui>(v1, v2, v3));
+    void set2ui(UniformName name, GLuint v1, GLuint v2) {
+        GLuint v[] = { v1, v2 };
+        store(name, UniformType::UINT2, v, sizeof v);
     }
 
-    void set4ui(std::string name, GLuint v1, GLuint v2, GLuint v3, GLuint v4) {
-        set(std::move(name), std::make_shared<uniform4ui>(v1, v2, v3, v4));
+    void set3ui(UniformName name, GLuint v1, GLuint v2, GLuint v3) {
+        GLuint v[] = { v1, v2, v3 };
+        store(name, UniformType::UINT3, v, sizeof v);
     }
 
-    void setMat2(std::string name, const glm::mat2& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix2f>(mat, count, transpose));
+    void set4ui(UniformName name, GLuint v1, GLuint v2, GLuint v3, GLuint v4) {
+        GLuint v[] = { v1, v2, v3, v4 };
+        store(name, UniformType::UINT4, v, sizeof v);
     }
 
-    void setMat3(std::string name, const glm::mat3& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix3f>(mat, count, transpose));
+    void setMat2(UniformName name, const glm::mat2& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT2, mat, transpose);
     }
 
-    void setMat4(std::string name, const glm::mat4& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix4f>(mat, count, transpose));
+    void setMat3(UniformName name, const glm::mat3& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT3, mat, transpose);
     }
 
-    void setMat2x3(std::string name, const glm::mat2x3& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix2x3f>(mat, count, transpose));
+    void setMat4(UniformName name, const glm::mat4& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT4, mat, transpose);
     }
 
-    void setMat3x2(std::string name, const glm::mat3x2& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix3x2f>(mat, count, transpose));
+    void setMat2x3(UniformName name, const glm::mat2x3& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT2x3, mat, transpose);
     }
 
-    void setMat2x4(std::string name, const glm::mat2x4& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix2x4f>(mat, count, transpose));
+    void setMat3x2(UniformName name, const glm::mat3x2& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT3x2, mat, transpose);
     }
 
-    void setMat4x2(std::string name, const glm::mat4x2& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix4x2f>(mat, count, transpose));
+    void setMat2x4(UniformName name, const glm::mat2x4& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT2x4, mat, transpose);
     }
 
-    void setMat4x3(std::string name, const glm::mat4x3& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix4x3f>(mat, count, transpose));
+    void setMat4x2(UniformName name, const glm::mat4x2& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT4x2, mat, transpose);
     }
 
-    void setMat3x4(std::string name, const glm::mat3x4& mat,
-            bool transpose = false, int count = 1) {
-        set(std::move(name),
-                std::make_shared<uniformMatrix3x4f>(mat, count, transpose));
+    void setMat4x3(UniformName name, const glm::mat4x3& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT4x3, mat, transpose);
+    }
+
+    void setMat3x4(UniformName name, const glm::mat3x4& mat,
+            bool transpose = false) {
+        storeMatrix(name, UniformType::MAT3x4, mat, transpose);
     }
 
 private:
-    typedef std::unordered_map<std::string, UniformPtr> UniformMap;
+    struct Slot {
+        std::string name;
+        UniformValue value;
+
+        /** Incremented with each change of the value */
+        std::uint32_t version;
+    };
+
+    /**
+     * Replaces the value of the uniform, if it differs from the current one.
+     */
+    void store(UniformName name, UniformType type, const void* data,
+            std::size_t size, bool transpose = false);
+
+    template <typename Matrix>
+    void storeMatrix(UniformName name, UniformType type, const Matrix& mat,
+            bool transpose) {
+        store(name, type, glm::value_ptr(mat), sizeof mat, transpose);
+    }
+
+    std::vector<Slot> slots_;
+
+    std::unordered_map<UniformId, std::uint32_t> index_;
 
-    UniformMap uniforms_;
+    /** Source of the value versions, unique across all the slots */
+    std::uint32_t clock_ = 0;
 
     std::unordered_map<std::string, GLuint> blocks_;
 
@@ -0,0 +1,57 @@
+/**
+ * @file UniformName.hpp
+ */
+
+#ifndef ZEPHYR_GFX_UNIFORMNAME_HPP_
+#define ZEPHYR_GFX_UNIFORMNAME_HPP_
+
+#include <zephyr/util/static_hash.hpp>
+#include <cstdint>
+#include <string>
+
+
+namespace zephyr {
+namespace gfx {
+
+/** Interned name of the uniform variable */
+typedef std::uint32_t UniformId;
+
+/**
+ * @return Id of the uniform with specified name
+ */
+constexpr UniformId uniformId(const char* name) {
+    return static_cast<UniformId>(util::static_hash(name));
+}
+
+inline UniformId uniformId(const std::string& name) {
+    return uniformId(name.c_str());
+}
+
+
+/**
+ * Uniform name together with its id. Declared @c constexpr, the id is
+ * computed at compile time:
+ *
+ *     constexpr UniformName SUN_COLOR { "sunColor" };
+ *
+ * Implicitly created from string literal, the id is computed at runtime, but
+ * no allocation takes place. Holds a pointer to the name, does not copy it.
+ */
+struct UniformName {
+    const char* name;
+    UniformId id;
+
+    constexpr UniformName(const char* name)
+    : name { name }
+    , id { uniformId(name) }
+    { }
+
+    UniformName(const std::string& name)
+    : UniformName { name.c_str() }
+    { }
+};
+
+} /* namespace gfx */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_GFX_UNIFORMNAME_HPP_ */
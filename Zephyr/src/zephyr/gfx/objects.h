@@ -11,6 +11,8 @@
 #include <zephyr/gfx/uniforms.hpp>
 #include <zephyr/resources/ResourceManager.hpp>
 #include <zephyr/gfx/Program.hpp>
+#include <zephyr/gfx/Bounds.hpp>
+#include <zephyr/util/Pool.hpp>
 #include <GL/glew.h>
 #include <GL/gl.h>
 #include <glm/glm.hpp>
@@ -24,11 +26,13 @@ using namespace zephyr::resources;
 
 typedef std::shared_ptr<struct Mesh> MeshPtr;
 typedef std::shared_ptr<struct Texture> TexturePtr;
-typedef std::shared_ptr<struct Material> MaterialPtr;
-typedef std::shared_ptr<struct Entity> EntityPtr;
 typedef std::shared_ptr<struct Object> ObjectPtr;
 typedef std::weak_ptr<struct Object> WeakObjectPtr;
 
+typedef util::Handle<struct Mesh> MeshHandle;
+typedef util::Handle<struct Material> MaterialHandle;
+typedef util::Handle<struct Entity> EntityHandle;
+
 enum class Primitive {
     POINTS         = GL_POINTS,
     LINES          = GL_LINES,
@@ -44,13 +48,20 @@ inline GLenum primitiveToGL(Primitive primitive) {
 }
 
 
-struct Mesh: public std::enable_shared_from_this<Mesh> {
+/**
+ * Vertex array object with the parameters of the draw call. Owns the VAO,
+ * can be moved but not copied.
+ */
+struct Mesh {
     GLuint id;
     std::size_t count;
     bool indexed;
     GLenum indexType;
     Primitive mode;
 
+    /** Model-space bounds, empty if unknown */
+    Bounds bounds;
+
     Mesh(GLuint id, std::size_t count, bool indexed,
             GLenum indexType, Primitive mode = Primitive::TRIANGLES)
     : id(id)
@@ -60,7 +71,36 @@ struct Mesh: public std::enable_shared_from_this<Mesh> {
     , mode(mode)
     { }
 
+    Mesh(Mesh&& other)
+    : id(other.id)
+    , count(other.count)
+    , indexed(other.indexed)
+    , indexType(other.indexType)
+    , mode(other.mode)
+    , bounds(other.bounds)
+    {
+        other.id = 0;
+    }
+
+    Mesh& operator = (Mesh&& other) {
+        if (this != &other) {
+            glDeleteVertexArrays(1, &id);
+            id = other.id;
+            count = other.count;
+            indexed = other.indexed;
+            indexType = other.indexType;
+            mode = other.mode;
+            bounds = other.bounds;
+            other.id = 0;
+        }
+        return *this;
+    }
+
+    Mesh(const Mesh&) = delete;
+    Mesh& operator = (const Mesh&) = delete;
+
     ~Mesh() {
+        // deleting 0 is ignored, so moved-from meshes are fine
         glDeleteVertexArrays(1, &id);
     }
 };
@@ -107,15 +147,23 @@ TexturePtr newTexture(Args&&... args) {
     return std::make_shared<Texture>(std::forward<Args>(args)...);
 }
 
-struct Material: public std::enable_shared_from_this<Material> {
+struct Material {
 
-    typedef std::vector<std::pair<std::string, UniformPtr>> UniformMap;
+    /** Values of the uniforms, by ids interned when the material is loaded */
+    typedef std::vector<std::pair<UniformId, UniformPtr>> UniformMap;
     typedef std::vector<std::pair<GLint, TexturePtr>> TextureMap;
 
     ProgramPtr program;
     UniformMap uniforms;
     TextureMap textures;
 
+    /**
+     * Whether the objects using this material can be drawn with a single
+     * instanced draw call. Program needs to read model matrices from the
+     * @c InstanceTransforms block instead of @c ObjectTransforms.
+     */
+    bool instanced = false;
+
 
     explicit Material(ProgramPtr program,
             UniformMap uniforms = UniformMap { },
@@ -128,37 +176,38 @@ struct Material: public std::enable_shared_from_this<Material> {
 };
 
 
-template <typename... Args>
-MaterialPtr newMaterial(Args&&... args) {
-    return std::make_shared<Material>(std::forward<Args>(args)...);
-}
-
-
-struct Entity: public std::enable_shared_from_this<Entity> {
-    MaterialPtr material;
-    MeshPtr mesh;
+/**
+ * Mesh drawn with a material. Both are referred to by handles into the pools
+ * of the resource system.
+ */
+struct Entity {
+    MaterialHandle material;
+    MeshHandle mesh;
 
-    Entity(MaterialPtr material, MeshPtr mesh)
-    : material { std::move(material) }
-    , mesh { std::move(mesh) }
+    Entity(MaterialHandle material, MeshHandle mesh)
+    : material { material }
+    , mesh { mesh }
     { }
 
 };
 
-template <typename... Args>
-EntityPtr newEntity(Args&&... args) {
-    return std::make_shared<Entity>(std::forward<Args>(args)...);
-}
+
+typedef util::Pool<Mesh> MeshPool;
+typedef util::Pool<Material> MaterialPool;
+typedef util::Pool<Entity> EntityPool;
 
 
 struct Renderable {
-    EntityPtr entity;
+    EntityHandle entity;
     glm::mat4 transform;
+
+    /** Ordering bucket, items of lower passes are drawn first */
+    std::uint8_t pass;
 };
 
 
 struct Object: public std::enable_shared_from_this<Object> {
-    EntityPtr entity;
+    EntityHandle entity;
     WeakObjectPtr parent;
     std::vector<ObjectPtr> children;
 
@@ -166,8 +215,8 @@ struct Object: public std::enable_shared_from_this<Object> {
     glm::mat4 totalTransform;
 
 
-    explicit Object(EntityPtr entity, WeakObjectPtr parent = WeakObjectPtr { })
-    : entity { std::move(entity) }
+    explicit Object(EntityHandle entity, WeakObjectPtr parent = WeakObjectPtr { })
+    : entity { entity }
     , parent { std::move(parent) }
     { }
 
@@ -198,10 +247,10 @@ ObjectPtr newObject(Args&&... args) {
 
 typedef ResourceManager<ShaderPtr> ShaderManager;
 typedef ResourceManager<ProgramPtr> ProgramManager;
-typedef ResourceManager<MaterialPtr> MaterialManager;
-typedef ResourceManager<MeshPtr> MeshManager;
+typedef ResourceManager<MaterialHandle> MaterialManager;
+typedef ResourceManager<MeshHandle> MeshManager;
 typedef ResourceManager<TexturePtr> TextureManager;
-typedef ResourceManager<EntityPtr>EntityManager;
+typedef ResourceManager<EntityHandle> EntityManager;
 typedef ResourceManager<ObjectPtr> ObjectManager;
 
 
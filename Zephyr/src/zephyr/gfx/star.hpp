@@ -48,7 +48,7 @@ inline std::vector<IndexType> makeStarIndices(int n) {
     return idx;
 }
 
-inline MeshPtr makeStar(int n, float w) {
+inline Mesh makeStar(int n, float w) {
     auto vertices = makeStarVertices(n, w);
     auto indices = makeStarIndices<GLuint>(n);
 
@@ -59,6 +59,7 @@ inline MeshPtr makeStar(int n, float w) {
 
     return MeshBuilder()
             .setBuffer(v2).attribute(0, 4)
+            .bounds(v2)
             .setBuffer(randomColors(12 * n)).attribute(1, 4)
             .setBuffer(i2).attribute(2, 3)
 //            .setIndices(indices)
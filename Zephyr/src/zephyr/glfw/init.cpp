@@ -28,20 +28,25 @@ struct InitGLFW {
 
     InitGLFW() {
         glfwSetErrorCallback(errorCallback);
-        if (!glfwInit()) {
+        initialized = glfwInit();
+        if (!initialized) {
+            // not fatal, headless mode does not need it (no display)
             std::cerr << "[GLFW] Initialization error!" << std::endl;
-            std::cerr << "[GLFW] Aborting..." << std::endl;
-            std::exit(1);
+            std::cerr << "[GLFW] Windows will not be available" << std::endl;
         } else {
             std::cout << "[GLFW] Initialized" << std::endl;
         }
     }
 
     ~InitGLFW() {
-        std::cout << "[GLFW] Shutting down..." << std::endl;
-        glfwTerminate();
-        std::cout << "[GLFW] Done" << std::endl;
+        if (initialized) {
+            std::cout << "[GLFW] Shutting down..." << std::endl;
+            glfwTerminate();
+            std::cout << "[GLFW] Done" << std::endl;
+        }
     }
+
+    bool initialized;
 }
 // static global object
 init;
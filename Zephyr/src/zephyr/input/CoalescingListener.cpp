@@ -0,0 +1,69 @@
+/**
+ * @file CoalescingListener.cpp
+ */
+
+#include <zephyr/input/CoalescingListener.hpp>
+
+namespace zephyr {
+namespace input {
+
+CoalescingListener::CoalescingListener(std::shared_ptr<InputListener> target)
+: target_ { std::move(target) }
+, pending_ { Pending::NONE }
+, position_ { 0, 0 }
+, scroll_ { 0 }
+, samples_ { 0 }
+, lastCursorSamples_ { 0 }
+, stats_ { 0, 0, 0, 0 }
+{ }
+
+void CoalescingListener::keyEvent(const KeyEvent& e) {
+    flushExcept(Pending::NONE);
+    target_->keyEvent(e);
+}
+
+void CoalescingListener::buttonEvent(const ButtonEvent& e) {
+    flushExcept(Pending::NONE);
+    target_->buttonEvent(e);
+}
+
+void CoalescingListener::mouseMove(const Position& pos) {
+    flushExcept(Pending::CURSOR);
+    pending_ = Pending::CURSOR;
+    position_ = pos;
+    ++ samples_;
+    ++ stats_.cursorSamples;
+}
+
+void CoalescingListener::scroll(double dy) {
+    flushExcept(Pending::SCROLL);
+    pending_ = Pending::SCROLL;
+    scroll_ += dy;
+    ++ samples_;
+    ++ stats_.scrollSamples;
+}
+
+void CoalescingListener::flush() {
+    flushExcept(Pending::NONE);
+    target_->flush();
+}
+
+void CoalescingListener::flushExcept(Pending kind) {
+    if (pending_ == kind || pending_ == Pending::NONE) {
+        return;
+    }
+    if (pending_ == Pending::CURSOR) {
+        lastCursorSamples_ = samples_;
+        ++ stats_.cursorEvents;
+        target_->mouseMove(position_);
+    } else {
+        ++ stats_.scrollEvents;
+        target_->scroll(scroll_);
+        scroll_ = 0;
+    }
+    pending_ = Pending::NONE;
+    samples_ = 0;
+}
+
+} /* namespace input */
+} /* namespace zephyr */
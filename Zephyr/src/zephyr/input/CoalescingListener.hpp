@@ -0,0 +1,99 @@
+/**
+ * @file CoalescingListener.hpp
+ */
+
+#ifndef ZEPHYR_INPUT_COALESCINGLISTENER_HPP_
+#define ZEPHYR_INPUT_COALESCINGLISTENER_HPP_
+
+#include <zephyr/input/InputListener.hpp>
+#include <cstddef>
+#include <memory>
+
+
+namespace zephyr {
+namespace input {
+
+/**
+ * Input listener merging consecutive cursor moves and consecutive scrolls
+ * into single events, before passing them to another listener. Cursor moves
+ * are replaced by the last position (hence the accumulated delta is the
+ * same), scroll amounts are summed up.
+ *
+ * Pending motion is passed on before any other kind of event, so the relative
+ * order of keys, buttons, moves and scrolls is preserved. Whatever remains
+ * is delivered by @ref flush(), at the end of each batch of events.
+ */
+class CoalescingListener: public InputListener {
+public:
+
+    /** Number of events received and delivered, since the creation */
+    struct Stats {
+        /** Raw cursor samples received */
+        std::size_t cursorSamples;
+
+        /** Cursor events passed on */
+        std::size_t cursorEvents;
+
+        /** Raw scroll samples received */
+        std::size_t scrollSamples;
+
+        /** Scroll events passed on */
+        std::size_t scrollEvents;
+    };
+
+    /**
+     * @param target Listener receiving merged events
+     */
+    explicit CoalescingListener(std::shared_ptr<InputListener> target);
+
+    void keyEvent(const KeyEvent& e) override;
+
+    void buttonEvent(const ButtonEvent& e) override;
+
+    void mouseMove(const Position& pos) override;
+
+    void scroll(double dy) override;
+
+    void flush() override;
+
+    const Stats& stats() const {
+        return stats_;
+    }
+
+    /**
+     * @return Number of raw samples merged into the last delivered cursor
+     *         event
+     */
+    std::size_t lastCursorSamples() const {
+        return lastCursorSamples_;
+    }
+
+private:
+    /** Kind of motion waiting to be delivered */
+    enum class Pending { NONE, CURSOR, SCROLL };
+
+    /** Delivers pending motion of different kind than specified */
+    void flushExcept(Pending kind);
+
+    std::shared_ptr<InputListener> target_;
+
+    Pending pending_;
+
+    /** Last cursor position of the pending move */
+    Position position_;
+
+    /** Accumulated pending scroll */
+    double scroll_;
+
+    /** Number of samples merged into the pending event */
+    std::size_t samples_;
+
+    std::size_t lastCursorSamples_;
+
+    Stats stats_;
+};
+
+} /* namespace input */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_INPUT_COALESCINGLISTENER_HPP_ */
@@ -38,6 +38,12 @@ public:
      */
     virtual void scroll(double dy) = 0;
 
+    /**
+     * Invoked after each batch of events (e.g. once per window poll) has been
+     * delivered.
+     */
+    virtual void flush() { }
+
     virtual ~InputListener() = default;
 
 };
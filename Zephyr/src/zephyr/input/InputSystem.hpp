@@ -8,7 +8,7 @@
 #include <zephyr/Context.hpp>
 #include <zephyr/core/Message.hpp>
 #include <zephyr/input/KeyEvent.hpp>
-#include <zephyr/util/Any.hpp>
+#include <zephyr/util/Payload.hpp>
 #include <zephyr/input/messages.hpp>
 #include <zephyr/messages.hpp>
 #include <functional>
@@ -30,15 +30,14 @@ public:
 
     InputSystem(Context ctx)
     : queue(ctx.messageQueue) {
-        using std::placeholders::_1;
-        core::Handler handler = std::bind(&InputSystem::message, this, _1);
-        ctx.dispatcher.registerHandler(msg::INPUT_SYSTEM, handler);
+        core::registerHandler(ctx.dispatcher, msg::INPUT_SYSTEM, this,
+                &InputSystem::message);
     }
 
     void message(const core::Message& message) {
         std::cout << "[Input] " << message.data << std::endl;
         if (message.type == msg::KEYBOARD_EVENT) {
-            KeyEvent e = util::any_cast<KeyEvent>(message.data);
+            KeyEvent e = message.data.get<KeyEvent>();
             if (e.type == KeyEvent::Type::DOWN) {
                 if (e.key == Key::ESCAPE) {
                     queue.post({
@@ -8,7 +8,7 @@
 namespace zephyr {
 namespace input {
 
-using util::Any;
+using util::Payload;
 
 MessageGenerator::MessageGenerator(core::MessageQueue& messageQueue)
 : messageQueue(messageQueue)
@@ -18,7 +18,7 @@ void MessageGenerator::keyEvent(const KeyEvent& event) {
     messageQueue.post({
         msg::INPUT_SYSTEM,
         msg::KEYBOARD_EVENT,
-        Any { event }
+        Payload { event }
     });
 }
 
@@ -26,7 +26,7 @@ void MessageGenerator::buttonEvent(const ButtonEvent& event) {
     messageQueue.post({
         msg::INPUT_SYSTEM,
         msg::BUTTON_EVENT,
-        Any { event }
+        Payload { event }
     });
 }
 
@@ -34,7 +34,7 @@ void MessageGenerator::mouseMove(const Position& pos) {
     messageQueue.post({
         msg::INPUT_SYSTEM,
         msg::CURSOR_EVENT,
-        Any { pos }
+        Payload { pos }
     });
 }
 
@@ -42,7 +42,7 @@ void MessageGenerator::scroll(double dy) {
     messageQueue.post({
         msg::INPUT_SYSTEM,
         msg::SCROLL_EVENT,
-        Any { dy }
+        Payload { dy }
     });
 }
 
@@ -132,6 +132,7 @@ ast::Material parseMaterial(const ptree& tree) {
     const std::string& program = tree.get<std::string>("program");
 
     ast::Material material { name, program };
+    material.instanced = tree.get<bool>("instanced", false);
 
     auto texRange = tree.equal_range("texture");
     for (auto it = texRange.first; it != texRange.second; ++ it) {
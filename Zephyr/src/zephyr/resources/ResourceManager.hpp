@@ -93,12 +93,16 @@ public:
         return it != end(resources);
     }
 
-    Maybe<T> tryGet(const std::string& name) {
+    /**
+     * @return Pointer to the stored resource, or @c nullptr if there is none
+     *         (loader is not used)
+     */
+    T* tryGet(const std::string& name) {
         auto it = resources.find(name);
         if (it != end(resources)) {
-            return indeed(it->second);
+            return &it->second;
         } else {
-            return nothing;
+            return nullptr;
         }
     }
 
@@ -73,19 +73,36 @@ TexturePtr ResourceSystem::texture(const std::string& name) {
     }
 }
 
-MaterialPtr ResourceSystem::material(const std::string& name) {
+MaterialHandle ResourceSystem::material(const std::string& name) {
     auto val = materials.tryGet(name);
     if (val) {
         return *val;
-    } else if (MaterialPtr material = loadMaterial(name)) {
+    } else if (MaterialHandle material = loadMaterial(name)) {
         materials.put(name, material);
         return material;
     } else {
         notFound("material", name);
-        return nullptr;
+        return MaterialHandle { };
     }
 }
 
+MeshHandle ResourceSystem::addMesh(std::string name, Mesh mesh) {
+    MeshHandle handle = meshPool.create(std::move(mesh));
+    meshes.put(std::move(name), handle);
+    return handle;
+}
+
+EntityHandle ResourceSystem::addEntity(std::string name,
+        MaterialHandle material, MeshHandle mesh) {
+    EntityHandle handle = entityPool.create(material, mesh);
+    entities.put(std::move(name), handle);
+    return handle;
+}
+
+std::size_t ResourceSystem::collect() {
+    return entityPool.collect() + materialPool.collect() + meshPool.collect();
+}
+
 
 ShaderPtr ResourceSystem::loadShader(const std::string& name) {
     std::clog << "Loading shader " << name << std::endl;
@@ -162,30 +179,34 @@ TexturePtr ResourceSystem::loadTexture(const std::string& name) {
     }
 }
 
-MaterialPtr ResourceSystem::loadMaterial(const std::string& name) {
+MaterialHandle ResourceSystem::loadMaterial(const std::string& name) {
     std::clog << "Loading material " << name << std::endl;
     auto it = defs.materials.find(name);
     if (it != end(defs.materials)) {
         std::clog << "Found material definition" << std::endl;
         const ast::Material& materialDef = it->second;
 
-        MaterialPtr material = newMaterial(program(materialDef.program));
+        MaterialHandle handle = materialPool.create(
+                program(materialDef.program));
+        Material& material = materialPool[handle];
+        material.instanced = materialDef.instanced;
 
         for (const auto& entry : materialDef.textures) {
-            GLint index = material->program->uniformLocation(entry.first);
+            GLint index = material.program->uniformLocation(entry.first);
             std::clog << "Index of " << entry.first << " is " << index << std::endl;
-            material->textures.push_back({ index, texture(entry.second) });
+            material.textures.push_back({ index, texture(entry.second) });
         }
 
         for (const auto& entry : materialDef.uniforms) {
-            material->uniforms.emplace_back(entry);
+            material.uniforms.emplace_back(gfx::uniformId(entry.first),
+                    entry.second);
         }
-        materials.put(name, material);
-        return material;
+        materials.put(name, handle);
+        return handle;
     } else {
         std::clog << "No material definition for '" << name << "' found" <<
                 std::endl;
-    return nullptr;
+    return MaterialHandle { };
     }
 }
 
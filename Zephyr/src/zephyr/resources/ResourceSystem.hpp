@@ -22,6 +22,14 @@ public:
 
     ResourceSystem(const Config& config);
 
+    ResourceSystem(const ResourceSystem&) = delete;
+    ResourceSystem& operator = (const ResourceSystem&) = delete;
+
+    /** Storage of the objects referred to by handles */
+    MeshPool meshPool;
+    MaterialPool materialPool;
+    EntityPool entityPool;
+
     ShaderManager shaders;
     ProgramManager programs;
     MaterialManager materials;
@@ -38,7 +46,26 @@ public:
 
     TexturePtr texture(const std::string& name);
 
-    MaterialPtr material(const std::string& name);
+    MaterialHandle material(const std::string& name);
+
+    /**
+     * Stores the mesh in the pool under given name.
+     */
+    MeshHandle addMesh(std::string name, Mesh mesh);
+
+    /**
+     * Creates entity in the pool and stores it under given name.
+     */
+    EntityHandle addEntity(std::string name, MaterialHandle material,
+            MeshHandle mesh);
+
+    /**
+     * Destroys the objects released with @c releaseLater() from any pool.
+     * Called by the renderer once the frame is finished.
+     *
+     * @return Number of destroyed objects
+     */
+    std::size_t collect();
 
     const unsigned int DEFAULT_SHADER_VERSION = 330;
 
@@ -50,7 +77,7 @@ private:
 
     TexturePtr loadTexture(const std::string& name);
 
-    MaterialPtr loadMaterial(const std::string& name);
+    MaterialHandle loadMaterial(const std::string& name);
 
     ast::Root defs;
 
@@ -84,11 +84,13 @@ struct Material {
     std::string program;
     string_map<std::string> textures;
     string_map<gfx::UniformPtr> uniforms;
+    bool instanced;
 };
 
 inline std::ostream& operator << (std::ostream& os, const Material& material) {
     os << "material{name=" << material.name << ", program=" <<
-            material.program << ", textures=[";
+            material.program << ", instanced=" << material.instanced <<
+            ", textures=[";
     {
         bool first = true;
         for (const auto& texPair : material.textures) {
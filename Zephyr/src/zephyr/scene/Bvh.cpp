@@ -0,0 +1,343 @@
+/**
+ * @file Bvh.cpp
+ */
+
+#include <zephyr/scene/Bvh.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+
+namespace zephyr {
+namespace scene {
+
+constexpr std::int32_t Bvh::NONE;
+
+namespace {
+
+BoundingBox merge(const BoundingBox& a, const BoundingBox& b) {
+    if (a.empty()) {
+        return b;
+    } else if (b.empty()) {
+        return a;
+    }
+    BoundingBox box;
+    for (int i = 0; i < 3; ++ i) {
+        box.min[i] = std::min(a.min[i], b.min[i]);
+        box.max[i] = std::max(a.max[i], b.max[i]);
+    }
+    return box;
+}
+
+bool equal(const BoundingBox& a, const BoundingBox& b) {
+    return std::equal(a.min, a.min + 3, b.min)
+        && std::equal(a.max, a.max + 3, b.max);
+}
+
+bool overlaps(const BoundingBox& a, const BoundingBox& b) {
+    for (int i = 0; i < 3; ++ i) {
+        if (a.max[i] < b.min[i] || b.max[i] < a.min[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool overlaps(const BoundingBox& box, const BoundingSphere& sphere) {
+    float d2 = 0;
+    for (int i = 0; i < 3; ++ i) {
+        float c = std::max(box.min[i], std::min(sphere.center[i], box.max[i]));
+        float d = sphere.center[i] - c;
+        d2 += d * d;
+    }
+    return d2 <= sphere.radius * sphere.radius;
+}
+
+/**
+ * Slab test.
+ *
+ * @return Parameter at which the ray enters the box, negative if it misses
+ */
+float intersect(const BoundingBox& box, const float* origin,
+        const float* invDir, float maxT) {
+    float enter = 0, exit = maxT;
+    for (int i = 0; i < 3; ++ i) {
+        float t0 = (box.min[i] - origin[i]) * invDir[i];
+        float t1 = (box.max[i] - origin[i]) * invDir[i];
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        // NaN for 0 * inf (ray in the slab's plane) is ignored by min/max
+        enter = std::max(enter, t0);
+        exit = std::min(exit, t1);
+        if (enter > exit) {
+            return -1;
+        }
+    }
+    return enter;
+}
+
+} /* namespace */
+
+
+ProxyId Bvh::insert(const BoundingBox& box, std::uint32_t item) {
+    ProxyId proxy;
+    if (free_.empty()) {
+        proxy = proxies_.size();
+        proxies_.push_back(Proxy { });
+    } else {
+        proxy = free_.back();
+        free_.pop_back();
+    }
+    proxies_[proxy] = Proxy { box, item, NONE, true };
+    ++ count_;
+    rebuild_ = true;
+    return proxy;
+}
+
+void Bvh::remove(ProxyId proxy) {
+    proxies_[proxy].alive = false;
+    free_.push_back(proxy);
+    -- count_;
+    rebuild_ = true;
+}
+
+void Bvh::update(ProxyId proxy, const BoundingBox& box) {
+    Proxy& p = proxies_[proxy];
+    if (equal(p.box, box)) {
+        return;
+    }
+    if (p.box.empty() != box.empty()) {
+        rebuild_ = true;
+    }
+    p.box = box;
+    if (p.node != NONE && !rebuild_) {
+        nodes_[p.node].box = box;
+        dirty_.push_back(p.node);
+    }
+}
+
+void Bvh::refit() {
+    refitted_ = 0;
+    if (rebuild_) {
+        build();
+        return;
+    }
+    for (std::int32_t leaf : dirty_) {
+        std::int32_t node = nodes_[leaf].parent;
+        while (node != NONE) {
+            Node& n = nodes_[node];
+            BoundingBox box = merge(nodes_[n.left].box, nodes_[n.right].box);
+            ++ refitted_;
+            if (equal(box, n.box)) {
+                // rest of the path is up to date
+                break;
+            }
+            n.box = box;
+            node = n.parent;
+        }
+    }
+    dirty_.clear();
+}
+
+void Bvh::build() {
+    nodes_.clear();
+    dirty_.clear();
+    unbounded_.clear();
+    rebuild_ = false;
+
+    std::vector<std::int32_t> leaves;
+    leaves.reserve(count_);
+    for (std::size_t i = 0; i < proxies_.size(); ++ i) {
+        Proxy& proxy = proxies_[i];
+        proxy.node = NONE;
+        if (!proxy.alive) {
+            continue;
+        }
+        if (proxy.box.empty()) {
+            unbounded_.push_back(proxy.item);
+        } else {
+            leaves.push_back(i);
+        }
+    }
+    nodes_.reserve(2 * leaves.size());
+    root_ = leaves.empty() ? NONE
+            : build(leaves.data(), leaves.data() + leaves.size(), NONE);
+    refitted_ = nodes_.size();
+}
+
+std::int32_t Bvh::build(std::int32_t* first, std::int32_t* last,
+        std::int32_t parent) {
+    std::int32_t index = nodes_.size();
+    nodes_.push_back(Node { BoundingBox { }, parent, NONE, NONE, NONE });
+
+    if (last - first == 1) {
+        Proxy& proxy = proxies_[*first];
+        proxy.node = index;
+        nodes_[index].box = proxy.box;
+        nodes_[index].proxy = *first;
+        return index;
+    }
+
+    // split at the median of the centers along the longest axis
+    BoundingBox centers;
+    for (std::int32_t* p = first; p != last; ++ p) {
+        const BoundingBox& box = proxies_[*p].box;
+        BoundingBox c;
+        for (int i = 0; i < 3; ++ i) {
+            c.min[i] = c.max[i] = box.center(i);
+        }
+        centers = merge(centers, c);
+    }
+    int axis = 0;
+    for (int i = 1; i < 3; ++ i) {
+        if (centers.extent(i) > centers.extent(axis)) {
+            axis = i;
+        }
+    }
+    std::int32_t* mid = first + (last - first) / 2;
+    std::nth_element(first, mid, last, [this, axis](std::int32_t a,
+            std::int32_t b) {
+        return proxies_[a].box.center(axis) < proxies_[b].box.center(axis);
+    });
+
+    std::int32_t left = build(first, mid, index);
+    std::int32_t right = build(mid, last, index);
+    Node& node = nodes_[index];
+    node.left = left;
+    node.right = right;
+    node.box = merge(nodes_[left].box, nodes_[right].box);
+    return index;
+}
+
+BoundingBox Bvh::bounds() const {
+    return root_ == NONE ? BoundingBox { } : nodes_[root_].box;
+}
+
+template <typename Test, typename Visit>
+void Bvh::traverse(Test test, Visit visit) const {
+    visited_ = 0;
+    if (root_ == NONE) {
+        return;
+    }
+    std::int32_t stack[64];
+    int top = 0;
+    stack[top ++] = root_;
+    while (top > 0) {
+        const Node& node = nodes_[stack[-- top]];
+        ++ visited_;
+        if (!test(node.box)) {
+            continue;
+        }
+        if (node.proxy != NONE) {
+            visit(proxies_[node.proxy]);
+        } else {
+            stack[top ++] = node.right;
+            stack[top ++] = node.left;
+        }
+    }
+}
+
+void Bvh::collect(std::int32_t index, std::vector<std::uint32_t>& out) const {
+    const Node& node = nodes_[index];
+    ++ visited_;
+    if (node.proxy != NONE) {
+        out.push_back(proxies_[node.proxy].item);
+    } else {
+        collect(node.left, out);
+        collect(node.right, out);
+    }
+}
+
+void Bvh::query(const Frustum& frustum,
+        std::vector<std::uint32_t>& out) const {
+    visited_ = 0;
+    out.insert(end(out), begin(unbounded_), end(unbounded_));
+    if (root_ == NONE) {
+        return;
+    }
+    // planes the node's box is not known to be inside of, as a bit mask
+    struct Entry {
+        std::int32_t node;
+        unsigned planes;
+    };
+    Entry stack[64];
+    int top = 0;
+    stack[top ++] = { root_, (1u << 6) - 1 };
+
+    while (top > 0) {
+        Entry entry = stack[-- top];
+        const Node& node = nodes_[entry.node];
+        ++ visited_;
+
+        unsigned planes = entry.planes;
+        bool outside = false;
+        for (int i = 0; i < 6 && !outside; ++ i) {
+            if (!(planes & (1u << i))) {
+                continue;
+            }
+            const float* p = frustum.planes[i];
+            float dist = p[3], radius = 0;
+            for (int j = 0; j < 3; ++ j) {
+                dist += p[j] * node.box.center(j);
+                radius += std::abs(p[j]) * node.box.extent(j);
+            }
+            if (dist + radius < 0) {
+                outside = true;
+            } else if (dist - radius >= 0) {
+                // children are inside as well
+                planes &= ~(1u << i);
+            }
+        }
+        if (outside) {
+            continue;
+        }
+        if (planes == 0 || node.proxy != NONE) {
+            -- visited_;
+            collect(entry.node, out);
+        } else {
+            stack[top ++] = { node.right, planes };
+            stack[top ++] = { node.left, planes };
+        }
+    }
+}
+
+void Bvh::query(const BoundingSphere& sphere,
+        std::vector<std::uint32_t>& out) const {
+    traverse([&sphere](const BoundingBox& box) {
+        return overlaps(box, sphere);
+    }, [&out](const Proxy& proxy) {
+        out.push_back(proxy.item);
+    });
+}
+
+void Bvh::query(const BoundingBox& box,
+        std::vector<std::uint32_t>& out) const {
+    traverse([&box](const BoundingBox& node) {
+        return overlaps(node, box);
+    }, [&out](const Proxy& proxy) {
+        out.push_back(proxy.item);
+    });
+}
+
+void Bvh::raycast(const float* origin, const float* dir, float maxT,
+        std::vector<RayHit>& out) const {
+    float invDir[3];
+    for (int i = 0; i < 3; ++ i) {
+        invDir[i] = 1 / dir[i];
+    }
+    std::size_t first = out.size();
+    traverse([&](const BoundingBox& box) {
+        return intersect(box, origin, invDir, maxT) >= 0;
+    }, [&](const Proxy& proxy) {
+        out.push_back({ proxy.item, intersect(proxy.box, origin, invDir,
+                maxT) });
+    });
+    std::sort(begin(out) + first, end(out), [](const RayHit& a,
+            const RayHit& b) {
+        return a.t < b.t;
+    });
+}
+
+} /* namespace scene */
+} /* namespace zephyr */
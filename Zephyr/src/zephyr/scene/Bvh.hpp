@@ -0,0 +1,157 @@
+/**
+ * @file Bvh.hpp
+ */
+
+#ifndef ZEPHYR_SCENE_BVH_HPP_
+#define ZEPHYR_SCENE_BVH_HPP_
+
+#include <zephyr/gfx/Bounds.hpp>
+#include <zephyr/gfx/Culling.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace zephyr {
+namespace scene {
+
+using gfx::BoundingBox;
+using gfx::BoundingSphere;
+using gfx::Frustum;
+
+/** Handle of an item stored in the @ref Bvh */
+typedef std::uint32_t ProxyId;
+
+/** Item hit by the ray */
+struct RayHit {
+    std::uint32_t item;
+    /** Ray parameter at which the ray enters the item's box */
+    float t;
+};
+
+
+/**
+ * Bounding volume hierarchy over world-space boxes of the items, for
+ * culling and spatial queries that do not have to visit all the items.
+ *
+ * Tree is built top-down, splitting the items at the median along the
+ * longest axis, with one item per leaf. Items with empty boxes (unknown
+ * bounds) are kept outside the tree - frustum queries always report them,
+ * other queries never do. Moving items does not rebuild it:
+ * @ref update() marks the leaf, and @ref refit() recomputes the boxes only
+ * on the paths from the marked leaves to the root. Inserting or removing
+ * items rebuilds the tree on the next @ref refit().
+ */
+class Bvh {
+public:
+
+    /**
+     * Adds the item.
+     *
+     * @param box World-space bounds of the item
+     * @param item Value reported by the queries
+     */
+    ProxyId insert(const BoundingBox& box, std::uint32_t item);
+
+    /** Removes the item */
+    void remove(ProxyId proxy);
+
+    /**
+     * Changes bounds of the item. Does nothing if the bounds are the same.
+     */
+    void update(ProxyId proxy, const BoundingBox& box);
+
+    /**
+     * Brings the tree up to date - rebuilds it if items were added or
+     * removed, refits the paths of updated items otherwise.
+     */
+    void refit();
+
+    /** Builds the tree from scratch */
+    void build();
+
+    /** Items intersecting the frustum */
+    void query(const Frustum& frustum, std::vector<std::uint32_t>& out) const;
+
+    /** Items intersecting the sphere */
+    void query(const BoundingSphere& sphere,
+            std::vector<std::uint32_t>& out) const;
+
+    /** Items intersecting the box */
+    void query(const BoundingBox& box, std::vector<std::uint32_t>& out) const;
+
+    /**
+     * Items whose boxes are hit by the ray, sorted by the distance.
+     *
+     * @param origin Origin of the ray
+     * @param dir Direction of the ray
+     * @param maxT Items further away than @c maxT * |dir| are ignored
+     */
+    void raycast(const float* origin, const float* dir, float maxT,
+            std::vector<RayHit>& out) const;
+
+    /** Number of items */
+    std::size_t size() const {
+        return count_;
+    }
+
+    /** Nodes visited by the last query */
+    std::size_t visited() const {
+        return visited_;
+    }
+
+    /** Nodes whose boxes were recomputed by the last @ref refit() */
+    std::size_t refitted() const {
+        return refitted_;
+    }
+
+    /** Bounds of the whole tree, empty if there are no items */
+    BoundingBox bounds() const;
+
+private:
+    static constexpr std::int32_t NONE = -1;
+
+    struct Node {
+        BoundingBox box;
+        std::int32_t parent;
+        std::int32_t left;
+        std::int32_t right;
+        /** Proxy of the leaf, NONE for inner nodes */
+        std::int32_t proxy;
+    };
+
+    struct Proxy {
+        BoundingBox box;
+        std::uint32_t item;
+        std::int32_t node;
+        bool alive;
+    };
+
+    std::int32_t build(std::int32_t* first, std::int32_t* last,
+            std::int32_t parent);
+
+    template <typename Test, typename Visit>
+    void traverse(Test test, Visit visit) const;
+
+    void collect(std::int32_t node, std::vector<std::uint32_t>& out) const;
+
+    std::vector<Node> nodes_;
+    std::int32_t root_ = NONE;
+
+    std::vector<Proxy> proxies_;
+    std::vector<ProxyId> free_;
+    std::size_t count_ = 0;
+
+    std::vector<std::uint32_t> unbounded_;
+
+    std::vector<std::int32_t> dirty_;
+    bool rebuild_ = false;
+
+    mutable std::size_t visited_ = 0;
+    std::size_t refitted_ = 0;
+};
+
+} /* namespace scene */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_SCENE_BVH_HPP_ */
@@ -10,6 +10,7 @@
 #include <string>
 #include <glm/glm.hpp>
 #include <glm/ext.hpp>
+#include <zephyr/scene/TransformSystem.hpp>
 
 
 namespace zephyr {
@@ -19,14 +20,44 @@ typedef std::shared_ptr<class Node> NodePtr;
 typedef std::weak_ptr<class Node> WeakNodePtr;
 
 
+/**
+ * Handle of a transform stored in the @ref TransformSystem, with the names
+ * of its children. World transform is computed by the system, during
+ * @ref SceneGraph::update().
+ */
 class Node: public std::enable_shared_from_this<Node> {
 public:
 
-    Node(WeakNodePtr parent = WeakNodePtr { })
-    : parent_ { parent }
+    /**
+     * Creates root node.
+     */
+    explicit Node(std::shared_ptr<TransformSystem> system)
+    : system_ { std::move(system) }
+    , id_ { system_->create() }
+    { }
+
+    /**
+     * Creates node with the parent's transform as the reference frame.
+     */
+    explicit Node(const NodePtr& parent)
+    : system_ { parent->system_ }
+    , id_ { system_->create(parent->id_) }
     { }
 
+    Node(const Node&) = delete;
+    Node& operator = (const Node&) = delete;
+
+    ~Node() {
+        system_->destroy(id_);
+    }
+
+    /**
+     * Adds the child. If it has a different parent, it is moved here.
+     */
     void addChild(std::string name, NodePtr child) {
+        if (system_->parent(child->id_) != id_) {
+            system_->setParent(child->id_, id_);
+        }
         children_.emplace(std::move(name), std::move(child));
     }
 
@@ -52,42 +83,36 @@ public:
     }
 
 
-    const glm::vec3& position() const {
-        return position_;
+    glm::vec3 position() const {
+        const Vec3& p = system_->position(id_);
+        return glm::vec3 { p.x, p.y, p.z };
     }
 
-    glm::vec3& position() {
-        return position_;
+    glm::quat orientation() const {
+        const Quat& q = system_->orientation(id_);
+        return glm::quat { q.w, q.x, q.y, q.z };
     }
 
-    glm::quat& orientation() {
-        return orientation_;
+    glm::vec3 scaling() const {
+        const Vec3& s = system_->scale(id_);
+        return glm::vec3 { s.x, s.y, s.z };
     }
-    
-    const glm::quat& orientation() const {
-        return orientation_;
+
+    glm::mat4 localTransform() const {
+        return glm::make_mat4(system_->local(id_).m);
     }
 
-    void update() {
-        if (auto p = parent_.lock()) {
-            transform_ = p->transform_ * localTransform();
-        } else {
-            transform_ = localTransform();
-        }
-        for (auto p : children_) {
-            p.second->update();
-        }
+    glm::mat4 globalTransform() const {
+        return glm::make_mat4(system_->world(id_).m);
     }
 
-    glm::mat4 localTransform() const {
-        glm::mat4 translate = glm::translate(position_);
-        glm::mat4 rotate = glm::mat4_cast(orientation_);
-        glm::mat4 scale = glm::scale(scale_);
-        return translate * rotate * scale;
+    /** Whether the global transform changed in the last update */
+    bool transformChanged() const {
+        return system_->changed(id_);
     }
 
-    glm::mat4 globalTransform() const {
-        return transform_;
+    TransformId transformId() const {
+        return id_;
     }
 
     Node& transform(const glm::mat4& matrix) {
@@ -99,7 +124,7 @@ public:
     }
 
     Node& translateTo(const glm::vec3& position) {
-        this->position_ = position;
+        system_->setPosition(id_, Vec3 { position.x, position.y, position.z });
         return *this;
     }
 
@@ -108,8 +133,7 @@ public:
     }
 
     Node& translate(const glm::vec3& trans) {
-        position_ += trans;
-        return *this;
+        return translateTo(position() + trans);
     }
 
     Node& translate(float dx, float dy, float dz) {
@@ -132,7 +156,8 @@ public:
     }
 
     Node& rotateTo(const glm::quat& orientation) {
-        this->orientation_ = orientation;
+        const glm::quat& q = orientation;
+        system_->setOrientation(id_, Quat { q.x, q.y, q.z, q.w });
         return *this;
     }
 
@@ -143,8 +168,7 @@ public:
     }
 
     Node& rotate(const glm::quat& rot) {
-        orientation_ = glm::cross(orientation_, rot);
-        return *this;
+        return rotateTo(glm::cross(orientation(), rot));
     }
 
     Node& rotate(float pitch, float yaw, float roll) {
@@ -166,8 +190,7 @@ public:
     }
 
     Node& scale(const glm::vec3& s) {
-        scale_ *= s;
-        return *this;
+        return scaleTo(scaling() * s);
     }
 
     Node& scale(float sx, float sy, float sz) {
@@ -191,7 +214,7 @@ public:
     }
 
     Node& scaleTo(const glm::vec3& scale) {
-        this->scale_ = scale;
+        system_->setScale(id_, Vec3 { scale.x, scale.y, scale.z });
         return *this;
     }
 
@@ -200,15 +223,9 @@ public:
     }
 
 private:
-    WeakNodePtr parent_;
-
-    glm::vec3 scale_ { 1, 1, 1};
-
-    glm::quat orientation_;
-
-    glm::vec3 position_;
+    std::shared_ptr<TransformSystem> system_;
 
-    glm::mat4 transform_;
+    TransformId id_;
 
     std::unordered_multimap<std::string, NodePtr> children_;
 
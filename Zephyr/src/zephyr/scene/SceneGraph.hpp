@@ -6,6 +6,8 @@
 #define ZEPHYR_SCENE_SCENEGRAPH_HPP_
 
 #include <zephyr/scene/Node.hpp>
+#include <zephyr/scene/TransformSystem.hpp>
+#include <memory>
 
 
 namespace zephyr {
@@ -15,19 +17,39 @@ class SceneGraph {
 public:
 
     SceneGraph()
-    : root_ { std::make_shared<Node>() }
+    : transforms_ { std::make_shared<TransformSystem>() }
+    , root_ { std::make_shared<Node>(transforms_) }
     { }
 
     NodePtr& root() {
         return root_;
     }
 
+    TransformSystem& transforms() {
+        return *transforms_;
+    }
+
+    /**
+     * Recomputes world transforms of the nodes whose local transform (or that
+     * of any ancestor) changed since the last update.
+     */
     void update() {
-        root_->update();
+        transforms_->update();
+    }
+
+    /**
+     * Same as @ref update(), with wide levels of the graph split into chunks
+     * of @c grain nodes, computed in parallel.
+     */
+    void update(core::Jobs& jobs,
+            std::size_t grain = TransformSystem::DEFAULT_GRAIN) {
+        transforms_->update(jobs, grain);
     }
 
 private:
 
+    std::shared_ptr<TransformSystem> transforms_;
+
     NodePtr root_;
 
 };
@@ -14,7 +14,7 @@ namespace zephyr {
 namespace scene {
 
 using gfx::Camera;
-using gfx::EntityPtr;
+using gfx::EntityHandle;
 
 
 
@@ -23,7 +23,7 @@ public:
 
     struct RenderItem {
         NodePtr node;
-        EntityPtr entity;
+        EntityHandle entity;
     };
 
 
@@ -0,0 +1,283 @@
+/**
+ * @file TransformSystem.cpp
+ */
+
+#include <zephyr/scene/TransformSystem.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <zephyr/util/format.hpp>
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+
+#if defined(__SSE__)
+#   include <xmmintrin.h>
+#endif
+
+
+namespace zephyr {
+namespace scene {
+
+constexpr TransformId TransformSystem::NONE;
+constexpr std::size_t TransformSystem::DEFAULT_GRAIN;
+const std::uint32_t TransformSystem::NO_SLOT;
+
+namespace {
+
+const Mat4 IDENTITY = { {
+    1, 0, 0, 0,
+    0, 1, 0, 0,
+    0, 0, 1, 0,
+    0, 0, 0, 1
+} };
+
+} /* namespace */
+
+
+void multiply(const Mat4& a, const Mat4& b, Mat4& out) {
+#if defined(__SSE__)
+    __m128 c0 = _mm_loadu_ps(a.m);
+    __m128 c1 = _mm_loadu_ps(a.m + 4);
+    __m128 c2 = _mm_loadu_ps(a.m + 8);
+    __m128 c3 = _mm_loadu_ps(a.m + 12);
+    for (int j = 0; j < 4; ++ j) {
+        const float* col = b.m + 4 * j;
+        __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(col[0])),
+                       _mm_mul_ps(c1, _mm_set1_ps(col[1]))),
+            _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(col[2])),
+                       _mm_mul_ps(c3, _mm_set1_ps(col[3]))));
+        _mm_storeu_ps(out.m + 4 * j, r);
+    }
+#else
+    Mat4 r;
+    for (int j = 0; j < 4; ++ j) {
+        for (int i = 0; i < 4; ++ i) {
+            float sum = 0;
+            for (int k = 0; k < 4; ++ k) {
+                sum += a.m[4 * k + i] * b.m[4 * j + k];
+            }
+            r.m[4 * j + i] = sum;
+        }
+    }
+    out = r;
+#endif
+}
+
+
+TransformId TransformSystem::create(TransformId parent) {
+    TransformId id;
+    if (free_.empty()) {
+        id = slot_.size();
+        slot_.push_back(NO_SLOT);
+    } else {
+        id = free_.back();
+        free_.pop_back();
+    }
+    slot_[id] = id_.size();
+    id_.push_back(id);
+    parent_.push_back(parent == NONE ? NO_SLOT : slot_[parent]);
+    position_.push_back(Vec3 { 0, 0, 0 });
+    orientation_.push_back(Quat { 0, 0, 0, 1 });
+    scale_.push_back(Vec3 { 1, 1, 1 });
+    world_.push_back(IDENTITY);
+    flags_.push_back(DIRTY);
+
+    ++ count_;
+    sorted_ = false;
+    return id;
+}
+
+void TransformSystem::destroy(TransformId id) {
+    std::uint32_t s = slot_[id];
+    for (std::size_t i = 0; i < id_.size(); ++ i) {
+        if (parent_[i] == s) {
+            parent_[i] = NO_SLOT;
+            flags_[i] |= DIRTY;
+        }
+    }
+    id_[s] = NONE;
+    parent_[s] = NO_SLOT;
+    slot_[id] = NO_SLOT;
+    free_.push_back(id);
+
+    -- count_;
+    sorted_ = false;
+}
+
+void TransformSystem::setParent(TransformId id, TransformId parent) {
+    std::uint32_t s = slot_[id];
+    std::uint32_t p = parent == NONE ? NO_SLOT : slot_[parent];
+    for (std::uint32_t a = p; a != NO_SLOT; a = parent_[a]) {
+        if (a == s) {
+            throw std::logic_error(util::format("Transform {} cannot become "
+                    "a child of its descendant {}", id, parent));
+        }
+    }
+    parent_[s] = p;
+    flags_[s] |= DIRTY;
+    sorted_ = false;
+}
+
+TransformId TransformSystem::parent(TransformId id) const {
+    std::uint32_t p = parent_[slot_[id]];
+    return p == NO_SLOT ? NONE : id_[p];
+}
+
+Mat4 TransformSystem::local(TransformId id) const {
+    return compose(slot_[id]);
+}
+
+Mat4 TransformSystem::compose(std::uint32_t slot) const {
+    const Quat& q = orientation_[slot];
+    const Vec3& s = scale_[slot];
+    const Vec3& t = position_[slot];
+
+    float xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+    float xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+    float wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+    // translate * rotate * scale
+    return Mat4 { {
+        s.x * (1 - 2 * (yy + zz)), s.x * 2 * (xy + wz), s.x * 2 * (xz - wy), 0,
+        s.y * 2 * (xy - wz), s.y * (1 - 2 * (xx + zz)), s.y * 2 * (yz + wx), 0,
+        s.z * 2 * (xz + wy), s.z * 2 * (yz - wx), s.z * (1 - 2 * (xx + yy)), 0,
+        t.x, t.y, t.z, 1
+    } };
+}
+
+void TransformSystem::sort() {
+    if (sorted_) {
+        return;
+    }
+    std::size_t n = id_.size();
+
+    // depth of each live slot, parents may come after children here
+    std::vector<int> depth(n, -1);
+    std::vector<std::uint32_t> path;
+    std::size_t maxDepth = 0;
+    for (std::uint32_t s = 0; s < n; ++ s) {
+        if (id_[s] == NONE) {
+            continue;
+        }
+        std::uint32_t a = s;
+        while (a != NO_SLOT && depth[a] < 0) {
+            path.push_back(a);
+            a = parent_[a];
+        }
+        int d = (a == NO_SLOT) ? -1 : depth[a];
+        while (!path.empty()) {
+            depth[path.back()] = ++ d;
+            path.pop_back();
+        }
+        maxDepth = std::max(maxDepth, std::size_t(depth[s]));
+    }
+
+    // stable counting sort by depth
+    levelStart_.assign(count_ > 0 ? maxDepth + 2 : 1, 0);
+    for (std::uint32_t s = 0; s < n; ++ s) {
+        if (id_[s] != NONE) {
+            ++ levelStart_[depth[s] + 1];
+        }
+    }
+    for (std::size_t i = 1; i < levelStart_.size(); ++ i) {
+        levelStart_[i] += levelStart_[i - 1];
+    }
+    std::vector<std::size_t> next(begin(levelStart_), end(levelStart_));
+    std::vector<std::uint32_t> newSlot(n, NO_SLOT);
+    std::vector<std::uint32_t> order(count_);
+    for (std::uint32_t s = 0; s < n; ++ s) {
+        if (id_[s] != NONE) {
+            std::uint32_t target = next[depth[s]] ++;
+            newSlot[s] = target;
+            order[target] = s;
+        }
+    }
+
+    std::vector<TransformId> id(count_);
+    std::vector<std::uint32_t> parent(count_);
+    std::vector<Vec3> position(count_);
+    std::vector<Quat> orientation(count_);
+    std::vector<Vec3> scale(count_);
+    std::vector<Mat4> world(count_);
+    std::vector<std::uint8_t> flags(count_);
+    for (std::size_t i = 0; i < count_; ++ i) {
+        std::uint32_t s = order[i];
+        id[i] = id_[s];
+        parent[i] = parent_[s] == NO_SLOT ? NO_SLOT : newSlot[parent_[s]];
+        position[i] = position_[s];
+        orientation[i] = orientation_[s];
+        scale[i] = scale_[s];
+        world[i] = world_[s];
+        flags[i] = flags_[s];
+        slot_[id[i]] = i;
+    }
+    id_.swap(id);
+    parent_.swap(parent);
+    position_.swap(position);
+    orientation_.swap(orientation);
+    scale_.swap(scale);
+    world_.swap(world);
+    flags_.swap(flags);
+
+    sorted_ = true;
+}
+
+void TransformSystem::update() {
+    sort();
+    updated_ = 0;
+    for (std::size_t level = 0; level < levels(); ++ level) {
+        updated_ += updateSlots(levelStart_[level], levelStart_[level + 1]);
+    }
+}
+
+void TransformSystem::update(core::Jobs& jobs, std::size_t grain) {
+    if (!jobs.parallel()) {
+        update();
+        return;
+    }
+    sort();
+    updated_ = 0;
+    grain = std::max<std::size_t>(grain, 1);
+
+    for (std::size_t level = 0; level < levels(); ++ level) {
+        std::size_t first = levelStart_[level];
+        std::size_t last = levelStart_[level + 1];
+        if (last - first <= grain) {
+            updated_ += updateSlots(first, last);
+            continue;
+        }
+        // chunks write disjoint slots, and read only the level above
+        std::atomic<std::size_t> count { 0 };
+        std::size_t chunks = (last - first + grain - 1) / grain;
+        jobs.parallel_for(0, chunks, 1, [&](std::size_t chunk) {
+            std::size_t begin = first + chunk * grain;
+            std::size_t end = std::min(begin + grain, last);
+            count.fetch_add(updateSlots(begin, end), std::memory_order_relaxed);
+        });
+        updated_ += count.load(std::memory_order_relaxed);
+    }
+}
+
+std::size_t TransformSystem::updateSlots(std::size_t first, std::size_t last) {
+    std::size_t count = 0;
+    for (std::size_t s = first; s < last; ++ s) {
+        std::uint32_t p = parent_[s];
+        bool recompute = (flags_[s] & DIRTY)
+                || (p != NO_SLOT && (flags_[p] & CHANGED));
+        if (!recompute) {
+            flags_[s] = 0;
+            continue;
+        }
+        if (p == NO_SLOT) {
+            world_[s] = compose(s);
+        } else {
+            multiply(world_[p], compose(s), world_[s]);
+        }
+        flags_[s] = CHANGED;
+        ++ count;
+    }
+    return count;
+}
+
+} /* namespace scene */
+} /* namespace zephyr */
@@ -0,0 +1,202 @@
+/**
+ * @file TransformSystem.hpp
+ */
+
+#ifndef ZEPHYR_SCENE_TRANSFORMSYSTEM_HPP_
+#define ZEPHYR_SCENE_TRANSFORMSYSTEM_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+namespace zephyr {
+
+namespace core {
+class Jobs;
+} /* namespace core */
+
+namespace scene {
+
+struct Vec3 {
+    float x, y, z;
+};
+
+/** Rotation quaternion, in the component order of glm::quat */
+struct Quat {
+    float x, y, z, w;
+};
+
+/** Column-major 4x4 matrix, with the memory layout of glm::mat4 */
+struct Mat4 {
+    float m[16];
+};
+
+/** Stable handle of a transform, unaffected by reordering */
+typedef std::uint32_t TransformId;
+
+
+/**
+ * Transforms of the scene graph nodes, stored in contiguous arrays (one per
+ * component - position, orientation, scale, world matrix) sorted by depth,
+ * so that parents always come before their children.
+ *
+ * Changing the local transform marks it dirty. @ref update() computes world
+ * matrices in a single linear pass, recomputing only the dirty transforms
+ * and the descendants of the ones that changed; parent-child matrix product
+ * uses SSE if available. Structural changes (creating, destroying and
+ * reparenting) only mark the order stale, arrays are re-sorted by the next
+ * @ref update().
+ *
+ * Transforms of one level depend only on the level above, so each level can
+ * be split into chunks and computed by several threads - see
+ * @ref update(core::Jobs&, std::size_t).
+ */
+class TransformSystem {
+public:
+
+    static constexpr TransformId NONE = static_cast<TransformId>(-1);
+
+    /** Default number of transforms computed by a single job */
+    static constexpr std::size_t DEFAULT_GRAIN = 2048;
+
+    /**
+     * Creates identity transform.
+     *
+     * @param parent Parent transform, @c NONE for a root
+     */
+    TransformId create(TransformId parent = NONE);
+
+    /**
+     * Destroys the transform. Its children become roots.
+     */
+    void destroy(TransformId id);
+
+    void setParent(TransformId id, TransformId parent);
+
+    TransformId parent(TransformId id) const;
+
+    const Vec3& position(TransformId id) const {
+        return position_[slot_[id]];
+    }
+
+    const Quat& orientation(TransformId id) const {
+        return orientation_[slot_[id]];
+    }
+
+    const Vec3& scale(TransformId id) const {
+        return scale_[slot_[id]];
+    }
+
+    void setPosition(TransformId id, const Vec3& position) {
+        std::uint32_t s = slot_[id];
+        position_[s] = position;
+        flags_[s] |= DIRTY;
+    }
+
+    void setOrientation(TransformId id, const Quat& orientation) {
+        std::uint32_t s = slot_[id];
+        orientation_[s] = orientation;
+        flags_[s] |= DIRTY;
+    }
+
+    void setScale(TransformId id, const Vec3& scale) {
+        std::uint32_t s = slot_[id];
+        scale_[s] = scale;
+        flags_[s] |= DIRTY;
+    }
+
+    /** World matrix computed by the last @ref update() */
+    const Mat4& world(TransformId id) const {
+        return world_[slot_[id]];
+    }
+
+    /** Whether the world matrix changed in the last @ref update() */
+    bool changed(TransformId id) const {
+        return flags_[slot_[id]] & CHANGED;
+    }
+
+    /** Local matrix of the current position, orientation and scale */
+    Mat4 local(TransformId id) const;
+
+    /** Recomputes world matrices of the changed transforms */
+    void update();
+
+    /**
+     * Recomputes world matrices of the changed transforms, distributing each
+     * level larger than @c grain over the worker threads in chunks of
+     * @c grain transforms. Levels are processed one after another. Without
+     * parallel jobs, it is equivalent to @ref update().
+     *
+     * @param jobs Job facility used to fan out the levels
+     * @param grain Number of transforms computed by a single job
+     */
+    void update(core::Jobs& jobs, std::size_t grain = DEFAULT_GRAIN);
+
+    /** Number of live transforms */
+    std::size_t size() const {
+        return count_;
+    }
+
+    /** Number of world matrices recomputed by the last @ref update() */
+    std::size_t updated() const {
+        return updated_;
+    }
+
+    /** Number of tree levels, valid after @ref update() */
+    std::size_t levels() const {
+        return levelStart_.empty() ? 0 : levelStart_.size() - 1;
+    }
+
+    /** First slot of the level; level @c n occupies [start(n), start(n + 1)) */
+    std::size_t levelStart(std::size_t level) const {
+        return levelStart_[level];
+    }
+
+    /**
+     * Recomputes the slots in range, which must lie within one level, and
+     * the levels above must be up to date.
+     *
+     * @return Number of recomputed world matrices
+     */
+    std::size_t updateSlots(std::size_t first, std::size_t last);
+
+    /** Re-sorts the arrays if the structure changed */
+    void sort();
+
+private:
+    enum : std::uint8_t {
+        DIRTY = 1,
+        CHANGED = 2
+    };
+
+    static const std::uint32_t NO_SLOT = static_cast<std::uint32_t>(-1);
+
+    Mat4 compose(std::uint32_t slot) const;
+
+    // per slot, id is NONE for destroyed transforms until the next sort
+    std::vector<TransformId> id_;
+    std::vector<std::uint32_t> parent_;
+    std::vector<Vec3> position_;
+    std::vector<Quat> orientation_;
+    std::vector<Vec3> scale_;
+    std::vector<Mat4> world_;
+    std::vector<std::uint8_t> flags_;
+
+    // per id
+    std::vector<std::uint32_t> slot_;
+    std::vector<TransformId> free_;
+
+    std::vector<std::size_t> levelStart_;
+    std::size_t count_ = 0;
+    bool sorted_ = true;
+    std::size_t updated_ = 0;
+};
+
+/** Product of column-major 4x4 matrices */
+void multiply(const Mat4& a, const Mat4& b, Mat4& out);
+
+} /* namespace scene */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_SCENE_TRANSFORMSYSTEM_HPP_ */
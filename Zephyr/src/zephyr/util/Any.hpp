@@ -9,12 +9,9 @@
 #include <memory>
 #include <type_traits>
 #include <zephyr/util/make_unique.hpp>
+#include <zephyr/util/print_value.hpp>
 #include <boost/any.hpp>
 
-#ifdef __GLIBC__
-    #include <cxxabi.h>
-#endif /* __GLIBC__ */
-
 
 namespace zephyr {
 namespace util {
@@ -33,54 +30,6 @@ struct printer {
 
 namespace {
 
-template <typename T>
-const char* get_name() {
-
-#ifdef __GLIBC__
-    int status;
-    return abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status);
-#else
-    return "[non-printable]";
-#endif /* __GLIBC__ */
-
-}
-
-
-template <typename T>
-struct is_printable_helper {
-
-    template <typename U>
-    static std::true_type test(
-        char(*)[sizeof(std::declval<std::ostream&>() << std::declval<U>())]
-    );
-
-    template <typename U>
-    static std::false_type test(...);
-
-    typedef decltype(test<T>(nullptr)) type;
-
-};
-
-template <typename T>
-struct is_printable: is_printable_helper<T>::type {};
-
-template <typename T>
-void print_value(std::ostream& os, const T& value, std::true_type) {
-    os << value;
-}
-
-template <typename T>
-void print_value(std::ostream& os, const T&, std::false_type) {
-    os << get_name<T>();
-}
-
-
-template <typename T>
-void print_value(std::ostream& os, const T& value) {
-    print_value(os, value, typename is_printable<T>::type());
-}
-
-
 template <typename T>
 struct printer_impl: printer {
 
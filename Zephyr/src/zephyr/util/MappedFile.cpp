@@ -0,0 +1,84 @@
+/**
+ * @file MappedFile.cpp
+ */
+
+#include <zephyr/util/MappedFile.hpp>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace zephyr {
+namespace util {
+
+namespace {
+
+std::runtime_error error(const char* what, const std::string& path) {
+    return std::runtime_error { std::string(what) + " " + path + ": "
+        + std::strerror(errno) };
+}
+
+} /* namespace */
+
+
+MappedFile::MappedFile(const std::string& path) {
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw error("Cannot open file", path);
+    }
+    struct stat info;
+    if (::fstat(fd, &info) < 0) {
+        ::close(fd);
+        throw error("Cannot stat file", path);
+    }
+    size_ = info.st_size;
+    if (size_ > 0) {
+        void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (address == MAP_FAILED) {
+            ::close(fd);
+            throw error("Cannot map file", path);
+        }
+        // whole file is going to be read front to back
+        ::madvise(address, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(address);
+    }
+    // mapping stays valid after the descriptor is closed
+    ::close(fd);
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+: data_ { other.data_ }
+, size_ { other.size_ }
+{
+    other.data_ = nullptr;
+    other.size_ = 0;
+}
+
+MappedFile& MappedFile::operator = (MappedFile&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        std::swap(data_, other.data_);
+        std::swap(size_, other.size_);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    unmap();
+}
+
+void MappedFile::unmap() {
+    if (data_) {
+        ::munmap(const_cast<char*>(data_), size_);
+        data_ = nullptr;
+        size_ = 0;
+    }
+}
+
+} /* namespace util */
+} /* namespace zephyr */
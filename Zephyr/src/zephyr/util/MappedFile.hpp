@@ -0,0 +1,64 @@
+/**
+ * @file MappedFile.hpp
+ */
+
+#ifndef ZEPHYR_UTIL_MAPPEDFILE_HPP_
+#define ZEPHYR_UTIL_MAPPEDFILE_HPP_
+
+#include <cstddef>
+#include <string>
+
+
+namespace zephyr {
+namespace util {
+
+/**
+ * Read-only memory mapping of the whole file. Contents are paged in by the OS
+ * as they are accessed, nothing is copied. Mapping is released in the
+ * destructor.
+ */
+class MappedFile {
+public:
+
+    /**
+     * Maps the file.
+     *
+     * @throws std::runtime_error if the file cannot be opened or mapped
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator = (const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator = (MappedFile&& other) noexcept;
+
+    ~MappedFile();
+
+    const char* begin() const {
+        return data_;
+    }
+
+    const char* end() const {
+        return data_ + size_;
+    }
+
+    const char* data() const {
+        return data_;
+    }
+
+    std::size_t size() const {
+        return size_;
+    }
+
+private:
+    void unmap();
+
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+} /* namespace util */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_UTIL_MAPPEDFILE_HPP_ */
@@ -0,0 +1,282 @@
+/**
+ * @file Payload.hpp
+ */
+
+#ifndef ZEPHYR_UTIL_PAYLOAD_HPP_
+#define ZEPHYR_UTIL_PAYLOAD_HPP_
+
+#include <zephyr/util/print_value.hpp>
+#include <cstring>
+#include <iostream>
+#include <new>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+
+
+namespace zephyr {
+namespace util {
+
+namespace detail {
+
+#if defined(__GNUC__) && !defined(__clang__) && __GNUC__ < 5
+    // libstdc++ shipped with gcc 4.x lacks std::is_trivially_copyable
+    template <typename T>
+    struct is_trivially_copyable: std::integral_constant<bool,
+        __has_trivial_copy(T) && __has_trivial_destructor(T)> { };
+#else
+    using std::is_trivially_copyable;
+#endif
+
+/** Buffer used to store the small values inline */
+typedef std::aligned_storage<48>::type payload_buffer;
+
+/** Checks whether values of type @c T can be stored in the inline buffer */
+template <typename T>
+struct is_stored_inline: std::integral_constant<bool,
+    is_trivially_copyable<T>::value
+    && sizeof(T) <= sizeof(payload_buffer)
+    && alignof(T) <= alignof(payload_buffer)> { };
+
+} /* namespace detail */
+
+
+/**
+ * Type-erased value container for message contents. Unlike @ref Any, small
+ * trivially copyable values (events, positions, numbers) are stored inline
+ * and copied with @c memcpy, so creating and copying such payload never
+ * allocates. Larger or non-trivial values are stored on the heap.
+ *
+ * Type information and printing go through a static, per-type table of
+ * functions, shared by all the payloads of given type.
+ */
+class Payload {
+public:
+
+    /** Size of the inline buffer */
+    static constexpr std::size_t INLINE_SIZE = sizeof(detail::payload_buffer);
+
+    /** Creates empty payload */
+    Payload() noexcept
+    : vtable_ { nullptr }
+    { }
+
+    /** Creates payload holding a copy of the value */
+    template <typename T, typename = typename std::enable_if<
+        !std::is_same<typename std::decay<T>::type, Payload>::value>::type>
+    explicit Payload(const T& value)
+    : vtable_ { &Ops<T>::table }
+    {
+        Ops<T>::create(storage_, value);
+    }
+
+    Payload(const Payload& other)
+    : vtable_ { other.vtable_ }
+    {
+        if (vtable_) {
+            vtable_->copy(storage_, other.storage_);
+        }
+    }
+
+    Payload(Payload&& other) noexcept
+    : vtable_ { other.vtable_ }
+    {
+        if (vtable_) {
+            vtable_->move(storage_, other.storage_);
+            other.vtable_ = nullptr;
+        }
+    }
+
+    Payload& operator = (const Payload& other) {
+        if (this != &other) {
+            Payload copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    Payload& operator = (Payload&& other) noexcept {
+        if (this != &other) {
+            reset();
+            vtable_ = other.vtable_;
+            if (vtable_) {
+                vtable_->move(storage_, other.storage_);
+                other.vtable_ = nullptr;
+            }
+        }
+        return *this;
+    }
+
+    ~Payload() {
+        reset();
+    }
+
+    /** Destroys the contained value, if any */
+    void reset() noexcept {
+        if (vtable_) {
+            vtable_->destroy(storage_);
+            vtable_ = nullptr;
+        }
+    }
+
+    bool empty() const {
+        return vtable_ == nullptr;
+    }
+
+    /**
+     * @return @c true if the payload holds value of type @c T
+     */
+    template <typename T>
+    bool is() const {
+        return vtable_ == &Ops<T>::table;
+    }
+
+    /**
+     * @return Pointer to the contained value, or @c nullptr if the payload
+     *         does not hold value of type @c T
+     */
+    template <typename T>
+    const T* tryGet() const {
+        return is<T>() ? static_cast<const T*>(vtable_->get(storage_)) : nullptr;
+    }
+
+    template <typename T>
+    T* tryGet() {
+        return const_cast<T*>(static_cast<const Payload&>(*this).tryGet<T>());
+    }
+
+    /**
+     * @return Reference to the contained value
+     * @throws std::bad_cast if the payload does not hold value of type @c T
+     */
+    template <typename T>
+    const T& get() const {
+        if (const T* value = tryGet<T>()) {
+            return *value;
+        } else {
+            throw std::bad_cast();
+        }
+    }
+
+    template <typename T>
+    T& get() {
+        return const_cast<T&>(static_cast<const Payload&>(*this).get<T>());
+    }
+
+    /**
+     * @return @c true if values of type @c T are stored inline
+     */
+    template <typename T>
+    static constexpr bool storedInline() {
+        return detail::is_stored_inline<T>::value;
+    }
+
+    friend std::ostream& operator << (std::ostream& os, const Payload& payload) {
+        if (payload.vtable_) {
+            payload.vtable_->print(os, payload.vtable_->get(payload.storage_));
+        } else {
+            os << "[empty]";
+        }
+        return os;
+    }
+
+private:
+    /** Inline buffer, or pointer to the heap-allocated value */
+    union Storage {
+        detail::payload_buffer buffer;
+        void* heap;
+    };
+
+    /** Per-type operations */
+    struct VTable {
+        void (*copy)(Storage& dst, const Storage& src);
+        void (*move)(Storage& dst, Storage& src);
+        void (*destroy)(Storage& storage);
+        const void* (*get)(const Storage& storage);
+        void (*print)(std::ostream& os, const void* value);
+    };
+
+    template <typename T, bool Inline = detail::is_stored_inline<T>::value>
+    struct Ops;
+
+    const VTable* vtable_;
+    Storage storage_;
+};
+
+
+template <typename T>
+struct Payload::Ops<T, true> {
+
+    static void create(Storage& storage, const T& value) {
+        std::memcpy(&storage.buffer, &value, sizeof(T));
+    }
+
+    static void copy(Storage& dst, const Storage& src) {
+        std::memcpy(&dst.buffer, &src.buffer, sizeof(T));
+    }
+
+    static void move(Storage& dst, Storage& src) {
+        std::memcpy(&dst.buffer, &src.buffer, sizeof(T));
+    }
+
+    static void destroy(Storage&) {
+        // trivially destructible
+    }
+
+    static const void* get(const Storage& storage) {
+        return &storage.buffer;
+    }
+
+    static void print(std::ostream& os, const void* value) {
+        print_value(os, *static_cast<const T*>(value));
+    }
+
+    static const VTable table;
+};
+
+template <typename T>
+const Payload::VTable Payload::Ops<T, true>::table = {
+    &copy, &move, &destroy, &get, &print
+};
+
+
+template <typename T>
+struct Payload::Ops<T, false> {
+
+    static void create(Storage& storage, const T& value) {
+        storage.heap = new T(value);
+    }
+
+    static void copy(Storage& dst, const Storage& src) {
+        dst.heap = new T(*static_cast<const T*>(src.heap));
+    }
+
+    static void move(Storage& dst, Storage& src) {
+        dst.heap = src.heap;
+        src.heap = nullptr;
+    }
+
+    static void destroy(Storage& storage) {
+        delete static_cast<T*>(storage.heap);
+    }
+
+    static const void* get(const Storage& storage) {
+        return storage.heap;
+    }
+
+    static void print(std::ostream& os, const void* value) {
+        print_value(os, *static_cast<const T*>(value));
+    }
+
+    static const VTable table;
+};
+
+template <typename T>
+const Payload::VTable Payload::Ops<T, false>::table = {
+    &copy, &move, &destroy, &get, &print
+};
+
+} /* namespace util */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_UTIL_PAYLOAD_HPP_ */
@@ -0,0 +1,316 @@
+/**
+ * @file Pool.hpp
+ */
+
+#ifndef ZEPHYR_UTIL_POOL_HPP_
+#define ZEPHYR_UTIL_POOL_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace zephyr {
+namespace util {
+
+/**
+ * 32-bit reference to an object stored in a @ref Pool of @c T - slot index in
+ * the lower @ref INDEX_BITS, generation of the slot in the remaining ones.
+ * When the object is released, generation of its slot changes, so handles
+ * still referring to it are recognized as stale instead of pointing to the
+ * next object stored there.
+ *
+ * Default-constructed handle is null, it never refers to any object.
+ */
+template <typename T>
+class Handle {
+public:
+
+    static constexpr unsigned INDEX_BITS = 24;
+    static constexpr std::uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1;
+    static constexpr std::uint32_t MAX_GENERATION = (1u << (32 - INDEX_BITS)) - 1;
+
+    Handle() noexcept
+    : value_ { 0 }
+    { }
+
+    Handle(std::uint32_t index, std::uint32_t generation) noexcept
+    : value_ { (generation << INDEX_BITS) | (index & INDEX_MASK) }
+    { }
+
+    std::uint32_t index() const {
+        return value_ & INDEX_MASK;
+    }
+
+    /** Generation of the slot, never 0 for non-null handles */
+    std::uint32_t generation() const {
+        return value_ >> INDEX_BITS;
+    }
+
+    /** Packed index and generation */
+    std::uint32_t value() const {
+        return value_;
+    }
+
+    explicit operator bool () const {
+        return value_ != 0;
+    }
+
+    friend bool operator == (Handle a, Handle b) {
+        return a.value_ == b.value_;
+    }
+
+    friend bool operator != (Handle a, Handle b) {
+        return a.value_ != b.value_;
+    }
+
+    friend bool operator < (Handle a, Handle b) {
+        return a.value_ < b.value_;
+    }
+
+private:
+    std::uint32_t value_;
+};
+
+template <typename T>
+constexpr unsigned Handle<T>::INDEX_BITS;
+
+template <typename T>
+constexpr std::uint32_t Handle<T>::INDEX_MASK;
+
+template <typename T>
+constexpr std::uint32_t Handle<T>::MAX_GENERATION;
+
+
+/**
+ * Storage of objects of type @c T addressed by @ref Handle. Objects are
+ * constructed in place in chunks of @ref CHUNK_SIZE slots, and never move -
+ * pointers and references stay valid until the object is destroyed, and
+ * objects created together lie next to each other in memory. Slots of the
+ * destroyed objects are reused.
+ *
+ * Objects are destroyed either right away with @ref release(), or with
+ * @ref releaseLater(), which invalidates the handle immediately but keeps
+ * the object until @ref collect() - e.g. until the frame that may still use
+ * it is finished, or until the thread owning the GL context gets to delete
+ * its GL objects.
+ *
+ * Pool is not synchronized.
+ */
+template <typename T>
+class Pool {
+public:
+
+    typedef Handle<T> HandleType;
+
+    /** Number of slots in a chunk */
+    static constexpr std::size_t CHUNK_SIZE = 256;
+
+    Pool() = default;
+
+    Pool(const Pool&) = delete;
+    Pool& operator = (const Pool&) = delete;
+
+    ~Pool() {
+        collect();
+        for (std::uint32_t i = 0; i < live_.size(); ++ i) {
+            if (live_[i]) {
+                slot(i)->~T();
+            }
+        }
+    }
+
+    /**
+     * Constructs the object in a free slot.
+     *
+     * @return Handle of the new object
+     */
+    template <typename... Args>
+    HandleType create(Args&&... args) {
+        std::uint32_t index = acquire();
+        try {
+            new (slot(index)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            free_.push_back(index);
+            throw;
+        }
+        live_[index] = true;
+        ++ size_;
+        return HandleType { index, generation_[index] };
+    }
+
+    /**
+     * @return Whether the handle refers to a live object of this pool
+     */
+    bool alive(HandleType handle) const {
+        std::uint32_t index = handle.index();
+        return index < live_.size() && live_[index]
+            && generation_[index] == handle.generation();
+    }
+
+    /**
+     * @return Object referred to by the handle, or @c nullptr if the handle
+     *         is null or stale
+     */
+    T* get(HandleType handle) {
+        return alive(handle) ? slot(handle.index()) : nullptr;
+    }
+
+    const T* get(HandleType handle) const {
+        return const_cast<Pool&>(*this).get(handle);
+    }
+
+    /**
+     * @throws std::logic_error if the handle is null or stale
+     */
+    T& operator [] (HandleType handle) {
+        if (!alive(handle)) {
+            throw std::logic_error("Invalid or stale handle");
+        }
+        return *slot(handle.index());
+    }
+
+    const T& operator [] (HandleType handle) const {
+        return const_cast<Pool&>(*this)[handle];
+    }
+
+    /**
+     * Destroys the object immediately.
+     *
+     * @throws std::logic_error if the handle is null or stale
+     */
+    void release(HandleType handle) {
+        std::uint32_t index = invalidate(handle);
+        slot(index)->~T();
+        free_.push_back(index);
+    }
+
+    /**
+     * Invalidates the handle, object is destroyed by the next
+     * @ref collect().
+     *
+     * @throws std::logic_error if the handle is null or stale
+     */
+    void releaseLater(HandleType handle) {
+        pending_.push_back(invalidate(handle));
+    }
+
+    /**
+     * Destroys the objects released with @ref releaseLater().
+     *
+     * @return Number of destroyed objects
+     */
+    std::size_t collect() {
+        std::size_t count = pending_.size();
+        for (std::uint32_t index : pending_) {
+            slot(index)->~T();
+            free_.push_back(index);
+        }
+        pending_.clear();
+        return count;
+    }
+
+    /**
+     * Invokes @c fun(handle, object) for each live object, in the order of
+     * slots.
+     */
+    template <typename Fun>
+    void forEach(Fun fun) {
+        for (std::uint32_t i = 0; i < live_.size(); ++ i) {
+            if (live_[i]) {
+                fun(HandleType { i, generation_[i] }, *slot(i));
+            }
+        }
+    }
+
+    /** Number of live objects */
+    std::size_t size() const {
+        return size_;
+    }
+
+    /** Number of objects waiting for @ref collect() */
+    std::size_t pending() const {
+        return pending_.size();
+    }
+
+    /** Number of slots allocated so far */
+    std::size_t capacity() const {
+        return chunks_.size() * CHUNK_SIZE;
+    }
+
+private:
+    typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type Storage;
+
+    T* slot(std::uint32_t index) {
+        Storage& storage = chunks_[index / CHUNK_SIZE][index % CHUNK_SIZE];
+        return reinterpret_cast<T*>(&storage);
+    }
+
+    std::uint32_t acquire() {
+        if (!free_.empty()) {
+            std::uint32_t index = free_.back();
+            free_.pop_back();
+            return index;
+        }
+        std::uint32_t index = static_cast<std::uint32_t>(live_.size());
+        if (index > HandleType::INDEX_MASK) {
+            throw std::length_error("Pool capacity exceeded");
+        }
+        if (index == capacity()) {
+            chunks_.emplace_back(new Storage[CHUNK_SIZE]);
+        }
+        live_.push_back(false);
+        generation_.push_back(1);
+        return index;
+    }
+
+    /** Marks the slot dead and advances its generation, skipping 0 */
+    std::uint32_t invalidate(HandleType handle) {
+        if (!alive(handle)) {
+            throw std::logic_error("Releasing invalid or stale handle");
+        }
+        std::uint32_t index = handle.index();
+        live_[index] = false;
+        std::uint32_t& generation = generation_[index];
+        generation = generation == HandleType::MAX_GENERATION ? 1 : generation + 1;
+        -- size_;
+        return index;
+    }
+
+    std::vector<std::unique_ptr<Storage[]>> chunks_;
+
+    // per slot
+    std::vector<bool> live_;
+    std::vector<std::uint32_t> generation_;
+
+    std::vector<std::uint32_t> free_;
+    std::vector<std::uint32_t> pending_;
+
+    std::size_t size_ = 0;
+};
+
+template <typename T>
+constexpr std::size_t Pool<T>::CHUNK_SIZE;
+
+} /* namespace util */
+} /* namespace zephyr */
+
+
+namespace std {
+
+template <typename T>
+struct hash<zephyr::util::Handle<T>> {
+    std::size_t operator ()(zephyr::util::Handle<T> handle) const {
+        return std::hash<std::uint32_t>()(handle.value());
+    }
+};
+
+} /* namespace std */
+
+#endif /* ZEPHYR_UTIL_POOL_HPP_ */
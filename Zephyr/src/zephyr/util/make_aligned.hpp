@@ -0,0 +1,105 @@
+/**
+ * @file make_aligned.hpp
+ *
+ * Allocation of over-aligned objects. Before C++17, plain @c new does not
+ * honour alignment greater than the one of @c std::max_align_t.
+ */
+
+#ifndef ZEPHYR_UTIL_MAKE_ALIGNED_HPP_
+#define ZEPHYR_UTIL_MAKE_ALIGNED_HPP_
+
+#include <cstddef>
+#include <cstdlib>
+#include <memory>
+#include <new>
+#include <utility>
+#include <stdlib.h>
+
+namespace zephyr {
+namespace util {
+
+namespace detail {
+
+/**
+ * Allocates storage for @c count objects of type @c T, aligned as required by
+ * the type.
+ *
+ * @throws std::bad_alloc if the memory cannot be allocated
+ */
+template <typename T>
+T* allocate_aligned(std::size_t count) {
+    std::size_t align = alignof(T) < sizeof(void*) ? sizeof(void*) : alignof(T);
+    void* memory = nullptr;
+    if (::posix_memalign(&memory, align, count * sizeof(T)) != 0) {
+        throw std::bad_alloc { };
+    }
+    return static_cast<T*>(memory);
+}
+
+} /* namespace detail */
+
+
+/** Deleter of the objects created by @ref make_aligned() */
+template <typename T>
+struct aligned_delete {
+    void operator () (T* object) const {
+        object->~T();
+        std::free(object);
+    }
+};
+
+/** Deleter of the arrays created by @ref make_aligned_array() */
+template <typename T>
+struct aligned_delete<T[]> {
+    std::size_t count;
+
+    void operator () (T* objects) const {
+        for (std::size_t i = count; i > 0; -- i) {
+            objects[i - 1].~T();
+        }
+        std::free(objects);
+    }
+};
+
+template <typename T>
+using aligned_ptr = std::unique_ptr<T, aligned_delete<T>>;
+
+
+/**
+ * Creates object with alignment required by its type, forwarding specified
+ * arguments to appropriate constructor.
+ */
+template <typename T, typename... Args>
+aligned_ptr<T> make_aligned(Args&&... args) {
+    T* memory = detail::allocate_aligned<T>(1);
+    try {
+        return aligned_ptr<T> { new (memory) T(std::forward<Args>(args)...) };
+    } catch (...) {
+        std::free(memory);
+        throw;
+    }
+}
+
+/**
+ * Creates array of default-constructed objects, with alignment required by
+ * their type.
+ */
+template <typename T>
+aligned_ptr<T[]> make_aligned_array(std::size_t count) {
+    T* memory = detail::allocate_aligned<T>(count);
+    std::size_t i = 0;
+    try {
+        for (; i < count; ++ i) {
+            new (memory + i) T();
+        }
+    } catch (...) {
+        aligned_delete<T[]> { i }(memory);
+        throw;
+    }
+    return aligned_ptr<T[]> { memory, aligned_delete<T[]> { count } };
+}
+
+} /* namespace util */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_UTIL_MAKE_ALIGNED_HPP_ */
@@ -0,0 +1,76 @@
+/**
+ * @file print_value.hpp
+ *
+ * Printing values of arbitrary types, used by type-erased containers.
+ */
+
+#ifndef ZEPHYR_UTIL_PRINT_VALUE_HPP_
+#define ZEPHYR_UTIL_PRINT_VALUE_HPP_
+
+#include <iostream>
+#include <typeinfo>
+#include <type_traits>
+#include <utility>
+
+#ifdef __GLIBC__
+    #include <cxxabi.h>
+#endif /* __GLIBC__ */
+
+
+namespace zephyr {
+namespace util {
+
+template <typename T>
+const char* get_name() {
+
+#ifdef __GLIBC__
+    int status;
+    return abi::__cxa_demangle(typeid(T).name(), nullptr, nullptr, &status);
+#else
+    return "[non-printable]";
+#endif /* __GLIBC__ */
+
+}
+
+
+template <typename T>
+struct is_printable_helper {
+
+    template <typename U>
+    static std::true_type test(
+        char(*)[sizeof(std::declval<std::ostream&>() << std::declval<U>())]
+    );
+
+    template <typename U>
+    static std::false_type test(...);
+
+    typedef decltype(test<T>(nullptr)) type;
+
+};
+
+template <typename T>
+struct is_printable: is_printable_helper<T>::type {};
+
+template <typename T>
+void print_value(std::ostream& os, const T& value, std::true_type) {
+    os << value;
+}
+
+template <typename T>
+void print_value(std::ostream& os, const T&, std::false_type) {
+    os << get_name<T>();
+}
+
+/**
+ * Prints the value using its stream insertion operator, or the name of the
+ * type if there is none.
+ */
+template <typename T>
+void print_value(std::ostream& os, const T& value) {
+    print_value(os, value, typename is_printable<T>::type());
+}
+
+} /* namespace util */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_UTIL_PRINT_VALUE_HPP_ */
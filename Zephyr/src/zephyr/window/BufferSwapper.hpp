@@ -6,29 +6,29 @@
 #define ZEPHYR_GFX_BUFFERSWAPPER_H_
 
 #include <zephyr/core/Task.hpp>
-#include <zephyr/window/Window.hpp>
+#include <zephyr/window/Surface.hpp>
 
 namespace zephyr {
 namespace window {
 
 /**
- * Task invoking Window#swapBuffers method for every update.
+ * Task invoking Surface#swapBuffers method for every update.
  */
 class BufferSwapper : public core::Task {
 public:
 
-    BufferSwapper(const Window& window)
-    : window_(window)
+    BufferSwapper(Surface& surface)
+    : surface_(surface)
     { }
 
-    /** Swaps buffer of the associated window */
+    /** Swaps buffer of the associated surface */
     void update() override {
-        window_.swapBuffers();
+        surface_.swapBuffers();
     };
 
 private:
-    /** Window whose buffers are swapped by this task */
-    const Window& window_;
+    /** Surface whose buffers are swapped by this task */
+    Surface& surface_;
 };
 
 } /* namespace window */
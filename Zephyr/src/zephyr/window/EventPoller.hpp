@@ -6,7 +6,7 @@
 #define ZEPHYR_GFX_EVENTPOLLER_H_
 
 #include <zephyr/core/Task.hpp>
-#include <zephyr/window/Window.hpp>
+#include <zephyr/window/Surface.hpp>
 
 namespace zephyr {
 namespace window {
@@ -17,18 +17,18 @@ namespace window {
 class EventPoller : public core::Task {
 public:
 
-    EventPoller(const Window& window)
-    : window_(window)
+    EventPoller(Surface& surface)
+    : surface_(surface)
     { }
 
     /** Swaps buffer of the associated window */
     void update() override {
-        window_.pollEvents();
+        surface_.pollEvents();
     };
 
 private:
-    /** Window whose buffers are swapped by this task */
-    const Window& window_;
+    /** Surface whose events are polled by this task */
+    Surface& surface_;
 };
 
 } /* namespace window */
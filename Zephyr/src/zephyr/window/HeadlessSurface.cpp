@@ -0,0 +1,142 @@
+/**
+ * @file HeadlessSurface.cpp
+ */
+
+#include <zephyr/window/HeadlessSurface.hpp>
+#include <zephyr/messages.hpp>
+#include <zephyr/util/format.hpp>
+#include <EGL/eglext.h>
+#include <iostream>
+#include <stdexcept>
+
+namespace zephyr {
+namespace window {
+
+HeadlessSurface::HeadlessSurface(int width, int height, std::size_t frames,
+        MessageQueue& queue)
+: width_ { width }
+, height_ { height }
+, limit_ { frames }
+, frames_ { 0 }
+, queue_(queue)
+, display_ { EGL_NO_DISPLAY }
+, context_ { EGL_NO_CONTEXT }
+, frameBuffer_ { 0 }
+, colorBuffer_ { 0 }
+, depthBuffer_ { 0 }
+{
+    createContext();
+    glewInit();
+    createFrameBuffer();
+    start_ = std::chrono::steady_clock::now();
+}
+
+HeadlessSurface::~HeadlessSurface() {
+    glDeleteFramebuffers(1, &frameBuffer_);
+    glDeleteRenderbuffers(1, &colorBuffer_);
+    glDeleteRenderbuffers(1, &depthBuffer_);
+
+    eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    eglDestroyContext(display_, context_);
+    eglTerminate(display_);
+}
+
+void HeadlessSurface::createContext() {
+#ifdef EGL_PLATFORM_SURFACELESS_MESA
+    auto getPlatformDisplay = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+    if (getPlatformDisplay) {
+        display_ = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA,
+                EGL_DEFAULT_DISPLAY, nullptr);
+    }
+#endif
+    if (display_ == EGL_NO_DISPLAY) {
+        display_ = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    }
+    EGLint major, minor;
+    if (display_ == EGL_NO_DISPLAY || !eglInitialize(display_, &major, &minor)) {
+        throw std::runtime_error("Cannot initialize EGL display");
+    }
+    std::cout << "[Window] Headless, EGL " << major << "." << minor << ", "
+            << eglQueryString(display_, EGL_VENDOR) << std::endl;
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        throw std::runtime_error("EGL does not support OpenGL");
+    }
+    // default surface type is EGL_WINDOW_BIT, which surfaceless displays
+    // have no configs for
+    const EGLint configAttribs[] = {
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint count = 0;
+    if (!eglChooseConfig(display_, configAttribs, &config, 1, &count)
+            || count == 0) {
+        throw std::runtime_error("No suitable EGL config");
+    }
+    // compatibility profile, like the GLFW window - in the core profile
+    // glGetString(GL_EXTENSIONS) fails, and GLEW leaves extensions unloaded
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION_KHR, 3,
+        EGL_CONTEXT_MINOR_VERSION_KHR, 3,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK_KHR,
+            EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT_KHR,
+        EGL_NONE
+    };
+    context_ = eglCreateContext(display_, config, EGL_NO_CONTEXT,
+            contextAttribs);
+    if (context_ == EGL_NO_CONTEXT) {
+        throw std::runtime_error("Cannot create OpenGL 3.3 context");
+    }
+    // needs EGL_KHR_surfaceless_context
+    if (!eglMakeCurrent(display_, EGL_NO_SURFACE, EGL_NO_SURFACE, context_)) {
+        throw std::runtime_error("Cannot make surfaceless context current");
+    }
+}
+
+void HeadlessSurface::createFrameBuffer() {
+    glGenRenderbuffers(1, &colorBuffer_);
+    glBindRenderbuffer(GL_RENDERBUFFER, colorBuffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, width_, height_);
+
+    glGenRenderbuffers(1, &depthBuffer_);
+    glBindRenderbuffer(GL_RENDERBUFFER, depthBuffer_);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, width_,
+            height_);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &frameBuffer_);
+    glBindFramebuffer(GL_FRAMEBUFFER, frameBuffer_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0,
+            GL_RENDERBUFFER, colorBuffer_);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,
+            GL_RENDERBUFFER, depthBuffer_);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    if (status != GL_FRAMEBUFFER_COMPLETE) {
+        throw std::runtime_error("Error while creating offscreen framebuffer");
+    }
+}
+
+void HeadlessSurface::swapBuffers() {
+    // frame time should include the actual rendering, not just submission
+    glFinish();
+    ++ frames_;
+
+    if (frames_ == limit_) {
+        using namespace std::chrono;
+        double seconds = duration<double>(steady_clock::now() - start_).count();
+        std::cout << util::format("[Window] Headless run: {} frames in {} s, "
+                "{} fps", frames_, seconds, frames_ / seconds) << std::endl;
+        queue_.post({
+            zephyr::msg::SYSTEM,
+            zephyr::msg::QUIT
+        });
+    }
+}
+
+} /* namespace window */
+} /* namespace zephyr */
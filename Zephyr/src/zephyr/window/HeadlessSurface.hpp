@@ -0,0 +1,99 @@
+/**
+ * @file HeadlessSurface.hpp
+ */
+
+#ifndef ZEPHYR_WINDOW_HEADLESSSURFACE_HPP_
+#define ZEPHYR_WINDOW_HEADLESSSURFACE_HPP_
+
+#include <zephyr/window/Surface.hpp>
+#include <zephyr/core/MessageQueue.hpp>
+#include <EGL/egl.h>
+#include <chrono>
+#include <cstddef>
+
+
+namespace zephyr {
+namespace window {
+
+using core::MessageQueue;
+
+/**
+ * Surface without any window, for automated runs on machines with no display.
+ * GL context is created with EGL on a surfaceless display (e.g. Mesa
+ * llvmpipe), and frames are rendered into an offscreen framebuffer.
+ *
+ * After the specified number of frames, quit message is posted and time of
+ * the run is reported.
+ */
+class HeadlessSurface : public Surface {
+public:
+
+    /**
+     * @param width Width of the offscreen framebuffer
+     * @param height Height of the offscreen framebuffer
+     * @param frames Number of frames to render before quitting, 0 for no limit
+     * @param queue Message queue used for internal engine communication
+     */
+    HeadlessSurface(int width, int height, std::size_t frames,
+            MessageQueue& queue);
+
+    ~HeadlessSurface();
+
+    HeadlessSurface(const HeadlessSurface&) = delete;
+    HeadlessSurface& operator = (const HeadlessSurface&) = delete;
+
+    void framebufferSize(int& width, int& height) const override {
+        width = width_;
+        height = height_;
+    }
+
+    GLuint framebuffer() const override {
+        return frameBuffer_;
+    }
+
+    void swapInterval(int interval) override {
+        // nothing to synchronize with
+    }
+
+    void pollEvents() override {
+        // no events without a window
+    }
+
+    /**
+     * Waits for the frame to complete, quits after the last one.
+     */
+    void swapBuffers() override;
+
+    /** Number of frames finished so far */
+    std::size_t frames() const {
+        return frames_;
+    }
+
+private:
+
+    void createContext();
+
+    void createFrameBuffer();
+
+    int width_;
+    int height_;
+
+    std::size_t limit_;
+    std::size_t frames_;
+
+    MessageQueue& queue_;
+
+    EGLDisplay display_;
+    EGLContext context_;
+
+    GLuint frameBuffer_;
+    GLuint colorBuffer_;
+    GLuint depthBuffer_;
+
+    std::chrono::steady_clock::time_point start_;
+};
+
+} /* namespace window */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_WINDOW_HEADLESSSURFACE_HPP_ */
@@ -0,0 +1,54 @@
+/**
+ * @file Surface.hpp
+ */
+
+#ifndef ZEPHYR_WINDOW_SURFACE_HPP_
+#define ZEPHYR_WINDOW_SURFACE_HPP_
+
+#include <GL/glew.h>
+#include <GL/gl.h>
+
+
+namespace zephyr {
+namespace window {
+
+/**
+ * Destination of the rendered frames, owning the GL context - either a
+ * system window, or an offscreen framebuffer in the headless mode.
+ */
+class Surface {
+public:
+
+    virtual ~Surface() { }
+
+    /**
+     * Retrieves current size of the framebuffer, in pixels.
+     */
+    virtual void framebufferSize(int& width, int& height) const = 0;
+
+    /**
+     * @return Framebuffer object the final image should be drawn into, 0 for
+     *         the default one
+     */
+    virtual GLuint framebuffer() const = 0;
+
+    /**
+     * Sets the number of screen updates to wait for before swapping buffers.
+     */
+    virtual void swapInterval(int interval) = 0;
+
+    /**
+     * Processes pending events of the surface.
+     */
+    virtual void pollEvents() = 0;
+
+    /**
+     * Finishes the frame. Should be invoked at the end of each frame.
+     */
+    virtual void swapBuffers() = 0;
+};
+
+} /* namespace window */
+} /* namespace zephyr */
+
+#endif /* ZEPHYR_WINDOW_SURFACE_HPP_ */
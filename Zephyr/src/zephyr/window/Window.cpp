@@ -33,14 +33,25 @@ Window::Window(const InitInfo& info, MessageQueue& queue)
     mouseMode(mouseMode_);
 }
 
-void Window::pollEvents() const {
+void Window::pollEvents() {
     glfwPollEvents();
+    if (inputListener_) {
+        inputListener_->flush();
+    }
 }
 
-void Window::swapBuffers() const {
+void Window::swapBuffers() {
     glfwSwapBuffers(window_.get());
 }
 
+void Window::framebufferSize(int& width, int& height) const {
+    glfwGetFramebufferSize(window_.get(), &width, &height);
+}
+
+void Window::swapInterval(int interval) {
+    glfwSwapInterval(interval);
+}
+
 void Window::setupListeners(GLFWwindow* window) const {
     glfwSetMouseButtonCallback(window, &Window::mouseHandler);
     glfwSetCursorPosCallback(window, &Window::cursorHandler);
@@ -8,6 +8,7 @@
 #include <zephyr/input/InputListener.hpp>
 #include <zephyr/input/Position.hpp>
 #include <zephyr/core/MessageQueue.hpp>
+#include <zephyr/window/Surface.hpp>
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
 #include <memory>
@@ -54,7 +55,7 @@ struct window_deleter {
  * System-level window, providing basic graphics output functionality and
  * receiving and propagating input events related to keyboard and mouse.
  */
-class Window
+class Window : public Surface
 {
 public:
     /**
@@ -109,13 +110,21 @@ public:
      * Polls the underlying library, so that the events are delivered through
      * the previously set callbacks.
      */
-    void pollEvents() const;
+    void pollEvents() override;
     
     /**
      * Swaps graphic buffers of the window. Should be invoked at the end of
      * each frame.
      */
-    void swapBuffers() const;
+    void swapBuffers() override;
+
+    void framebufferSize(int& width, int& height) const override;
+
+    GLuint framebuffer() const override {
+        return 0;
+    }
+
+    void swapInterval(int interval) override;
 
 private:
     typedef std::unique_ptr<GLFWwindow, window_deleter> WindowPtr;
@@ -22,8 +22,12 @@ WindowSystem::WindowSystem(Context ctx)
 : config_(ctx.config)
 {
     std::cout << "[Window] Initializing the subsystem" << std::endl;
-    window_ = createWindow(ctx);
-    attachInputListener(ctx);
+    if (config_.get<bool>("zephyr.window.headless", false)) {
+        headless_ = createHeadless(ctx);
+    } else {
+        window_ = createWindow(ctx);
+        attachInputListener(ctx);
+    }
     runTasks(ctx.scheduler);
 
     registerHandler(ctx.dispatcher, msg::WINDOW, this, &WindowSystem::receive);
@@ -51,26 +55,51 @@ std::unique_ptr<Window> WindowSystem::createWindow(const Context& ctx) {
     }, ctx.messageQueue);
 }
 
+std::unique_ptr<HeadlessSurface> WindowSystem::createHeadless(
+        const Context& ctx) {
+    int width = config_.get("zephyr.window.width", 800);
+    int height = config_.get("zephyr.window.height", 600);
+    std::size_t frames = config_.get<std::size_t>(
+            "zephyr.window.headless-frames", 0);
+
+    std::cout << "[Window] Headless, size: " << width << "x" << height
+            << ", frames: " << frames << std::endl;
+    return util::make_unique<HeadlessSurface>(width, height, frames,
+            ctx.messageQueue);
+}
+
 void WindowSystem::runTasks(core::Scheduler& scheduler) {
     std::cout << "[Window] Registering swapper - " << SWAPPER_PRIORITY << std::endl;
-    core::TaskPtr swapper = std::make_shared<BufferSwapper>(*window_);
-    scheduler.startTask(SWAPPER_NAME, SWAPPER_PRIORITY, swapper);
+    core::TaskPtr swapper = std::make_shared<BufferSwapper>(surface());
+    scheduler.startTask(SWAPPER_NAME, SWAPPER_PRIORITY, swapper,
+            core::TaskConstraints().onMainThread());
 
     std::cout << "[Window] Registering poller - " << WINDOW_POLLER_PRIORITY << std::endl;
-    core::TaskPtr poller = std::make_shared<EventPoller>(*window_);
-    scheduler.startTask(WINDOW_POLLER_NAME, WINDOW_POLLER_PRIORITY, poller);
+    core::TaskPtr poller = std::make_shared<EventPoller>(surface());
+    scheduler.startTask(WINDOW_POLLER_NAME, WINDOW_POLLER_PRIORITY, poller,
+            core::TaskConstraints().onMainThread());
 }
 
 void WindowSystem::attachInputListener(const Context& ctx) {
     using input::MessageGenerator;
+    using input::CoalescingListener;
 
     std::cout << "[Window] Creating input listener" << std::endl;
     ListenerPtr listener = std::make_shared<MessageGenerator>(ctx.messageQueue);
+
+    if (config_.get<bool>("zephyr.window.coalesce-input", false)) {
+        std::cout << "[Window] Coalescing cursor & scroll events" << std::endl;
+        coalescer_ = std::make_shared<CoalescingListener>(listener);
+        listener = coalescer_;
+    }
     window_->setListener(listener);
 }
 
 void WindowSystem::receive(const Message& message) {
     std::cout << "[Window system] " << message << std::endl;
+    if (!window_) {
+        return;
+    }
     switch (message.type) {
     case msg::FULLSCREEN_ON:
         window_->fullscreen(true);
@@ -88,6 +117,9 @@ void WindowSystem::receive(const Message& message) {
 
 void WindowSystem::receiveAsInputSource(const Message& message) {
     std::cout << "[Window system (as input source)] " << message << std::endl;
+    if (!window_) {
+        return;
+    }
     switch (message.type) {
     case input::msg::MOUSE_ABS:
         window_->mouseMode(MouseMode::ABSOLUTE);
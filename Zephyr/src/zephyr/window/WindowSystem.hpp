@@ -6,6 +6,8 @@
 #define ZEPHYR_GFX_WINDOWSYSTEM_HPP_
 
 #include <zephyr/window/Window.hpp>
+#include <zephyr/window/HeadlessSurface.hpp>
+#include <zephyr/input/CoalescingListener.hpp>
 #include <zephyr/Context.hpp>
 #include <memory>
 
@@ -51,16 +53,48 @@ public:
 
     WindowSystem(Context ctx);
 
+    /**
+     * @return Input event coalescing stage, or @c nullptr if it is disabled
+     *         (see @c zephyr.window.coalesce-input)
+     */
+    const input::CoalescingListener* coalescer() const {
+        return coalescer_.get();
+    }
+
+    /**
+     * @return Surface the frames are rendered to - the window, or offscreen
+     *         framebuffer in the headless mode (see @c zephyr.window.headless)
+     */
+    Surface& surface() {
+        if (window_) {
+            return *window_;
+        } else {
+            return *headless_;
+        }
+    }
+
 private:
     core::Config& config_;
 
+    /** System window, @c nullptr in the headless mode */
     std::unique_ptr<Window> window_;
 
+    /** Offscreen surface used in the headless mode */
+    std::unique_ptr<HeadlessSurface> headless_;
+
+    /** Merges cursor moves and scrolls, if enabled */
+    std::shared_ptr<input::CoalescingListener> coalescer_;
+
     /**
      * Creates window subsystem.
      */
     std::unique_ptr<Window> createWindow(const Context& ctx);
 
+    /**
+     * Creates offscreen surface for the headless mode.
+     */
+    std::unique_ptr<HeadlessSurface> createHeadless(const Context& ctx);
+
     /**
      * Runs window-specific tasks.
      */
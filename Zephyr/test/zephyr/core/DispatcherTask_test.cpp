@@ -8,7 +8,7 @@
 
 using ::testing::_;
 using ::testing::Return;
-using zephyr::util::Any;
+using zephyr::util::Payload;
 
 namespace zephyr {
 namespace core {
@@ -26,10 +26,11 @@ struct DispatcherTaskTest: testing::Test {
 
     MessageQueue queue;
     DispatcherMock dispatcher;
+    FrameArena arena;
     DispatcherTask task;
 
     DispatcherTaskTest()
-    : task(queue, dispatcher)
+    : task(queue, dispatcher, arena)
     { }
 
 };
@@ -40,16 +41,16 @@ TEST_F(DispatcherTaskTest, DoesNothingForEmptyQueue) {
 }
 
 TEST_F(DispatcherTaskTest, DeliversSingleMessage) {
-    queue.post({ 10, 666, Any { 7 } });
+    queue.post({ 10, 666, Payload { 7 } });
     EXPECT_CALL(dispatcher, dispatch(_)).Times(1);
     task.update();
 }
 
 
 TEST_F(DispatcherTaskTest, DeliversAllMessages) {
-    queue.post({ 10, 666, Any { 7 } });
-    queue.post({ 17, 63, Any { 12 } });
-    queue.post({ 4, 66, Any { 67 } });
+    queue.post({ 10, 666, Payload { 7 } });
+    queue.post({ 17, 63, Payload { 12 } });
+    queue.post({ 4, 66, Payload { 67 } });
     EXPECT_CALL(dispatcher, dispatch(_)).Times(3);
     task.update();
 }
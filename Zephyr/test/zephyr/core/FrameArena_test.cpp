@@ -0,0 +1,112 @@
+/**
+ * @file FrameArena_test.cpp
+ */
+
+#include <zephyr/core/FrameArena.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace zephyr {
+namespace core {
+
+namespace {
+
+bool aligned(const void* p, std::size_t align) {
+    return reinterpret_cast<std::uintptr_t>(p) % align == 0;
+}
+
+} /* namespace */
+
+
+TEST(FrameArenaTest, AllocationsAreAlignedAndDisjoint) {
+    FrameArena arena { 1024 };
+    char* a = static_cast<char*>(arena.allocate(3, 1));
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(16);
+    EXPECT_TRUE(aligned(b, 8));
+    EXPECT_TRUE(aligned(c, FrameArena::MAX_ALIGN));
+    EXPECT_GE(static_cast<char*>(b), a + 3);
+    EXPECT_GE(static_cast<char*>(c), static_cast<char*>(b) + 8);
+    EXPECT_GE(arena.used(), 27u);
+}
+
+TEST(FrameArenaTest, DataSurvivesOneFrame) {
+    FrameArena arena { 1024 };
+    char* first = static_cast<char*>(arena.allocate(6));
+    std::strcpy(first, "frame");
+    arena.endFrame();
+
+    // other buffer, previous frame's data is intact
+    char* second = static_cast<char*>(arena.allocate(6));
+    EXPECT_NE(first, second);
+    EXPECT_STREQ("frame", first);
+    arena.endFrame();
+
+    // first buffer is reused
+    EXPECT_EQ(first, arena.allocate(6));
+}
+
+TEST(FrameArenaTest, GrowsToHighWaterMark) {
+    FrameArena arena { 256 };
+    for (int i = 0; i < 4; ++ i) {
+        arena.allocate(100);
+    }
+    EXPECT_GE(arena.used(), 400u);
+    arena.endFrame();
+    EXPECT_EQ(1u, arena.stats().overflows);
+    EXPECT_GE(arena.stats().highWater, 400u);
+
+    // each buffer grows when it is reset, before it is used again
+    for (int frame = 0; frame < 4; ++ frame) {
+        for (int i = 0; i < 4; ++ i) {
+            arena.allocate(100);
+        }
+        arena.endFrame();
+    }
+    EXPECT_EQ(1u, arena.stats().overflows);
+    EXPECT_GE(arena.stats().capacity, 400u);
+}
+
+TEST(FrameArenaTest, ConcurrentAllocationsDoNotOverlap) {
+    FrameArena arena { 64 * 1024 };
+    std::vector<std::thread> threads;
+    std::vector<std::vector<int*>> blocks(4);
+    for (int t = 0; t < 4; ++ t) {
+        threads.emplace_back([&arena, &blocks, t] {
+            for (int i = 0; i < 1000; ++ i) {
+                int* p = static_cast<int*>(arena.allocate(sizeof(int), 4));
+                *p = t * 1000 + i;
+                blocks[t].push_back(p);
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    for (int t = 0; t < 4; ++ t) {
+        for (int i = 0; i < 1000; ++ i) {
+            ASSERT_EQ(t * 1000 + i, *blocks[t][i]);
+        }
+    }
+}
+
+TEST(FrameArenaTest, VectorUsesArena) {
+    FrameArena arena { 4096 };
+    FrameVector<int> values { FrameAllocator<int> { arena } };
+    for (int i = 0; i < 100; ++ i) {
+        values.push_back(i);
+    }
+    EXPECT_EQ(99, values.back());
+    EXPECT_GE(arena.used(), 100 * sizeof(int));
+    EXPECT_EQ(0u, arena.stats().overflows);
+
+    FrameAllocator<double> other { values.get_allocator() };
+    EXPECT_TRUE(other == values.get_allocator());
+}
+
+} /* namespace core */
+} /* namespace zephyr */
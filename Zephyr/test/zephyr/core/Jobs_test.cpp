@@ -0,0 +1,99 @@
+/**
+ * @file Jobs_test.cpp
+ */
+
+#include <zephyr/core/Jobs.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace zephyr {
+namespace core {
+
+struct JobsTest: testing::Test {
+
+    WorkerPool pool;
+    Jobs jobs;
+
+    JobsTest()
+    : pool(3)
+    , jobs(&pool)
+    {
+        pool.attach();
+    }
+};
+
+
+TEST_F(JobsTest, ParallelForVisitsEachIndexOnce) {
+    std::vector<std::atomic<int>> visits(10000);
+    for (auto& count : visits) {
+        count = 0;
+    }
+    jobs.parallel_for(0, visits.size(), 16, [&visits](std::size_t i) {
+        ++ visits[i];
+    });
+    for (auto& count : visits) {
+        ASSERT_EQ(1, count);
+    }
+}
+
+TEST_F(JobsTest, ParallelForCanBeNested) {
+    std::atomic<int> total { 0 };
+    jobs.parallel_for(0, 64, 1, [this, &total](std::size_t) {
+        jobs.parallel_for(0, 64, 4, [&total](std::size_t) {
+            ++ total;
+        });
+    });
+    EXPECT_EQ(64 * 64, total);
+}
+
+TEST_F(JobsTest, EmptyRangeDoesNothing) {
+    int calls = 0;
+    jobs.parallel_for(5, 5, 1, [&calls](std::size_t) { ++ calls; });
+    EXPECT_EQ(0, calls);
+}
+
+TEST_F(JobsTest, WaitJoinsAllJobs) {
+    std::atomic<int> done { 0 };
+    JobCounter counter;
+    for (int i = 0; i < 500; ++ i) {
+        jobs.run(counter, [&done] { ++ done; });
+    }
+    jobs.wait(counter);
+    EXPECT_TRUE(counter.done());
+    EXPECT_EQ(500, done);
+}
+
+TEST_F(JobsTest, ContinuationRunsAfterAllJobs) {
+    std::atomic<int> done { 0 };
+    int seen = -1;
+    JobCounter batch, continuation;
+    for (int i = 0; i < 100; ++ i) {
+        jobs.run(batch, [&done] { ++ done; });
+    }
+    jobs.then(batch, continuation, [&done, &seen] { seen = done; });
+    jobs.wait(continuation);
+
+    EXPECT_EQ(100, seen);
+    EXPECT_TRUE(batch.done());
+}
+
+TEST_F(JobsTest, ContinuationOfFinishedBatchRuns) {
+    bool ran = false;
+    JobCounter batch, continuation;
+    jobs.then(batch, continuation, [&ran] { ran = true; });
+    jobs.wait(continuation);
+    EXPECT_TRUE(ran);
+}
+
+TEST(JobsInlineTest, RunsInlineWithoutPool) {
+    Jobs jobs(nullptr);
+    std::vector<std::size_t> order;
+    jobs.parallel_for(0, 5, 1, [&order](std::size_t i) {
+        order.push_back(i);
+    });
+    EXPECT_EQ((std::vector<std::size_t> { 0, 1, 2, 3, 4 }), order);
+}
+
+} /* namespace core */
+} /* namespace zephyr */
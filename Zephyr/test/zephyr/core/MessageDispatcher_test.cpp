@@ -4,12 +4,13 @@
 
 #include <zephyr/core/MessageDispatcher.hpp>
 #include <functional>
+#include <vector>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 using ::testing::_;
 using namespace std::placeholders;
-using zephyr::util::Any;
+using zephyr::util::Payload;
 
 namespace zephyr {
 namespace core {
@@ -25,7 +26,7 @@ TEST(MessageDispatcherTest, CanDeliverMessage) {
     EXPECT_CALL(mock, handle(_));
 
     registerHandler(dispatcher, 666, &mock, &HandlerMock::handle);
-    Any data { std::string("some string") };
+    Payload data { std::string("some string") };
     dispatcher.dispatch({ 666, 10, data });
 }
 
@@ -40,10 +41,86 @@ TEST(MessageDispatcherTest, CanDeliverMessageToMultipleListeners) {
 
     dispatcher.registerHandler(666, firstCallback);
     dispatcher.registerHandler(666, secondCallback);
-    Any data { std::string("some string") };
+    Payload data { std::string("some string") };
     dispatcher.dispatch({ 666, 10, data });
 }
 
+TEST(MessageDispatcherTest, DeliversOnlyToTarget) {
+    MessageDispatcher dispatcher;
+    HandlerMock target, other;
+    EXPECT_CALL(target, handle(_));
+    EXPECT_CALL(other, handle(_)).Times(0);
+
+    registerHandler(dispatcher, 1, &target, &HandlerMock::handle);
+    registerHandler(dispatcher, 2, &other, &HandlerMock::handle);
+    dispatcher.freeze();
+    dispatcher.dispatch({ 1, 10, Payload { } });
+    dispatcher.dispatch({ 3, 10, Payload { } });
+}
+
+TEST(MessageDispatcherTest, HandlersAreCalledInRegistrationOrder) {
+    MessageDispatcher dispatcher;
+    std::vector<int> calls;
+    for (int i = 0; i < 5; ++ i) {
+        dispatcher.registerHandler(100 - i, [](const Message&) { });
+        dispatcher.registerHandler(7, [&calls, i](const Message&) {
+            calls.push_back(i);
+        });
+    }
+    dispatcher.dispatch({ 7, 10, Payload { } });
+    EXPECT_EQ((std::vector<int> { 0, 1, 2, 3, 4 }), calls);
+}
+
+TEST(MessageDispatcherTest, RemovedHandlerIsNotCalled) {
+    MessageDispatcher dispatcher;
+    HandlerMock removed, kept;
+    EXPECT_CALL(removed, handle(_)).Times(1);
+    EXPECT_CALL(kept, handle(_)).Times(2);
+
+    HandlerId id = registerHandler(dispatcher, 5, &removed,
+            &HandlerMock::handle);
+    registerHandler(dispatcher, 5, &kept, &HandlerMock::handle);
+    dispatcher.freeze();
+    dispatcher.dispatch({ 5, 10, Payload { } });
+
+    EXPECT_TRUE(dispatcher.removeHandler(id));
+    EXPECT_FALSE(dispatcher.removeHandler(id));
+    dispatcher.dispatch({ 5, 10, Payload { } });
+}
+
+TEST(MessageDispatcherTest, RegistrationChangesAreCompiledLazily) {
+    MessageDispatcher dispatcher;
+    dispatcher.freeze();
+    EXPECT_TRUE(dispatcher.frozen());
+
+    int calls = 0;
+    dispatcher.registerHandler(5, [&calls](const Message&) { ++ calls; });
+    EXPECT_FALSE(dispatcher.frozen());
+
+    dispatcher.dispatch({ 5, 10, Payload { } });
+    EXPECT_TRUE(dispatcher.frozen());
+    EXPECT_EQ(1, calls);
+}
+
+TEST(MessageDispatcherTest, HandlerCanRemoveItselfAndRegisterOthers) {
+    MessageDispatcher dispatcher;
+    int selfCalls = 0, lateCalls = 0;
+    HandlerId self = INVALID_HANDLER;
+    self = dispatcher.registerHandler(5, [&](const Message&) {
+        ++ selfCalls;
+        dispatcher.removeHandler(self);
+        dispatcher.registerHandler(5, [&lateCalls](const Message&) {
+            ++ lateCalls;
+        });
+    });
+    dispatcher.dispatch({ 5, 10, Payload { } });
+    EXPECT_EQ(0, lateCalls);
+    dispatcher.dispatch({ 5, 10, Payload { } });
+
+    EXPECT_EQ(1, selfCalls);
+    EXPECT_EQ(1, lateCalls);
+}
+
 
 
 } /* namespace core */
@@ -6,9 +6,11 @@
 #include <zephyr/core/Message.hpp>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 using ::testing::AtLeast;
-using zephyr::util::Any;
+using zephyr::util::Payload;
 
 namespace zephyr {
 namespace core {
@@ -22,7 +24,7 @@ TEST(MessageQueueTest, EmptyQueueIsEmpty) {
 
 TEST(MessageQueueTest, NotEmptyAfterPost) {
     MessageQueue queue;
-    Message message { 10, 7, Any { text } };
+    Message message { 10, 7, Payload { text } };
     queue.post(message);
     EXPECT_FALSE(queue.empty());
 }
@@ -34,7 +36,7 @@ TEST(MessageQueueTest, PopWithEmptyThrows) {
 
 TEST(MessageQueueTest, CanFetchPostedMessage) {
     MessageQueue queue;
-    Message message { 10, 7, Any { text } };
+    Message message { 10, 7, Payload { text } };
     queue.post(message);
 
     Message popped = queue.pop();
@@ -42,6 +44,94 @@ TEST(MessageQueueTest, CanFetchPostedMessage) {
     EXPECT_EQ(message.type, popped.type);
 }
 
+TEST(MessageQueueTest, KeepsPostingOrder) {
+    MessageQueue queue(4);
+    for (std::uint32_t i = 0; i < 4; ++ i) {
+        queue.post({ 1, i, Payload { } });
+    }
+    std::vector<Message> messages;
+    queue.drain(back_inserter(messages));
+
+    ASSERT_EQ(4u, messages.size());
+    for (std::uint32_t i = 0; i < 4; ++ i) {
+        EXPECT_EQ(i, messages[i].type);
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(MessageQueueTest, GrowingQueueKeepsAllMessages) {
+    MessageQueue queue(4, MessageQueue::Overflow::GROW);
+    for (std::uint32_t i = 0; i < 100; ++ i) {
+        queue.post({ 1, i, Payload { } });
+    }
+    EXPECT_EQ(100u, queue.depth());
+    EXPECT_GT(queue.capacity(), 4u);
+
+    for (std::uint32_t i = 0; i < 100; ++ i) {
+        EXPECT_EQ(i, queue.pop().type);
+    }
+    EXPECT_EQ(0u, queue.dropped());
+}
+
+TEST(MessageQueueTest, DropOldestDiscardsOldMessages) {
+    MessageQueue queue(4, MessageQueue::Overflow::DROP_OLDEST);
+    for (std::uint32_t i = 0; i < 10; ++ i) {
+        queue.post({ 1, i, Payload { } });
+    }
+    EXPECT_EQ(4u, queue.depth());
+    EXPECT_EQ(6u, queue.dropped());
+    EXPECT_EQ(6u, queue.pop().type);
+}
+
+TEST(MessageQueueTest, BlockingQueueWaitsForConsumer) {
+    const std::uint32_t COUNT = 10000;
+    MessageQueue queue(8, MessageQueue::Overflow::BLOCK);
+    std::thread producer([&queue, COUNT] {
+        for (std::uint32_t i = 0; i < COUNT; ++ i) {
+            queue.post({ 1, i, Payload { } });
+        }
+    });
+    Message message;
+    for (std::uint32_t i = 0; i < COUNT; ++ i) {
+        while (!queue.tryPop(message)) {
+            std::this_thread::yield();
+        }
+        ASSERT_EQ(i, message.type);
+    }
+    producer.join();
+    EXPECT_EQ(8u, queue.capacity());
+    EXPECT_EQ(0u, queue.dropped());
+}
+
+TEST(MessageQueueTest, ConcurrentProducersKeepTheirOrder) {
+    const std::uint32_t PRODUCERS = 4;
+    const std::uint32_t COUNT = 20000;
+    MessageQueue queue(16);
+
+    std::vector<std::thread> producers;
+    for (std::uint32_t p = 0; p < PRODUCERS; ++ p) {
+        producers.emplace_back([&queue, p, COUNT] {
+            for (std::uint32_t i = 0; i < COUNT; ++ i) {
+                queue.post({ p, i, Payload { } });
+            }
+        });
+    }
+    std::vector<std::uint32_t> expected(PRODUCERS, 0);
+    std::uint32_t received = 0;
+    Message message;
+    while (received < PRODUCERS * COUNT) {
+        if (queue.tryPop(message)) {
+            ASSERT_EQ(expected[message.target], message.type);
+            ++ expected[message.target];
+            ++ received;
+        }
+    }
+    for (std::thread& producer : producers) {
+        producer.join();
+    }
+    EXPECT_TRUE(queue.empty());
+}
+
 
 } /* namespace core */
 } /* namespace zephyr */
@@ -0,0 +1,183 @@
+/**
+ * @file Scheduler_test.cpp
+ */
+
+#include <zephyr/core/Scheduler.hpp>
+#include <zephyr/core/WrapperTask.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <thread>
+
+using ::testing::ElementsAre;
+
+namespace zephyr {
+namespace core {
+
+struct SchedulerTest: testing::Test {
+
+    static const int FRAMES = 20;
+
+    Scheduler scheduler;
+
+    std::mutex logMutex;
+    std::vector<std::string> log;
+
+    SchedulerTest() {
+        // exclusive task, stops the scheduler after fixed number of frames
+        auto frames = std::make_shared<int>(0);
+        scheduler.startTask("frame-counter", 0, wrapAsTask([this, frames] {
+            if (++ *frames == FRAMES) {
+                scheduler.stop();
+            }
+        }));
+    }
+
+    void parallel(std::size_t workers) {
+        scheduler.executionMode(Scheduler::ExecutionMode::PARALLEL);
+        scheduler.workerCount(workers);
+    }
+
+    TaskPtr logging(std::string name) {
+        return wrapAsTask([this, name] {
+            std::lock_guard<std::mutex> lock(logMutex);
+            log.push_back(name);
+        });
+    }
+
+    std::atomic<int> readers { 0 };
+    std::atomic<int> writers { 0 };
+    std::atomic<bool> overlap { false };
+
+    /** Task using the resource for a while, detecting forbidden overlaps */
+    TaskPtr occupying(bool writing) {
+        return wrapAsTask([this, writing] {
+            std::atomic<int>& users = writing ? writers : readers;
+            ++ users;
+            if (writers > 1 || (writers > 0 && readers > 0)) {
+                overlap = true;
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            -- users;
+        });
+    }
+};
+
+
+TEST_F(SchedulerTest, ParallelModeKeepsOrderOfExclusiveTasks) {
+    scheduler.startTask("a", 10, logging("a"));
+    scheduler.startTask("b", 20, logging("b"));
+    scheduler.startTask("c", 30, logging("c"));
+    scheduler.run();
+    std::vector<std::string> serial = log;
+    log.clear();
+
+    Scheduler other;
+    other.executionMode(Scheduler::ExecutionMode::PARALLEL);
+    other.workerCount(3);
+    other.startTask("a", 10, logging("a"));
+    other.startTask("b", 20, logging("b"));
+    other.startTask("c", 30, logging("c"));
+    auto frames = std::make_shared<int>(0);
+    other.startTask("frame-counter", 0, wrapAsTask([&other, frames] {
+        if (++ *frames == FRAMES) {
+            other.stop();
+        }
+    }));
+    other.run();
+
+    EXPECT_EQ(serial, log);
+}
+
+TEST_F(SchedulerTest, AfterConstraintIsRespected) {
+    parallel(3);
+    // priority alone would put "second" before "first"
+    scheduler.startTask("second", 10, logging("second"),
+            TaskConstraints().after("first"));
+    scheduler.startTask("first", 20, logging("first"), TaskConstraints());
+    scheduler.run();
+
+    ASSERT_EQ(2u * FRAMES, log.size());
+    for (std::size_t i = 0; i < log.size(); i += 2) {
+        EXPECT_EQ("first", log[i]);
+        EXPECT_EQ("second", log[i + 1]);
+    }
+}
+
+TEST_F(SchedulerTest, MainThreadTasksRunOnMainThread) {
+    parallel(3);
+    std::thread::id main = std::this_thread::get_id();
+    std::atomic<int> wrongThread { 0 };
+    std::atomic<int> runs { 0 };
+
+    for (int i = 0; i < 4; ++ i) {
+        std::string name = "pinned-" + std::to_string(i);
+        scheduler.startTask(name, i, wrapAsTask([&, main] {
+            if (std::this_thread::get_id() != main) {
+                ++ wrongThread;
+            }
+            ++ runs;
+        }), TaskConstraints().onMainThread());
+    }
+    scheduler.run();
+
+    EXPECT_EQ(4 * FRAMES, runs);
+    EXPECT_EQ(0, wrongThread);
+}
+
+TEST_F(SchedulerTest, ConflictingTasksNeverOverlap) {
+    parallel(3);
+    scheduler.startTask("writer", 1, occupying(true),
+            TaskConstraints().writes("data"));
+    scheduler.startTask("other-writer", 2, occupying(true),
+            TaskConstraints().writes("data"));
+    scheduler.startTask("reader-1", 3, occupying(false),
+            TaskConstraints().reads("data"));
+    scheduler.startTask("reader-2", 4, occupying(false),
+            TaskConstraints().reads("data"));
+    scheduler.run();
+
+    EXPECT_FALSE(overlap);
+}
+
+TEST_F(SchedulerTest, IndependentTasksAllRun) {
+    parallel(2);
+    std::atomic<int> runs { 0 };
+    for (int i = 0; i < 8; ++ i) {
+        std::string name = "independent-" + std::to_string(i);
+        scheduler.startTask(name, i, wrapAsTask([&runs] { ++ runs; }),
+                TaskConstraints());
+    }
+    scheduler.run();
+
+    EXPECT_EQ(8 * FRAMES, runs);
+}
+
+TEST_F(SchedulerTest, WorksWithoutBackgroundThreads) {
+    parallel(0);
+    scheduler.startTask("a", 10, logging("a"), TaskConstraints());
+    scheduler.run();
+
+    EXPECT_EQ(static_cast<std::size_t>(FRAMES), log.size());
+}
+
+TEST_F(SchedulerTest, JobsUseReplacedPool) {
+    parallel(1);
+    Jobs& jobs = scheduler.jobs();
+    parallel(3);
+    std::atomic<int> sum { 0 };
+    std::atomic<bool> wasParallel { false };
+    scheduler.startTask("jobs", 10, wrapAsTask([&] {
+        wasParallel = wasParallel || jobs.parallel();
+        jobs.parallel_for(0, 100, 10, [&sum](std::size_t i) {
+            sum += i;
+        });
+    }), TaskConstraints());
+    scheduler.run();
+
+    EXPECT_TRUE(wasParallel);
+    EXPECT_EQ(FRAMES * 4950, sum);
+}
+
+} /* namespace core */
+} /* namespace zephyr */
@@ -0,0 +1,86 @@
+/**
+ * @file WorkStealingQueue_test.cpp
+ */
+
+#include <zephyr/core/WorkStealingQueue.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace zephyr {
+namespace core {
+
+TEST(WorkStealingQueueTest, RejectsInvalidCapacity) {
+    EXPECT_THROW(WorkStealingQueue<int>(0), std::invalid_argument);
+    EXPECT_THROW(WorkStealingQueue<int>(12), std::invalid_argument);
+}
+
+TEST(WorkStealingQueueTest, PopIsLifo) {
+    WorkStealingQueue<int> queue(8);
+    int a = 1, b = 2;
+    queue.push(&a);
+    queue.push(&b);
+    EXPECT_EQ(&b, queue.pop());
+    EXPECT_EQ(&a, queue.pop());
+    EXPECT_EQ(nullptr, queue.pop());
+}
+
+TEST(WorkStealingQueueTest, StealIsFifo) {
+    WorkStealingQueue<int> queue(8);
+    int a = 1, b = 2;
+    queue.push(&a);
+    queue.push(&b);
+    EXPECT_EQ(&a, queue.steal());
+    EXPECT_EQ(&b, queue.steal());
+    EXPECT_EQ(nullptr, queue.steal());
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(WorkStealingQueueTest, PushFailsWhenFull) {
+    WorkStealingQueue<int> queue(2);
+    int a = 1;
+    EXPECT_TRUE(queue.push(&a));
+    EXPECT_TRUE(queue.push(&a));
+    EXPECT_FALSE(queue.push(&a));
+}
+
+TEST(WorkStealingQueueTest, EveryItemIsTakenExactlyOnce) {
+    const int COUNT = 100000;
+    WorkStealingQueue<int> queue(1 << 17);
+    std::vector<int> items(COUNT, 0);
+    std::atomic<int> taken { 0 };
+    std::atomic<bool> done { false };
+
+    auto thief = [&] {
+        while (!done || !queue.empty()) {
+            if (int* item = queue.steal()) {
+                ++ *item;
+                ++ taken;
+            }
+        }
+    };
+    std::thread first(thief), second(thief);
+
+    for (int i = 0; i < COUNT; ++ i) {
+        queue.push(&items[i]);
+        if (i % 3 == 0) {
+            if (int* item = queue.pop()) {
+                ++ *item;
+                ++ taken;
+            }
+        }
+    }
+    done = true;
+    first.join();
+    second.join();
+
+    EXPECT_EQ(COUNT, taken);
+    for (int count : items) {
+        ASSERT_EQ(1, count);
+    }
+}
+
+} /* namespace core */
+} /* namespace zephyr */
@@ -0,0 +1,121 @@
+/**
+ * @file CommandBuffer_test.cpp
+ */
+
+#include <zephyr/gfx/CommandBuffer.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+struct Small {
+    static constexpr std::uint32_t TYPE = 1;
+    char c;
+};
+
+struct Large {
+    static constexpr std::uint32_t TYPE = 2;
+    double values[3];
+    int n;
+};
+
+/** Collects the packets as (type, first value) pairs */
+struct Collector {
+    std::vector<std::pair<std::uint32_t, int>> packets;
+
+    void operator ()(std::uint32_t type, const void* data) {
+        if (type == Small::TYPE) {
+            packets.emplace_back(type, CommandBuffer::read<Small>(data).c);
+        } else {
+            packets.emplace_back(type, CommandBuffer::read<Large>(data).n);
+        }
+    }
+};
+
+typedef std::pair<std::uint32_t, int> P;
+
+} /* namespace */
+
+
+TEST(CommandBufferTest, PacketsAreReadInRecordingOrder) {
+    CommandBuffer buffer;
+    buffer.push(Small { 'a' });
+    buffer.push(Large { { 1, 2, 3 }, 7 });
+    buffer.push(Small { 'b' });
+
+    Collector collector;
+    buffer.forEach(collector);
+    EXPECT_EQ(3u, buffer.size());
+    EXPECT_THAT(collector.packets, ::testing::ElementsAre(P(1, 'a'), P(2, 7),
+            P(1, 'b')));
+}
+
+TEST(CommandBufferTest, ClearKeepsNoPackets) {
+    CommandBuffer buffer;
+    buffer.push(Small { 'a' });
+    buffer.clear();
+    EXPECT_TRUE(buffer.empty());
+    EXPECT_EQ(0u, buffer.bytes());
+
+    Collector collector;
+    buffer.forEach(collector);
+    EXPECT_TRUE(collector.packets.empty());
+}
+
+TEST(CommandQueueTest, ReplaysCommandsRecordedBeforeSwap) {
+    CommandQueue queue;
+    queue.local().push(Small { 'a' });
+    EXPECT_EQ(0u, queue.size());
+
+    queue.swap();
+    // recorded for the following frame, not replayed yet
+    queue.local().push(Small { 'b' });
+
+    Collector first;
+    queue.replay(first);
+    EXPECT_THAT(first.packets, ::testing::ElementsAre(P(1, 'a')));
+
+    queue.swap();
+    Collector second;
+    queue.replay(second);
+    EXPECT_THAT(second.packets, ::testing::ElementsAre(P(1, 'b')));
+}
+
+TEST(CommandQueueTest, ThreadsRecordIntoSeparateBuffers) {
+    CommandQueue queue;
+    const int perThread = 1000;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++ t) {
+        threads.emplace_back([&queue, t]() {
+            CommandBuffer& buffer = queue.local();
+            for (int i = 0; i < perThread; ++ i) {
+                buffer.push(Large { { }, t * perThread + i });
+            }
+        });
+    }
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    queue.swap();
+    EXPECT_EQ(4u * perThread, queue.size());
+
+    // each thread's packets come together, in the recording order
+    Collector collector;
+    queue.replay(collector);
+    for (std::size_t i = 0; i < collector.packets.size(); i += perThread) {
+        int base = collector.packets[i].second;
+        EXPECT_EQ(0, base % perThread);
+        for (int j = 0; j < perThread; ++ j) {
+            EXPECT_EQ(base + j, collector.packets[i + j].second);
+        }
+    }
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,104 @@
+/**
+ * @file Culling_test.cpp
+ */
+
+#include <zephyr/gfx/Culling.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace zephyr {
+namespace gfx {
+
+using ::testing::ElementsAre;
+using ::testing::FloatEq;
+
+namespace {
+
+const float IDENTITY[16] = {
+    1, 0, 0, 0,
+    0, 1, 0, 0,
+    0, 0, 1, 0,
+    0, 0, 0, 1
+};
+
+BoundingBox box(float x, float y, float z, float size) {
+    BoundingBox b;
+    b.min[0] = x - size; b.max[0] = x + size;
+    b.min[1] = y - size; b.max[1] = y + size;
+    b.min[2] = z - size; b.max[2] = z + size;
+    return b;
+}
+
+} /* namespace */
+
+
+TEST(CullingTest, ComputesBoundsOfPoints) {
+    // vec4 positions
+    std::vector<float> points = {
+        -1, 0, 0, 1,
+         3, 2, 0, 1,
+         1, 1, 4, 1
+    };
+    Bounds bounds = computeBounds(points.data(), 3, 4);
+    EXPECT_THAT(bounds.box.min, ElementsAre(-1, 0, 0));
+    EXPECT_THAT(bounds.box.max, ElementsAre(3, 2, 4));
+    EXPECT_THAT(bounds.sphere.center, ElementsAre(1, 1, 2));
+    EXPECT_THAT(bounds.sphere.radius, FloatEq(3));
+
+    EXPECT_TRUE(computeBounds(nullptr, 0).box.empty());
+}
+
+TEST(CullingTest, TransformsBoxes) {
+    // rotation by 90 degrees around z, then translation by (10, 0, 0)
+    const float m[16] = {
+         0, 1, 0, 0,
+        -1, 0, 0, 0,
+         0, 0, 1, 0,
+        10, 0, 0, 1
+    };
+    BoundingBox b;
+    b.min[0] = 0; b.min[1] = 0; b.min[2] = 0;
+    b.max[0] = 2; b.max[1] = 1; b.max[2] = 1;
+
+    BoundingBox t = transformBox(b, m);
+    EXPECT_THAT(t.min, ElementsAre(9, 0, 0));
+    EXPECT_THAT(t.max, ElementsAre(10, 2, 1));
+    EXPECT_TRUE(transformBox(BoundingBox { }, m).empty());
+}
+
+TEST(CullingTest, ExtractsNormalizedPlanes) {
+    Frustum frustum = Frustum::fromMatrix(IDENTITY);
+    // left plane of the [-1, 1] cube: x + 1 = 0
+    EXPECT_THAT(frustum.planes[0], ElementsAre(1, 0, 0, 1));
+    EXPECT_THAT(frustum.planes[5], ElementsAre(0, 0, -1, 1));
+}
+
+TEST(CullingTest, CullsBoxesOutsideFrustum) {
+    Frustum frustum = Frustum::fromMatrix(IDENTITY);
+    FrustumCuller culler;
+
+    // enough boxes for full batches and a remainder
+    std::vector<std::uint32_t> expected;
+    for (int i = 0; i < 19; ++ i) {
+        float x = (i % 3) * 1.5f;      // 0, 1.5 and 3
+        culler.add(box(x, 0, 0, 0.6f));
+        if (i % 3 != 2) {
+            expected.push_back(i);
+        }
+    }
+    culler.add(BoundingBox { });
+    expected.push_back(19);
+
+    EXPECT_EQ(expected, culler.cull(frustum));
+    EXPECT_EQ(20u, culler.stats().tested);
+    EXPECT_EQ(14u, culler.stats().visible);
+    EXPECT_EQ(6u, culler.stats().culled);
+
+    culler.clear();
+    culler.add(box(0, 0, -5, 1));
+    EXPECT_TRUE(culler.cull(frustum).empty());
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
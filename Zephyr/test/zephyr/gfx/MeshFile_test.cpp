@@ -0,0 +1,109 @@
+/**
+ * @file MeshFile_test.cpp
+ */
+
+#include <zephyr/gfx/MeshFile.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+
+using testing::ElementsAre;
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+/** Temporary file removed in the destructor */
+struct TempFile {
+    std::string path = "/tmp/zephyr_mesh_file_test_" + std::to_string(::getpid());
+
+    ~TempFile() {
+        std::remove(path.c_str());
+    }
+};
+
+MeshFileData triangle() {
+    MeshFileData data;
+    data.sourceHash = 0x1234;
+    data.variant = 2;
+    data.stride = 5;
+    data.attributes = { { 0, 3, 0 }, { 3, 2, 12 } };
+    data.vertices = {
+        0, 0, 0,  0, 0,
+        1, 0, 0,  1, 0,
+        0, 2, 0,  0, 1
+    };
+    data.indices = { 0, 2, 1 };
+    data.bounds = computeBounds(data.vertices.data(), 3, data.stride);
+    return data;
+}
+
+} /* namespace */
+
+
+TEST(MeshFileTest, HashDependsOnContent) {
+    std::string a = "v 1 2 3\n", b = "v 1 2 4\n";
+    EXPECT_EQ(contentHash(a.data(), a.data() + a.size()),
+              contentHash(a.data(), a.data() + a.size()));
+    EXPECT_NE(contentHash(a.data(), a.data() + a.size()),
+              contentHash(b.data(), b.data() + b.size()));
+}
+
+TEST(MeshFileTest, WrittenDataIsMappedBack) {
+    TempFile temp;
+    writeMeshFile(temp.path, triangle());
+    MeshFile file { temp.path };
+
+    const MeshFileHeader& header = file.header();
+    EXPECT_EQ(3u, header.vertexCount);
+    EXPECT_EQ(3u, header.indexCount);
+    EXPECT_EQ(20u, header.stride);
+    ASSERT_EQ(2u, header.attributeCount);
+    EXPECT_EQ(3u, header.attributes[1].index);
+    EXPECT_EQ(12u, header.attributes[1].offset);
+    EXPECT_EQ(2, header.bounds.box.max[1]);
+    EXPECT_TRUE(file.matches(0x1234, 2));
+    EXPECT_FALSE(file.matches(0x1234, 1));
+    EXPECT_FALSE(file.matches(0x4321, 2));
+
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(file.vertices())
+            % MeshFileHeader::ALIGNMENT);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(file.indices())
+            % MeshFileHeader::ALIGNMENT);
+    EXPECT_EQ(60u, file.vertexBytes());
+    EXPECT_EQ(1, file.vertices()[8]);
+    EXPECT_EQ(2, file.vertices()[11]);
+    EXPECT_THAT(std::vector<std::uint32_t>(file.indices(), file.indices() + 3),
+            ElementsAre(0, 2, 1));
+}
+
+TEST(MeshFileTest, InvalidFilesAreRejected) {
+    TempFile temp;
+    EXPECT_THROW(MeshFile { temp.path }, std::runtime_error);
+
+    std::ofstream(temp.path) << "v 1 2 3\n";
+    EXPECT_THROW(MeshFile { temp.path }, std::runtime_error);
+
+    // truncated
+    writeMeshFile(temp.path, triangle());
+    ASSERT_EQ(0, ::truncate(temp.path.c_str(), 200));
+    EXPECT_THROW(MeshFile { temp.path }, std::runtime_error);
+
+    // other version
+    writeMeshFile(temp.path, triangle());
+    {
+        std::fstream out(temp.path, std::ios::in | std::ios::out | std::ios::binary);
+        out.seekp(4);
+        std::uint32_t version = MeshFileHeader::VERSION + 1;
+        out.write(reinterpret_cast<const char*>(&version), sizeof version);
+    }
+    EXPECT_THROW(MeshFile { temp.path }, std::runtime_error);
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
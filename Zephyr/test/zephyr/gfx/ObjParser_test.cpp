@@ -0,0 +1,179 @@
+/**
+ * @file ObjParser_test.cpp
+ */
+
+#include <zephyr/gfx/ObjParser.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using testing::ElementsAre;
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+const std::uint32_t NONE = ObjData::NONE;
+
+ObjData parse(const std::string& text) {
+    return parseObj(text.data(), text.data() + text.size());
+}
+
+void expectSameAsStrtof(const std::string& text) {
+    float value = -1;
+    const char* begin = text.data();
+    const char* end = parseFloat(begin, begin + text.size(), value);
+    char* stop;
+    float expected = std::strtof(text.c_str(), &stop);
+    EXPECT_EQ(stop - text.c_str(), end - begin) << text;
+    EXPECT_EQ(0, std::memcmp(&expected, &value, sizeof value)) << text;
+}
+
+} /* namespace */
+
+
+TEST(ObjParserTest, FloatsAreParsedLikeStrtof) {
+    const char* samples[] = {
+        "0", "-0", "1", "-1.5", "+2.25", "0.1", ".5", "5.", "3.14159265",
+        "1e10", "1E-5", "-2.5e+3", "123456789012345678901234567890",
+        "0.000000000000000000000000000000000000000001", "1e39", "1e-50",
+        "0.30000001192092896", "16777217", "1.00000005960464477539062501",
+        "7e", "inf", "-nan", "1.5x"
+    };
+    for (const char* sample : samples) {
+        expectSameAsStrtof(sample);
+    }
+
+    std::mt19937 generator { 42 };
+    std::uniform_real_distribution<float> distribution { -1000, 1000 };
+    const char* formats[] = { "%.6f", "%.9g", "%g", "%.7e", "%.3f" };
+    char buffer[64];
+    for (int i = 0; i < 20000; ++ i) {
+        float value = distribution(generator);
+        std::snprintf(buffer, sizeof buffer, formats[i % 5], value);
+        expectSameAsStrtof(buffer);
+    }
+}
+
+TEST(ObjParserTest, NotANumberIsRejected) {
+    const std::string text = "abc";
+    float value = 7;
+    EXPECT_EQ(text.data(), parseFloat(text.data(), text.data() + 3, value));
+    EXPECT_EQ(7, value);
+}
+
+TEST(ObjParserTest, TrianglesHaveReversedWinding) {
+    ObjData obj = parse(
+        "v 0 0 0\n"
+        "v 1 0 0\n"
+        "v 0 1.5 -2\n"
+        "vt 0.25 0.75\n"
+        "f 1/1 2/1 3/1\n");
+    EXPECT_EQ(3u, obj.vertexCount());
+    EXPECT_THAT(obj.positions, ElementsAre(0, 0, 0, 1, 0, 0, 0, 1.5f, -2));
+    EXPECT_THAT(obj.texCoords, ElementsAre(0.25f, 0.75f));
+    EXPECT_THAT(obj.vertexIndices, ElementsAre(0, 2, 1));
+    EXPECT_THAT(obj.texIndices, ElementsAre(0, 0, 0));
+    EXPECT_THAT(obj.normalIndices, ElementsAre(NONE, NONE, NONE));
+}
+
+TEST(ObjParserTest, PolygonsAreSplitIntoFans) {
+    ObjData obj = parse(
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 0 2 0\n"
+        "f 1 2 3 4\n"
+        "f 1 2 3 4 5\n");
+    EXPECT_EQ(5u, obj.triangleCount());
+    EXPECT_THAT(obj.vertexIndices, ElementsAre(
+        0, 2, 1,  0, 3, 2,
+        0, 2, 1,  0, 3, 2,  0, 4, 3));
+}
+
+TEST(ObjParserTest, NegativeIndicesAreRelativeToLastElement) {
+    ObjData obj = parse(
+        "v 0 0 0\nv 1 0 0\nv 1 1 0\n"
+        "vt 0 0\nvt 1 1\n"
+        "vn 0 0 1\n"
+        "f -3/-2/-1 -2/-1/-1 -1/-1/-1\n"
+        "v 5 5 5\n"
+        "f -1 -2 -3\n");
+    EXPECT_THAT(obj.vertexIndices, ElementsAre(0, 2, 1, 3, 1, 2));
+    EXPECT_THAT(obj.texIndices, ElementsAre(0, 1, 1, NONE, NONE, NONE));
+    EXPECT_THAT(obj.normalIndices, ElementsAre(0, 0, 0, NONE, NONE, NONE));
+}
+
+TEST(ObjParserTest, NormalsAreRead) {
+    ObjData obj = parse(
+        "v 0 0 0\nv 1 0 0\nv 0 1 0\n"
+        "vn 0 0 1\nvn 0 1 0\n"
+        "f 1//2 2//1 3//2\n");
+    EXPECT_THAT(obj.normals, ElementsAre(0, 0, 1, 0, 1, 0));
+    EXPECT_THAT(obj.normalIndices, ElementsAre(1, 1, 0));
+    EXPECT_THAT(obj.texIndices, ElementsAre(NONE, NONE, NONE));
+}
+
+TEST(ObjParserTest, OtherRecordsAndCommentsAreSkipped) {
+    ObjData obj = parse(
+        "# comment v 1 2 3\r\n"
+        "mtllib scene.mtl\r\n"
+        "o cube\r\n"
+        "  v 1 2 3\r\n"
+        "\tv 4 5 6 # trailing\r\n"
+        "vp 0.5\r\n"
+        "usemtl red\r\n"
+        "s off\r\n"
+        "\r\n"
+        "v 7 8 9\r\n"
+        "f 1 2 3 # trailing\r\n"
+        "f 1 2");
+    EXPECT_THAT(obj.positions, ElementsAre(1, 2, 3, 4, 5, 6, 7, 8, 9));
+    EXPECT_THAT(obj.vertexIndices, ElementsAre(0, 2, 1));
+}
+
+TEST(ObjParserTest, ParallelParseMatchesSerial) {
+    // relative indices reach back over several chunks
+    std::ostringstream text;
+    for (int i = 0; i < 500; ++ i) {
+        text << "v " << i << " " << i * 0.5f << " -" << i << ".25\n"
+             << "vt 0." << i << " 1\n"
+             << "vn 0 0 1\n";
+        if (i % 7 == 0) {
+            text << "# comment\ng group" << i << "\n";
+        }
+        if (i >= 3) {
+            text << "f " << i << "/" << i << "/1 -1/-1/-1 -4/-3/-" << i / 2
+                 << " -30/-20//\r\n";
+        }
+    }
+    const std::string obj = text.str();
+    const char* begin = obj.data();
+    const char* end = begin + obj.size();
+
+    core::WorkerPool pool(3);
+    core::Jobs jobs(&pool);
+    pool.attach();
+
+    ObjData serial = parseObj(begin, end);
+    ObjData parallel = parseObj(begin, end, jobs, 256);
+    EXPECT_EQ(serial.positions, parallel.positions);
+    EXPECT_EQ(serial.texCoords, parallel.texCoords);
+    EXPECT_EQ(serial.normals, parallel.normals);
+    EXPECT_EQ(serial.vertexIndices, parallel.vertexIndices);
+    EXPECT_EQ(serial.texIndices, parallel.texIndices);
+    EXPECT_EQ(serial.normalIndices, parallel.normalIndices);
+    EXPECT_EQ(2 * 497u, parallel.triangleCount());
+}
+
+TEST(ObjParserTest, MissingFileThrows) {
+    EXPECT_THROW(loadObj("/nonexistent/mesh.obj"), std::runtime_error);
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,214 @@
+/**
+ * @file RenderGraph_test.cpp
+ */
+
+#include <zephyr/gfx/RenderGraph.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zephyr {
+namespace gfx {
+
+using ::testing::ElementsAre;
+
+namespace {
+
+/** Pool handing out consecutive texture ids */
+struct CountingPool : RenderTargetPool {
+    CountingPool()
+    : RenderTargetPool {
+        [this](const TargetKey&) { return ++ next; },
+        [](TargetId) { }
+    }
+    { }
+
+    TargetId next = 0;
+};
+
+/** Setup of a pass reading and writing given targets */
+RenderGraph::Setup access(std::vector<ResourceId> reads,
+        std::vector<ResourceId> writes) {
+    return [reads, writes](RenderGraph::PassBuilder& builder) {
+        for (ResourceId r : reads) {
+            builder.read(r);
+        }
+        for (ResourceId r : writes) {
+            builder.write(r);
+        }
+    };
+}
+
+} /* namespace */
+
+
+TEST(RenderGraphTest, CullsPassesNotContributingToOutput) {
+    RenderGraph graph;
+    ResourceId output = graph.import("output", 0, 100, 100);
+    ResourceId color = graph.create("color", TargetFormat::RGBA8);
+    ResourceId ssao = graph.create("ssao", TargetFormat::R16F, 0.5f);
+
+    std::vector<std::string> ran;
+    auto record = [&ran](std::string name) {
+        return [&ran, name](const RenderGraph::PassContext&) {
+            ran.push_back(name);
+        };
+    };
+    graph.addPass("geometry", access({ }, { color }), record("geometry"));
+    graph.addPass("ssao", access({ color }, { ssao }), record("ssao"));
+    graph.addPass("post", access({ color }, { output }), record("post"));
+
+    CountingPool pool;
+    graph.execute(pool, 100, 100);
+
+    EXPECT_THAT(ran, ElementsAre("geometry", "post"));
+    EXPECT_EQ(1u, graph.culled());
+    // ssao target is never allocated
+    EXPECT_EQ(1u, pool.created());
+}
+
+TEST(RenderGraphTest, OrdersWritersBeforeReaders) {
+    RenderGraph graph;
+    ResourceId output = graph.import("output", 0, 100, 100);
+    ResourceId color = graph.create("color", TargetFormat::RGBA8);
+    ResourceId bloom = graph.create("bloom", TargetFormat::R11G11B10F);
+
+    auto none = [](const RenderGraph::PassContext&) { };
+    graph.addPass("post", access({ color, bloom }, { output }), none);
+    graph.addPass("bloom", access({ color }, { bloom }), none);
+    graph.addPass("geometry", access({ }, { color }), none);
+    graph.addPass("overlay", [](RenderGraph::PassBuilder& builder) {
+        builder.sideEffect();
+    }, none);
+
+    graph.compile();
+    EXPECT_THAT(graph.schedule(),
+            ElementsAre("geometry", "bloom", "post", "overlay"));
+}
+
+TEST(RenderGraphTest, OrdersReadersBetweenWriters) {
+    RenderGraph graph;
+    ResourceId output = graph.import("output", 0, 100, 100);
+    ResourceId color = graph.create("color", TargetFormat::RGBA8);
+    ResourceId blurred = graph.create("blurred", TargetFormat::RGBA8);
+    ResourceId history = graph.create("history", TargetFormat::RGBA8);
+
+    std::vector<TargetId> targets(3);
+    auto none = [](const RenderGraph::PassContext&) { };
+    graph.addPass("geometry", access({ }, { color }),
+        [&](const RenderGraph::PassContext& ctx) {
+            targets[0] = ctx.target(color);
+        });
+    graph.addPass("blur", access({ color }, { blurred }), none);
+    graph.addPass("copy", access({ color }, { history }), none);
+    graph.addPass("composite", access({ blurred, history }, { color }),
+        [&](const RenderGraph::PassContext& ctx) {
+            targets[1] = ctx.target(color);
+        });
+    graph.addPass("post", access({ color }, { output }),
+        [&](const RenderGraph::PassContext& ctx) {
+            targets[2] = ctx.target(color);
+        });
+
+    CountingPool pool;
+    graph.execute(pool, 100, 100);
+    EXPECT_THAT(graph.schedule(),
+            ElementsAre("geometry", "blur", "copy", "composite", "post"));
+    // color stays the same target while it is rewritten
+    EXPECT_EQ(targets[0], targets[1]);
+    EXPECT_EQ(targets[0], targets[2]);
+    EXPECT_EQ(0u, pool.inUse());
+}
+
+TEST(RenderGraphTest, AliasesTransientsWithDisjointLifetimes) {
+    RenderGraph graph;
+    ResourceId output = graph.import("output", 0, 64, 64);
+    ResourceId a = graph.create("a", TargetFormat::RGBA16F);
+    ResourceId b = graph.create("b", TargetFormat::RGBA16F);
+    ResourceId c = graph.create("c", TargetFormat::RGBA16F);
+    ResourceId half = graph.create("half", TargetFormat::RGBA16F, 0.5f);
+
+    std::vector<TargetId> targets(4);
+    int halfWidth = 0, halfHeight = 0;
+    graph.addPass("1", access({ }, { a }),
+        [&](const RenderGraph::PassContext& ctx) {
+            targets[0] = ctx.target(a);
+        });
+    graph.addPass("2", access({ a }, { b, half }),
+        [&](const RenderGraph::PassContext& ctx) {
+            targets[1] = ctx.target(b);
+            targets[3] = ctx.target(half);
+            ctx.size(half, halfWidth, halfHeight);
+        });
+    graph.addPass("3", access({ b, half }, { c }),
+        [&](const RenderGraph::PassContext& ctx) {
+            targets[2] = ctx.target(c);
+        });
+    graph.addPass("4", access({ c }, { output }),
+        [](const RenderGraph::PassContext&) { });
+
+    CountingPool pool;
+    graph.execute(pool, 64, 64);
+
+    // a is dead once pass 2 is done, c reuses its memory
+    EXPECT_EQ(targets[0], targets[2]);
+    EXPECT_NE(targets[0], targets[1]);
+    EXPECT_EQ(3u, pool.created());
+    EXPECT_EQ(0u, pool.inUse());
+    EXPECT_EQ(32, halfWidth);
+    EXPECT_EQ(32, halfHeight);
+}
+
+TEST(RenderGraphTest, RebindsImportedTargetsWithoutRecompiling) {
+    RenderGraph graph;
+    ResourceId output = graph.import("output", 7, 64, 64);
+    ResourceId a = graph.create("a", TargetFormat::RGBA8);
+
+    TargetId target = 0;
+    int width = 0, height = 0;
+    graph.addPass("1", access({ }, { a }),
+        [](const RenderGraph::PassContext&) { });
+    graph.addPass("2", access({ a }, { output }),
+        [&](const RenderGraph::PassContext& ctx) {
+            target = ctx.target(output);
+            ctx.size(output, width, height);
+        });
+
+    CountingPool pool;
+    graph.execute(pool, 64, 64);
+    EXPECT_EQ(7u, target);
+    EXPECT_EQ(64, width);
+
+    graph.rebind(output, 9, 32, 16);
+    EXPECT_TRUE(graph.compiled());
+    graph.execute(pool, 32, 16);
+    EXPECT_EQ(9u, target);
+    EXPECT_EQ(32, width);
+    EXPECT_EQ(16, height);
+    EXPECT_THROW(graph.rebind(a, 1, 1, 1), std::logic_error);
+}
+
+TEST(RenderGraphTest, ReportsInvalidGraphs) {
+    auto none = [](const RenderGraph::PassContext&) { };
+    {
+        RenderGraph graph;
+        ResourceId output = graph.import("output", 0, 1, 1);
+        ResourceId missing = graph.create("missing", TargetFormat::RGBA8);
+        graph.addPass("post", access({ missing }, { output }), none);
+        EXPECT_THROW(graph.compile(), std::runtime_error);
+    }
+    {
+        RenderGraph graph;
+        ResourceId output = graph.import("output", 0, 1, 1);
+        ResourceId a = graph.create("a", TargetFormat::RGBA8);
+        ResourceId b = graph.create("b", TargetFormat::RGBA8);
+        graph.addPass("x", access({ a }, { b }), none);
+        graph.addPass("y", access({ b }, { a, output }), none);
+        EXPECT_THROW(graph.compile(), std::runtime_error);
+    }
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
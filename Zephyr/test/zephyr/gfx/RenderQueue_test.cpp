@@ -0,0 +1,110 @@
+/**
+ * @file RenderQueue_test.cpp
+ */
+
+#include <zephyr/gfx/RenderQueue.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace zephyr {
+namespace gfx {
+
+TEST(RenderQueueTest, FieldsAreOrderedByPriority) {
+    auto key = &RenderQueue::makeKey;
+    EXPECT_LT(key(0, 9, 9, 9, 100.0f), key(1, 0, 0, 0, 0.0f));
+    EXPECT_LT(key(0, 1, 9, 9, 100.0f), key(0, 2, 0, 0, 0.0f));
+    EXPECT_LT(key(0, 1, 1, 9, 100.0f), key(0, 1, 2, 0, 0.0f));
+    EXPECT_LT(key(0, 1, 1, 1, 100.0f), key(0, 1, 1, 2, 0.0f));
+    EXPECT_LT(key(0, 1, 1, 1, 1.0f), key(0, 1, 1, 1, 2.0f));
+}
+
+TEST(RenderQueueTest, FieldsAreTruncated) {
+    auto key = &RenderQueue::makeKey;
+    EXPECT_EQ(key(0, 0, 0, 0, 0.0f), key(0, 0, 0, 1 << 16, 0.0f));
+    EXPECT_EQ(key(1, 0, 0, 0, 0.0f), key(17, 0, 0, 0, 0.0f));
+}
+
+TEST(RenderQueueTest, DepthQuantizationPreservesOrder) {
+    EXPECT_EQ(0u, RenderQueue::quantizeDepth(-5.0f));
+    EXPECT_EQ(0u, RenderQueue::quantizeDepth(0.0f));
+    float prev = 0.01f;
+    for (float d = 0.02f; d < 1e4f; d *= 1.5f) {
+        EXPECT_LE(RenderQueue::quantizeDepth(prev),
+                RenderQueue::quantizeDepth(d));
+        prev = d;
+    }
+    EXPECT_LT(RenderQueue::quantizeDepth(1.0f),
+            RenderQueue::quantizeDepth(2.0f));
+}
+
+TEST(RenderQueueTest, SortsLikeStableSort) {
+    std::mt19937_64 random(42);
+    std::vector<std::uint64_t> keys;
+    for (int i = 0; i < 1000; ++ i) {
+        // few distinct values, so that there are many equal keys
+        keys.push_back((random() % 7) << 48 | (random() % 5) << 16);
+    }
+    RenderQueue queue;
+    for (std::uint64_t key : keys) {
+        queue.push(key);
+    }
+    std::vector<std::uint32_t> expected(keys.size());
+    for (std::uint32_t i = 0; i < expected.size(); ++ i) {
+        expected[i] = i;
+    }
+    std::stable_sort(begin(expected), end(expected),
+            [&keys](std::uint32_t a, std::uint32_t b) {
+        return keys[a] < keys[b];
+    });
+    EXPECT_EQ(expected, queue.sort());
+}
+
+TEST(RenderQueueTest, ClearRestartsIndices) {
+    RenderQueue queue;
+    queue.push(5);
+    queue.push(3);
+    queue.clear();
+    EXPECT_EQ(0u, queue.size());
+    queue.push(2);
+    queue.push(1);
+    EXPECT_THAT(queue.sort(), ::testing::ElementsAre(1u, 0u));
+}
+
+TEST(RenderQueueTest, KeyIdsAreDenseAndWrap) {
+    int a, b, c;
+    KeyIds ids(1);
+    EXPECT_EQ(0u, ids.get(&a));
+    EXPECT_EQ(1u, ids.get(&b));
+    EXPECT_EQ(0u, ids.get(&a));
+    EXPECT_EQ(0u, ids.get(&c));
+    ids.clear();
+    EXPECT_EQ(0u, ids.get(&b));
+}
+
+TEST(RenderQueueTest, BatchesGroupMergeableRuns) {
+    // items with the same key value can be merged
+    std::vector<std::uint64_t> keys { 2, 1, 2, 1, 1, 3, 1 };
+    RenderQueue queue;
+    for (std::uint64_t key : keys) {
+        queue.push(key);
+    }
+    queue.sort();
+    auto& batches = queue.batch(3, [&keys](std::uint32_t a, std::uint32_t b) {
+        return keys[a] == keys[b];
+    });
+    ASSERT_EQ(4u, batches.size());
+    EXPECT_EQ(0u, batches[0].first);
+    EXPECT_EQ(3u, batches[0].count);
+    EXPECT_EQ(3u, batches[1].first);
+    EXPECT_EQ(1u, batches[1].count);
+    EXPECT_EQ(4u, batches[2].first);
+    EXPECT_EQ(2u, batches[2].count);
+    EXPECT_EQ(6u, batches[3].first);
+    EXPECT_EQ(1u, batches[3].count);
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,90 @@
+/**
+ * @file RenderTargetPool_test.cpp
+ */
+
+#include <zephyr/gfx/RenderTargetPool.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+/** Hands out consecutive ids, remembers the live ones */
+struct FakeTextures {
+    TargetId next = 1;
+    std::vector<TargetId> live;
+
+    RenderTargetPool::Create create() {
+        return [this](const TargetKey&) {
+            live.push_back(next);
+            return next ++;
+        };
+    }
+
+    RenderTargetPool::Destroy destroy() {
+        return [this](TargetId id) {
+            live.erase(std::find(begin(live), end(live), id));
+        };
+    }
+};
+
+} /* namespace */
+
+
+TEST(RenderTargetPoolTest, ReusesReleasedTargetOfSameKey) {
+    FakeTextures textures;
+    {
+        RenderTargetPool pool { textures.create(), textures.destroy() };
+        TargetId a = pool.acquire(TargetFormat::RGBA8, 64, 64);
+        TargetId b = pool.acquire(TargetFormat::RGBA8, 64, 64);
+        EXPECT_NE(a, b);
+
+        pool.release(a);
+        EXPECT_EQ(a, pool.acquire(TargetFormat::RGBA8, 64, 64));
+        EXPECT_NE(a, pool.acquire(TargetFormat::RG16F, 64, 64));
+        EXPECT_NE(a, pool.acquire(TargetFormat::RGBA8, 32, 64));
+
+        EXPECT_EQ(4u, pool.created());
+        EXPECT_EQ(4u, pool.inUse());
+        EXPECT_EQ((4u + 4 + 4) * 64 * 64 + 4 * 32 * 64, pool.bytes());
+    }
+    EXPECT_TRUE(textures.live.empty());
+}
+
+TEST(RenderTargetPoolTest, DestroysIdleTargets) {
+    FakeTextures textures;
+    RenderTargetPool pool { textures.create(), textures.destroy(), 2 };
+
+    TargetId kept = pool.acquire(TargetFormat::R16F, 8, 8);
+    TargetId idle = pool.acquire(TargetFormat::R16F, 8, 8);
+    pool.release(idle);
+
+    pool.endFrame();
+    pool.endFrame();
+    EXPECT_EQ(2u, pool.size());
+    pool.endFrame();
+    EXPECT_EQ(1u, pool.size());
+    EXPECT_EQ(std::vector<TargetId> { kept }, textures.live);
+
+    pool.release(kept);
+    pool.trim();
+    EXPECT_TRUE(textures.live.empty());
+}
+
+TEST(RenderTargetPoolTest, ReleaseOfUnknownTargetThrows) {
+    FakeTextures textures;
+    RenderTargetPool pool { textures.create(), textures.destroy() };
+    TargetId id = pool.acquire(TargetFormat::RGBA8, 1, 1);
+    pool.release(id);
+
+    EXPECT_THROW(pool.release(id), std::logic_error);
+    EXPECT_THROW(pool.release(id + 1), std::logic_error);
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,56 @@
+/**
+ * @file ResizeFilter_test.cpp
+ */
+
+#include <zephyr/gfx/ResizeFilter.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+using std::chrono::milliseconds;
+const ResizeFilter::Clock::time_point T0 {};
+
+} /* namespace */
+
+
+TEST(ResizeFilterTest, AcceptsFirstSizeImmediately) {
+    ResizeFilter filter { milliseconds(100) };
+    EXPECT_FALSE(filter.update(0, 0, T0));
+    EXPECT_TRUE(filter.update(800, 600, T0));
+    EXPECT_EQ(800, filter.width());
+    EXPECT_EQ(600, filter.height());
+}
+
+TEST(ResizeFilterTest, WaitsUntilSizeIsStable) {
+    ResizeFilter filter { milliseconds(100) };
+    filter.update(800, 600, T0);
+
+    // dragging the window edge
+    EXPECT_FALSE(filter.update(810, 600, T0 + milliseconds(10)));
+    EXPECT_FALSE(filter.update(820, 600, T0 + milliseconds(60)));
+    EXPECT_FALSE(filter.update(820, 600, T0 + milliseconds(150)));
+    EXPECT_TRUE(filter.pending());
+    EXPECT_EQ(800, filter.width());
+
+    EXPECT_TRUE(filter.update(820, 600, T0 + milliseconds(160)));
+    EXPECT_FALSE(filter.pending());
+    EXPECT_EQ(820, filter.width());
+    EXPECT_FALSE(filter.update(820, 600, T0 + milliseconds(500)));
+}
+
+TEST(ResizeFilterTest, ReturningToAcceptedSizeCancelsChange) {
+    ResizeFilter filter { milliseconds(100) };
+    filter.update(800, 600, T0);
+
+    EXPECT_FALSE(filter.update(900, 600, T0 + milliseconds(10)));
+    EXPECT_FALSE(filter.update(800, 600, T0 + milliseconds(20)));
+    EXPECT_FALSE(filter.pending());
+    EXPECT_FALSE(filter.update(900, 600, T0 + milliseconds(200)));
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,62 @@
+/**
+ * @file TargetFormat_test.cpp
+ */
+
+#include <zephyr/gfx/TargetFormat.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+namespace zephyr {
+namespace gfx {
+
+TEST(TargetFormatTest, NamesRoundTrip) {
+    for (TargetFormat format : { TargetFormat::RGBA32F, TargetFormat::RGBA8,
+            TargetFormat::RGB10A2, TargetFormat::R11G11B10F,
+            TargetFormat::RG16F, TargetFormat::D24S8 }) {
+        EXPECT_EQ(format, parseTargetFormat(formatName(format)));
+    }
+    EXPECT_THROW(parseTargetFormat("RGBA64"), std::runtime_error);
+}
+
+TEST(TargetFormatTest, LayoutSizeSumsTexels) {
+    FrameBufferLayout layout;
+    layout.colors = {
+        { "color", TargetFormat::R11G11B10F },
+        { "normal", TargetFormat::RG16F },
+        { "depth-linear", TargetFormat::R16F }
+    };
+    layout.depth.format = TargetFormat::D24S8;
+    EXPECT_EQ((4u + 4 + 2 + 4) * 100 * 10, layout.bytes(100, 10));
+
+    // 4 RGBA32F targets and D32F at 1080p, as used before
+    FrameBufferLayout full = FrameBufferLayout::uniform(4);
+    EXPECT_EQ(68u * 1920 * 1080, full.bytes(1920, 1080));
+}
+
+TEST(TargetFormatTest, ValidateRejectsMisplacedFormats) {
+    FrameBufferLayout layout = FrameBufferLayout::uniform(2);
+    EXPECT_NO_THROW(layout.validate());
+
+    layout.colors[1].format = TargetFormat::D32F;
+    EXPECT_THROW(layout.validate(), std::runtime_error);
+
+    layout = FrameBufferLayout::uniform(1, TargetFormat::RGBA8,
+            TargetFormat::RGBA8);
+    EXPECT_THROW(layout.validate(), std::runtime_error);
+}
+
+TEST(TargetFormatTest, ReportMentionsTargetsAndTotals) {
+    FrameBufferLayout layout;
+    layout.colors = { { "normal", TargetFormat::RG16F } };
+    layout.depth.format = TargetFormat::D24S8;
+
+    std::string report = memoryReport(layout, 1024, 1024);
+    EXPECT_THAT(report, ::testing::HasSubstr("normal=RG16F (4.0 MB)"));
+    EXPECT_THAT(report, ::testing::HasSubstr("depth=D24S8 (4.0 MB)"));
+    EXPECT_THAT(report, ::testing::HasSubstr("total 8.0 MB"));
+    EXPECT_THAT(report, ::testing::HasSubstr("20.0 MB with RGBA32F"));
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
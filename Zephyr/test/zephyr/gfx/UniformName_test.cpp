@@ -0,0 +1,35 @@
+/**
+ * @file UniformName_test.cpp
+ */
+
+#include <zephyr/gfx/UniformName.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <string>
+
+namespace zephyr {
+namespace gfx {
+
+namespace {
+
+constexpr UniformName SUN_COLOR { "sunColor" };
+
+static_assert(SUN_COLOR.id == uniformId("sunColor"),
+        "Uniform id should be known at compile time");
+
+} /* namespace */
+
+
+TEST(UniformNameTest, RuntimeIdMatchesCompileTimeId) {
+    std::string name = "sunColor";
+    EXPECT_EQ(SUN_COLOR.id, UniformName(name).id);
+    EXPECT_EQ(SUN_COLOR.id, uniformId(name));
+}
+
+TEST(UniformNameTest, DifferentNamesHaveDifferentIds) {
+    EXPECT_NE(uniformId("lightPos"), uniformId("lightAt"));
+    EXPECT_NE(uniformId("modelMatrix"), uniformId("viewport"));
+}
+
+} /* namespace gfx */
+} /* namespace zephyr */
@@ -0,0 +1,104 @@
+/**
+ * @file CoalescingListener_test.cpp
+ */
+
+#include <zephyr/input/CoalescingListener.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+using ::testing::_;
+using ::testing::InSequence;
+using ::testing::Field;
+using ::testing::DoubleEq;
+
+namespace zephyr {
+namespace input {
+
+class ListenerMock: public InputListener {
+public:
+    MOCK_METHOD1(keyEvent, void (const KeyEvent&));
+    MOCK_METHOD1(buttonEvent, void (const ButtonEvent&));
+    MOCK_METHOD1(mouseMove, void (const Position&));
+    MOCK_METHOD1(scroll, void (double));
+    MOCK_METHOD0(flush, void ());
+};
+
+struct CoalescingListenerTest: testing::Test {
+
+    std::shared_ptr<ListenerMock> target;
+    CoalescingListener listener;
+
+    CoalescingListenerTest()
+    : target(std::make_shared<ListenerMock>())
+    , listener(target)
+    { }
+
+    static KeyEvent key() {
+        return { Key::A, KeyEvent::Type::DOWN, Mod { } };
+    }
+};
+
+
+TEST_F(CoalescingListenerTest, MergesConsecutiveMoves) {
+    InSequence order;
+    EXPECT_CALL(*target, mouseMove(Field(&Position::x, 3.0)));
+    EXPECT_CALL(*target, flush());
+
+    listener.mouseMove({ 1, 0 });
+    listener.mouseMove({ 2, 0 });
+    listener.mouseMove({ 3, 0 });
+    listener.flush();
+
+    EXPECT_EQ(3u, listener.lastCursorSamples());
+    EXPECT_EQ(3u, listener.stats().cursorSamples);
+    EXPECT_EQ(1u, listener.stats().cursorEvents);
+}
+
+TEST_F(CoalescingListenerTest, SumsConsecutiveScrolls) {
+    InSequence order;
+    EXPECT_CALL(*target, scroll(DoubleEq(3.5)));
+    EXPECT_CALL(*target, flush());
+
+    listener.scroll(1);
+    listener.scroll(2.5);
+    listener.flush();
+}
+
+TEST_F(CoalescingListenerTest, KeepsOrderWithKeys) {
+    InSequence order;
+    EXPECT_CALL(*target, mouseMove(Field(&Position::x, 2.0)));
+    EXPECT_CALL(*target, keyEvent(_));
+    EXPECT_CALL(*target, mouseMove(Field(&Position::x, 4.0)));
+    EXPECT_CALL(*target, flush());
+
+    listener.mouseMove({ 1, 0 });
+    listener.mouseMove({ 2, 0 });
+    listener.keyEvent(key());
+    listener.mouseMove({ 3, 0 });
+    listener.mouseMove({ 4, 0 });
+    listener.flush();
+}
+
+TEST_F(CoalescingListenerTest, KeepsOrderOfMovesAndScrolls) {
+    InSequence order;
+    EXPECT_CALL(*target, mouseMove(Field(&Position::x, 1.0)));
+    EXPECT_CALL(*target, scroll(DoubleEq(2.0)));
+    EXPECT_CALL(*target, mouseMove(Field(&Position::x, 5.0)));
+    EXPECT_CALL(*target, flush());
+
+    listener.mouseMove({ 1, 0 });
+    listener.scroll(1);
+    listener.scroll(1);
+    listener.mouseMove({ 5, 0 });
+    listener.flush();
+}
+
+TEST_F(CoalescingListenerTest, EmptyFlushDeliversNothing) {
+    EXPECT_CALL(*target, mouseMove(_)).Times(0);
+    EXPECT_CALL(*target, scroll(_)).Times(0);
+    EXPECT_CALL(*target, flush());
+    listener.flush();
+}
+
+} /* namespace input */
+} /* namespace zephyr */
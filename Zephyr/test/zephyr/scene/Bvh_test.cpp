@@ -0,0 +1,167 @@
+/**
+ * @file Bvh_test.cpp
+ */
+
+#include <zephyr/scene/Bvh.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace zephyr {
+namespace scene {
+
+using ::testing::ElementsAre;
+
+namespace {
+
+BoundingBox box(float x, float y, float z, float size) {
+    BoundingBox b;
+    b.min[0] = x - size; b.max[0] = x + size;
+    b.min[1] = y - size; b.max[1] = y + size;
+    b.min[2] = z - size; b.max[2] = z + size;
+    return b;
+}
+
+bool overlaps(const BoundingBox& a, const BoundingBox& b) {
+    for (int i = 0; i < 3; ++ i) {
+        if (a.max[i] < b.min[i] || b.max[i] < a.min[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::vector<std::uint32_t> sorted(std::vector<std::uint32_t> v) {
+    std::sort(begin(v), end(v));
+    return v;
+}
+
+/** Items on a random grid of boxes, with the tree built */
+struct RandomScene {
+    std::vector<BoundingBox> boxes;
+    std::vector<ProxyId> proxies;
+    Bvh bvh;
+
+    explicit RandomScene(std::size_t count) {
+        std::mt19937 generator(7);
+        std::uniform_real_distribution<float> position(-50, 50);
+        for (std::size_t i = 0; i < count; ++ i) {
+            boxes.push_back(box(position(generator), position(generator),
+                    position(generator), 0.5f));
+            proxies.push_back(bvh.insert(boxes.back(), i));
+        }
+        bvh.refit();
+    }
+
+    std::vector<std::uint32_t> bruteForce(const BoundingBox& query) const {
+        std::vector<std::uint32_t> items;
+        for (std::size_t i = 0; i < boxes.size(); ++ i) {
+            if (overlaps(boxes[i], query)) {
+                items.push_back(i);
+            }
+        }
+        return items;
+    }
+};
+
+} /* namespace */
+
+
+TEST(BvhTest, BoxQueryMatchesBruteForceAndSkipsMostNodes) {
+    RandomScene scene { 1000 };
+    BoundingBox query = box(10, 10, 10, 8);
+
+    std::vector<std::uint32_t> items;
+    scene.bvh.query(query, items);
+    EXPECT_EQ(scene.bruteForce(query), sorted(items));
+    EXPECT_LT(scene.bvh.visited(), 500u);
+}
+
+TEST(BvhTest, FrustumQueryReportsVisibleAndUnboundedItems) {
+    Bvh bvh;
+    bvh.insert(box(0, 0, 0, 0.5f), 0);
+    bvh.insert(box(0.9f, 0, 0, 0.5f), 1);
+    bvh.insert(box(5, 0, 0, 0.5f), 2);
+    bvh.insert(box(0, -5, 0, 0.5f), 3);
+    bvh.insert(BoundingBox { }, 4);
+    bvh.refit();
+
+    const float identity[16] = {
+        1, 0, 0, 0,  0, 1, 0, 0,  0, 0, 1, 0,  0, 0, 0, 1
+    };
+    std::vector<std::uint32_t> items;
+    bvh.query(Frustum::fromMatrix(identity), items);
+    EXPECT_THAT(sorted(items), ElementsAre(0, 1, 4));
+}
+
+TEST(BvhTest, SphereAndRayQueries) {
+    Bvh bvh;
+    bvh.insert(box(0, 0, 0, 1), 0);
+    bvh.insert(box(5, 0, 0, 1), 1);
+    bvh.insert(box(10, 0, 0, 1), 2);
+    bvh.insert(box(5, 5, 0, 1), 3);
+    bvh.refit();
+
+    std::vector<std::uint32_t> items;
+    BoundingSphere sphere;
+    sphere.center[0] = 7.5f;
+    sphere.radius = 2;
+    bvh.query(sphere, items);
+    EXPECT_THAT(sorted(items), ElementsAre(1, 2));
+
+    const float origin[] = { 20, 0, 0 };
+    const float dir[] = { -1, 0, 0 };
+    std::vector<RayHit> hits;
+    bvh.raycast(origin, dir, 100, hits);
+    ASSERT_EQ(3u, hits.size());
+    EXPECT_EQ(2u, hits[0].item);
+    EXPECT_FLOAT_EQ(9, hits[0].t);
+    EXPECT_EQ(1u, hits[1].item);
+    EXPECT_EQ(0u, hits[2].item);
+
+    hits.clear();
+    bvh.raycast(origin, dir, 15, hits);
+    EXPECT_EQ(2u, hits.size());
+}
+
+TEST(BvhTest, RefitsOnlyPathsOfMovedItems) {
+    RandomScene scene { 1024 };
+
+    scene.boxes[17] = box(100, 100, 100, 1);
+    scene.bvh.update(scene.proxies[17], scene.boxes[17]);
+    scene.bvh.update(scene.proxies[18], scene.boxes[18]);
+    scene.bvh.refit();
+    // depth of the tree is 10
+    EXPECT_LE(scene.bvh.refitted(), 10u);
+    EXPECT_EQ(100, scene.bvh.bounds().max[0] - 1);
+
+    std::vector<std::uint32_t> items;
+    scene.bvh.query(box(100, 100, 100, 0.1f), items);
+    EXPECT_THAT(items, ElementsAre(17));
+
+    BoundingBox query = box(-20, 0, 5, 10);
+    items.clear();
+    scene.bvh.query(query, items);
+    EXPECT_EQ(scene.bruteForce(query), sorted(items));
+}
+
+TEST(BvhTest, RebuildsAfterRemoval) {
+    RandomScene scene { 100 };
+    for (std::size_t i = 0; i < 100; i += 2) {
+        scene.bvh.remove(scene.proxies[i]);
+    }
+    scene.bvh.refit();
+    EXPECT_EQ(50u, scene.bvh.size());
+
+    std::vector<std::uint32_t> items;
+    scene.bvh.query(box(0, 0, 0, 100), items);
+    EXPECT_EQ(50u, items.size());
+    for (std::uint32_t item : items) {
+        EXPECT_EQ(1u, item % 2);
+    }
+}
+
+} /* namespace scene */
+} /* namespace zephyr */
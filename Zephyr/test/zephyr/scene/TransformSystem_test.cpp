@@ -0,0 +1,167 @@
+/**
+ * @file TransformSystem_test.cpp
+ */
+
+#include <zephyr/scene/TransformSystem.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+namespace zephyr {
+namespace scene {
+
+using ::testing::ElementsAre;
+
+namespace {
+
+/** Translation part of the world matrix */
+Vec3 origin(const TransformSystem& system, TransformId id) {
+    const float* m = system.world(id).m;
+    return Vec3 { m[12], m[13], m[14] };
+}
+
+MATCHER_P3(IsAt, x, y, z, "") {
+    return std::abs(arg.x - x) < 1e-5f && std::abs(arg.y - y) < 1e-5f
+        && std::abs(arg.z - z) < 1e-5f;
+}
+
+} /* namespace */
+
+
+TEST(TransformSystemTest, MultipliesColumnMajorMatrices) {
+    Mat4 a = { { 1, 2, 3, 4,  5, 6, 7, 8,  9, 10, 11, 12,  13, 14, 15, 16 } };
+    Mat4 b = { { 1, 0, 0, 0,  0, 2, 0, 0,  0, 0, 1, 0,  1, 0, 0, 1 } };
+    Mat4 c;
+    multiply(a, b, c);
+    EXPECT_THAT(c.m, ElementsAre(1, 2, 3, 4,  10, 12, 14, 16,  9, 10, 11, 12,
+            14, 16, 18, 20));
+}
+
+TEST(TransformSystemTest, ComposesParentAndChild) {
+    TransformSystem system;
+    TransformId parent = system.create();
+    TransformId child = system.create(parent);
+
+    // quarter turn around z
+    float h = std::sqrt(0.5f);
+    system.setPosition(parent, Vec3 { 10, 0, 0 });
+    system.setOrientation(parent, Quat { 0, 0, h, h });
+    system.setScale(parent, Vec3 { 2, 2, 2 });
+    system.setPosition(child, Vec3 { 1, 0, 0 });
+    system.update();
+
+    EXPECT_THAT(origin(system, parent), IsAt(10, 0, 0));
+    EXPECT_THAT(origin(system, child), IsAt(10, 2, 0));
+    EXPECT_EQ(2u, system.updated());
+    EXPECT_EQ(2u, system.levels());
+}
+
+TEST(TransformSystemTest, RecomputesOnlyChangedSubtrees) {
+    TransformSystem system;
+    TransformId root = system.create();
+    TransformId a = system.create(root);
+    TransformId b = system.create(root);
+    TransformId a1 = system.create(a);
+    TransformId b1 = system.create(b);
+    system.update();
+    EXPECT_EQ(5u, system.updated());
+
+    system.update();
+    EXPECT_EQ(0u, system.updated());
+    EXPECT_FALSE(system.changed(a1));
+
+    system.setPosition(a, Vec3 { 0, 1, 0 });
+    system.update();
+    EXPECT_EQ(2u, system.updated());
+    EXPECT_TRUE(system.changed(a));
+    EXPECT_TRUE(system.changed(a1));
+    EXPECT_FALSE(system.changed(b1));
+    EXPECT_THAT(origin(system, a1), IsAt(0, 1, 0));
+}
+
+TEST(TransformSystemTest, ReparentingKeepsParentsFirst) {
+    TransformSystem system;
+    TransformId leaf = system.create();
+    TransformId mid = system.create();
+    TransformId top = system.create();
+    system.setPosition(top, Vec3 { 1, 0, 0 });
+    system.setPosition(mid, Vec3 { 0, 1, 0 });
+    system.setPosition(leaf, Vec3 { 0, 0, 1 });
+
+    // created in reverse order of the hierarchy
+    system.setParent(leaf, mid);
+    system.setParent(mid, top);
+    system.update();
+
+    EXPECT_THAT(origin(system, leaf), IsAt(1, 1, 1));
+    EXPECT_EQ(3u, system.levels());
+    EXPECT_EQ(mid, system.parent(leaf));
+    EXPECT_THROW(system.setParent(top, leaf), std::logic_error);
+}
+
+TEST(TransformSystemTest, DestroyedParentLeavesRoots) {
+    TransformSystem system;
+    TransformId parent = system.create();
+    TransformId child = system.create(parent);
+    system.setPosition(parent, Vec3 { 5, 0, 0 });
+    system.update();
+    EXPECT_THAT(origin(system, child), IsAt(5, 0, 0));
+
+    system.destroy(parent);
+    TransformId other = system.create();
+    system.update();
+
+    EXPECT_EQ(2u, system.size());
+    EXPECT_EQ(TransformSystem::NONE, system.parent(child));
+    EXPECT_THAT(origin(system, child), IsAt(0, 0, 0));
+    EXPECT_EQ(parent, other);
+}
+
+TEST(TransformSystemTest, ParallelUpdateMatchesSerial) {
+    // two identical forests, wide enough to be split into many chunks;
+    // ids are the same in both, as they are created in the same order
+    TransformSystem serial, parallel;
+    std::vector<TransformId> ids;
+    for (TransformSystem* system : { &serial, &parallel }) {
+        TransformId root = system->create();
+        for (int i = 0; i < 1000; ++ i) {
+            TransformId tree = system->create(root);
+            system->setPosition(tree, Vec3 { float(i), 0, 0 });
+            for (int j = 0; j < 3; ++ j) {
+                TransformId branch = system->create(tree);
+                system->setPosition(branch, Vec3 { 0, float(j), 0 });
+                if (system == &serial) {
+                    ids.push_back(branch);
+                }
+            }
+        }
+    }
+    core::WorkerPool pool(3);
+    core::Jobs jobs(&pool);
+    pool.attach();
+
+    serial.update();
+    parallel.update(jobs, 64);
+    EXPECT_EQ(serial.updated(), parallel.updated());
+
+    // move every other tree
+    for (std::size_t i = 1; i < 1000; i += 2) {
+        TransformId tree = serial.parent(ids[3 * i]);
+        serial.setPosition(tree, Vec3 { 0, 0, 1 });
+        parallel.setPosition(tree, Vec3 { 0, 0, 1 });
+    }
+    serial.update();
+    parallel.update(jobs, 64);
+    EXPECT_EQ(2000u, parallel.updated());
+
+    for (TransformId id : ids) {
+        const Vec3& p = origin(serial, id);
+        ASSERT_THAT(origin(parallel, id), IsAt(p.x, p.y, p.z));
+    }
+}
+
+} /* namespace scene */
+} /* namespace zephyr */
@@ -0,0 +1,86 @@
+/**
+ * @file Payload_test.cpp
+ */
+
+#include <zephyr/util/Payload.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <sstream>
+
+namespace zephyr {
+namespace util {
+
+namespace {
+
+std::string to_string(const Payload& payload) {
+    std::ostringstream ss;
+    ss << payload;
+    return ss.str();
+}
+
+struct small_event {
+    int code;
+    double x, y;
+};
+
+struct large_event {
+    double values[16];
+};
+
+} /* namespace */
+
+
+TEST(PayloadTest, SmallTrivialTypesAreStoredInline) {
+    EXPECT_TRUE(Payload::storedInline<double>());
+    EXPECT_TRUE(Payload::storedInline<small_event>());
+    EXPECT_FALSE(Payload::storedInline<large_event>());
+    EXPECT_FALSE(Payload::storedInline<std::string>());
+}
+
+TEST(PayloadTest, EmptyByDefault) {
+    Payload payload;
+    EXPECT_TRUE(payload.empty());
+    EXPECT_EQ("[empty]", to_string(payload));
+}
+
+TEST(PayloadTest, CanGetInlineValue) {
+    Payload payload { small_event { 3, 1.5, 2.5 } };
+    ASSERT_TRUE(payload.is<small_event>());
+    EXPECT_EQ(3, payload.get<small_event>().code);
+    EXPECT_EQ(2.5, payload.get<small_event>().y);
+}
+
+TEST(PayloadTest, CanGetHeapValue) {
+    Payload payload { std::string("text") };
+    EXPECT_EQ("text", payload.get<std::string>());
+}
+
+TEST(PayloadTest, WrongTypeThrows) {
+    const Payload payload { 12 };
+    EXPECT_THROW(payload.get<double>(), std::bad_cast);
+    EXPECT_EQ(nullptr, payload.tryGet<double>());
+}
+
+TEST(PayloadTest, CopiesAreIndependent) {
+    Payload original { std::string("text") };
+    Payload copy = original;
+    copy.get<std::string>() = "other";
+    EXPECT_EQ("text", original.get<std::string>());
+    EXPECT_EQ("other", copy.get<std::string>());
+}
+
+TEST(PayloadTest, MoveLeavesSourceEmpty) {
+    Payload original { large_event { } };
+    Payload moved = std::move(original);
+    EXPECT_TRUE(original.empty());
+    EXPECT_TRUE(moved.is<large_event>());
+}
+
+TEST(PayloadTest, CanPrintValue) {
+    EXPECT_EQ("12", to_string(Payload { 12 }));
+    EXPECT_EQ("text", to_string(Payload { std::string("text") }));
+}
+
+} /* namespace util */
+} /* namespace zephyr */
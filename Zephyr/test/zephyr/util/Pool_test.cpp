@@ -0,0 +1,122 @@
+/**
+ * @file Pool_test.cpp
+ */
+
+#include <zephyr/util/Pool.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace zephyr {
+namespace util {
+
+namespace {
+
+/** Counts live instances */
+struct Tracked {
+    static int count;
+    int value;
+
+    explicit Tracked(int value)
+    : value { value }
+    { ++ count; }
+
+    Tracked(const Tracked&) = delete;
+
+    ~Tracked() {
+        -- count;
+    }
+};
+
+int Tracked::count = 0;
+
+} /* namespace */
+
+
+TEST(PoolTest, HandlesPackIndexAndGeneration) {
+    Handle<int> handle { 5, 3 };
+    EXPECT_EQ(5u, handle.index());
+    EXPECT_EQ(3u, handle.generation());
+    EXPECT_EQ(4u, sizeof handle);
+    EXPECT_FALSE(Handle<int> { });
+    EXPECT_TRUE(handle);
+}
+
+TEST(PoolTest, ObjectsAreConstructedInPlace) {
+    Pool<std::string> pool;
+    auto a = pool.create("first");
+    auto b = pool.create(3, 'x');
+    EXPECT_EQ("first", pool[a]);
+    EXPECT_EQ("xxx", *pool.get(b));
+    EXPECT_EQ(2u, pool.size());
+    EXPECT_EQ(Pool<std::string>::CHUNK_SIZE, pool.capacity());
+}
+
+TEST(PoolTest, ReleasedHandlesBecomeStale) {
+    Pool<Tracked> pool;
+    auto a = pool.create(1);
+    pool.release(a);
+    EXPECT_EQ(0, Tracked::count);
+    EXPECT_FALSE(pool.alive(a));
+    EXPECT_EQ(nullptr, pool.get(a));
+    EXPECT_THROW(pool[a], std::logic_error);
+    EXPECT_THROW(pool.release(a), std::logic_error);
+
+    // slot is reused, old handle does not see the new object
+    auto b = pool.create(2);
+    EXPECT_EQ(a.index(), b.index());
+    EXPECT_NE(a, b);
+    EXPECT_EQ(nullptr, pool.get(a));
+    EXPECT_EQ(2, pool[b].value);
+}
+
+TEST(PoolTest, DeferredReleaseKeepsObjectUntilCollect) {
+    Pool<Tracked> pool;
+    auto a = pool.create(1);
+    Tracked* object = pool.get(a);
+    pool.releaseLater(a);
+
+    EXPECT_FALSE(pool.alive(a));
+    EXPECT_EQ(1, Tracked::count);
+    EXPECT_EQ(1, object->value);
+    EXPECT_EQ(1u, pool.pending());
+
+    // slot is not reused before the object is destroyed
+    auto b = pool.create(2);
+    EXPECT_NE(a.index(), b.index());
+
+    EXPECT_EQ(1u, pool.collect());
+    EXPECT_EQ(1, Tracked::count);
+    EXPECT_EQ(0u, pool.pending());
+}
+
+TEST(PoolTest, ObjectsDoNotMoveWhenPoolGrows) {
+    Pool<Tracked> pool;
+    auto first = pool.create(0);
+    Tracked* address = pool.get(first);
+    std::vector<Handle<Tracked>> handles;
+    for (int i = 1; i < 1000; ++ i) {
+        handles.push_back(pool.create(i));
+    }
+    EXPECT_EQ(address, pool.get(first));
+    EXPECT_EQ(1000, Tracked::count);
+
+    int sum = 0;
+    pool.forEach([&sum](Handle<Tracked>, Tracked& t) { sum += t.value; });
+    EXPECT_EQ(999 * 1000 / 2, sum);
+}
+
+TEST(PoolTest, DestructorDestroysAllObjects) {
+    {
+        Pool<Tracked> pool;
+        pool.create(1);
+        pool.releaseLater(pool.create(2));
+        pool.create(3);
+    }
+    EXPECT_EQ(0, Tracked::count);
+}
+
+} /* namespace util */
+} /* namespace zephyr */
@@ -0,0 +1,62 @@
+/**
+ * @file make_aligned_test.cpp
+ */
+
+#include <zephyr/util/make_aligned.hpp>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+
+namespace zephyr {
+namespace util {
+
+namespace {
+
+struct alignas(128) Padded {
+    static int alive;
+
+    explicit Padded(int value = 0)
+    : value { value }
+    {
+        ++ alive;
+    }
+
+    ~Padded() {
+        -- alive;
+    }
+
+    int value;
+};
+
+int Padded::alive = 0;
+
+bool aligned(const void* p) {
+    return reinterpret_cast<std::uintptr_t>(p) % alignof(Padded) == 0;
+}
+
+} /* namespace */
+
+
+TEST(MakeAlignedTest, ObjectIsAlignedAndDestroyed) {
+    {
+        aligned_ptr<Padded> p = make_aligned<Padded>(7);
+        EXPECT_TRUE(aligned(p.get()));
+        EXPECT_EQ(7, p->value);
+        EXPECT_EQ(1, Padded::alive);
+    }
+    EXPECT_EQ(0, Padded::alive);
+}
+
+TEST(MakeAlignedTest, ArrayElementsAreAlignedAndDestroyed) {
+    {
+        aligned_ptr<Padded[]> p = make_aligned_array<Padded>(5);
+        for (int i = 0; i < 5; ++ i) {
+            EXPECT_TRUE(aligned(&p[i]));
+        }
+        EXPECT_EQ(5, Padded::alive);
+    }
+    EXPECT_EQ(0, Padded::alive);
+}
+
+} /* namespace util */
+} /* namespace zephyr */
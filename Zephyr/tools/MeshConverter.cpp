@@ -0,0 +1,75 @@
+/**
+ * @file MeshConverter.cpp
+ *
+ * Converts OBJ files to the binary mesh files loaded by loadObjMesh(), so the
+ * game does not need to parse them and compute tangent spaces at startup.
+ * Output is written next to each input file, where loadObjMesh() looks for it
+ * (see meshCachePath()).
+ *
+ * Usage: meshConverter [first | avg | split] file.obj...
+ */
+
+#include <zephyr/gfx/Mesh.hpp>
+#include <zephyr/core/Jobs.hpp>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+using namespace zephyr;
+using namespace zephyr::gfx;
+
+namespace {
+
+bool parseStrategy(const char* name, NormCalc& strategy) {
+    const char* names[] = { "first", "avg", "split" };
+    const NormCalc values[] = { NormCalc::FIRST, NormCalc::AVG, NormCalc::SPLIT };
+    for (int i = 0; i < 3; ++ i) {
+        if (std::strcmp(name, names[i]) == 0) {
+            strategy = values[i];
+            return true;
+        }
+    }
+    return false;
+}
+
+} /* namespace */
+
+
+int main(int argc, char* argv[]) {
+    NormCalc strategy = NormCalc::AVG;
+    int first = 1;
+    if (argc > 1 && parseStrategy(argv[1], strategy)) {
+        ++ first;
+    }
+    if (first >= argc) {
+        std::cerr << "Usage: " << argv[0] << " [first | avg | split] "
+                << "file.obj..." << std::endl;
+        return 2;
+    }
+
+    std::size_t workers = std::max(1u, std::thread::hardware_concurrency()) - 1;
+    core::WorkerPool pool(workers);
+    core::Jobs jobs(&pool);
+    pool.attach();
+
+    int failed = 0;
+    for (int i = first; i < argc; ++ i) {
+        const char* path = argv[i];
+        try {
+            MeshFileData content = convertObjMesh(path, jobs, strategy);
+            std::string output = meshCachePath(path, strategy);
+            writeMeshFile(output, content);
+            std::size_t vertices = content.stride
+                    ? content.vertices.size() / content.stride : 0;
+            std::cout << path << " -> " << output << ": "
+                    << vertices << " vertices, "
+                    << content.indices.size() << " indices" << std::endl;
+        } catch (const std::runtime_error& e) {
+            std::cerr << e.what() << std::endl;
+            ++ failed;
+        }
+    }
+    return failed > 0 ? 1 : 0;
+}